@@ -1,475 +1,544 @@
-/**
- *  \file
- *  \brief  GTags AutoComplete window
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma comment (lib, "comctl32")
-
-
-#include <windows.h>
-#include <commctrl.h>
-#include "Common.h"
-#include "INpp.h"
-#include "GTags.h"
-#include "AutoCompleteWin.h"
-#include "Cmd.h"
-#include "LineParser.h"
-
-
-namespace GTags
-{
-
-const TCHAR AutoCompleteWin::cClassName[]   = _T("AutoCompleteWin");
-const int AutoCompleteWin::cBackgroundColor = COLOR_INFOBK;
-const int AutoCompleteWin::cWidth           = 400;
-
-
-std::unique_ptr<AutoCompleteWin> AutoCompleteWin::ACW {nullptr};
-
-
-/**
- *  \brief
- */
-void AutoCompleteWin::Register()
-{
-    WNDCLASS wc         = {0};
-    wc.style            = CS_PARENTDC | CS_HREDRAW | CS_VREDRAW;
-    wc.lpfnWndProc      = wndProc;
-    wc.hInstance        = HMod;
-    wc.hCursor          = LoadCursor(NULL, IDC_ARROW);
-    wc.hbrBackground    = GetSysColorBrush(cBackgroundColor);
-    wc.lpszClassName    = cClassName;
-
-    RegisterClass(&wc);
-
-    INITCOMMONCONTROLSEX icex   = {0};
-    icex.dwSize                 = sizeof(icex);
-    icex.dwICC                  = ICC_LISTVIEW_CLASSES;
-
-    InitCommonControlsEx(&icex);
-}
-
-
-/**
- *  \brief
- */
-void AutoCompleteWin::Unregister()
-{
-    UnregisterClass(cClassName, HMod);
-}
-
-
-/**
- *  \brief
- */
-void AutoCompleteWin::Show(const CmdPtr_t& cmd)
-{
-    if (ACW)
-        return;
-
-    ACW = std::make_unique<AutoCompleteWin>(cmd);
-
-    if (ACW->composeWindow(cmd->Name()) == NULL)
-        ACW = nullptr;
-}
-
-
-/**
- *  \brief
- */
-AutoCompleteWin::AutoCompleteWin(const CmdPtr_t& cmd) :
-    _hWnd(NULL), _hLVWnd(NULL), _hFont(NULL), _cmdId(cmd->Id()), _ic(cmd->IgnoreCase()),
-    _cmdTagLen((int)(_cmdId == AUTOCOMPLETE_FILE ? cmd->Tag().Len() - 1 : cmd->Tag().Len())),
-    _completion(cmd->Parser())
-{}
-
-
-/**
- *  \brief
- */
-AutoCompleteWin::~AutoCompleteWin()
-{
-    INpp::Get().ClearSelectionMulti();
-    INpp::Get().EndUndoAction();
-
-    if (_hFont)
-        DeleteObject(_hFont);
-}
-
-
-/**
- *  \brief
- */
-HWND AutoCompleteWin::composeWindow(const TCHAR* header)
-{
-    HWND hOwner = INpp::Get().GetSciHandle();
-    RECT win;
-
-    GetWindowRect(hOwner, &win);
-
-    _hWnd = CreateWindow(cClassName, NULL,
-            WS_POPUP | WS_BORDER,
-            win.left, win.top, win.right - win.left, win.bottom - win.top,
-            hOwner, NULL, HMod, NULL);
-    if (_hWnd == NULL)
-        return NULL;
-
-    INpp::Get().RegisterWinForDarkMode(_hWnd);
-
-    GetClientRect(_hWnd, &win);
-
-    _hLVWnd = CreateWindow(WC_LISTVIEW, NULL, WS_CHILD | WS_VISIBLE |
-            LVS_REPORT | LVS_SINGLESEL | LVS_NOLABELWRAP | LVS_NOSORTHEADER | LVS_SORTASCENDING,
-            0, 0, win.right - win.left, win.bottom - win.top,
-            _hWnd, NULL, HMod, NULL);
-
-    HDC hdc = GetWindowDC(_hLVWnd);
-
-    _hFont = CreateFont(
-            -MulDiv(UIFontSize, GetDeviceCaps(hdc, LOGPIXELSY), 72),
-            0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, ANSI_CHARSET,
-            OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
-            FF_DONTCARE | DEFAULT_PITCH, UIFontName.C_str());
-
-    ReleaseDC(_hLVWnd, hdc);
-
-    if (_hFont)
-        SendMessage(_hLVWnd, WM_SETFONT, (WPARAM)_hFont, TRUE);
-
-    ListView_SetExtendedListViewStyle(_hLVWnd, LVS_EX_LABELTIP | LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER);
-
-    TCHAR buf[32];
-    _tcscpy_s(buf, _countof(buf), header);
-
-    LVCOLUMN lvCol      = {0};
-    lvCol.mask          = LVCF_TEXT | LVCF_WIDTH;
-    lvCol.pszText       = buf;
-    lvCol.cchTextMax    = _countof(buf);
-    lvCol.cx            = cWidth;
-    ListView_InsertColumn(_hLVWnd, 0, &lvCol);
-
-    DWORD backgroundColor = GetSysColor(cBackgroundColor);
-    ListView_SetBkColor(_hLVWnd, backgroundColor);
-    ListView_SetTextBkColor(_hLVWnd, backgroundColor);
-
-    CTextA wordA;
-    INpp::Get().GetWord(wordA, true, true, true);
-    CText word(wordA.C_str());
-
-    if (!filterLV(word))
-    {
-        SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        return NULL;
-    }
-
-    resizeLV();
-
-    ShowWindow(_hWnd, SW_SHOWNORMAL);
-    UpdateWindow(_hWnd);
-
-    INpp::Get().BeginUndoAction();
-
-    return _hWnd;
-}
-
-
-/**
- *  \brief
- */
-int AutoCompleteWin::filterLV(const CText& filter)
-{
-    LVITEM lvItem   = {0};
-    lvItem.mask     = LVIF_TEXT | LVIF_STATE;
-
-    size_t len = filter.Len();
-
-    ListView_DeleteAllItems(_hLVWnd);
-
-    int (*pCompare)(const TCHAR*, const TCHAR*, size_t);
-
-    if (_ic)
-        pCompare = &_tcsnicmp;
-    else
-        pCompare = &_tcsncmp;
-
-    for (const auto& complEntry : _completion->GetList())
-    {
-        if (!len || !pCompare(complEntry, filter.C_str(), len))
-        {
-            lvItem.pszText = complEntry;
-            ListView_InsertItem(_hLVWnd, &lvItem);
-            ++lvItem.iItem;
-        }
-    }
-
-    if (lvItem.iItem > 0)
-        ListView_SetItemState(_hLVWnd, 0, LVIS_FOCUSED | LVIS_SELECTED, LVIS_FOCUSED | LVIS_SELECTED);
-
-    return lvItem.iItem;
-}
-
-
-/**
- *  \brief
- */
-void AutoCompleteWin::resizeLV()
-{
-    bool scroll = false;
-    int rowsCount = ListView_GetItemCount(_hLVWnd);
-    if (rowsCount > 7)
-    {
-        rowsCount = 7;
-        scroll = true;
-    }
-
-    RECT win;
-    ListView_GetItemRect(_hLVWnd, 0, &win, LVIR_BOUNDS);
-    int lvWidth     = win.right - win.left;
-    int lvHeight    = (win.bottom - win.top) * rowsCount;
-
-    HWND hHeader = ListView_GetHeader(_hLVWnd);
-    GetWindowRect(hHeader, &win);
-    lvHeight += win.bottom - win.top;
-
-    RECT maxWin;
-    INpp& npp = INpp::Get();
-    GetWindowRect(npp.GetSciHandle(), &maxWin);
-
-    int maxWidth = (maxWin.right - maxWin.left) - 30;
-    if (scroll)
-        maxWidth -= GetSystemMetrics(SM_CXVSCROLL);
-    if (lvWidth > maxWidth)
-        lvWidth = maxWidth;
-
-    ListView_SetColumnWidth(_hLVWnd, 0, lvWidth);
-
-    if (scroll)
-        lvWidth += GetSystemMetrics(SM_CXVSCROLL);
-
-    win.left    = maxWin.left;
-    win.top     = maxWin.top;
-    win.right   = win.left + lvWidth;
-    win.bottom  = win.top + lvHeight;
-
-    AdjustWindowRect(&win, (DWORD)GetWindowLongPtr(_hWnd, GWL_STYLE), FALSE);
-    lvWidth     = win.right - win.left;
-    lvHeight    = win.bottom - win.top;
-
-    int xOffset, yOffset;
-    npp.GetPointPos(&xOffset, &yOffset);
-
-    win.left    = maxWin.left + xOffset;
-    win.top     = maxWin.top + yOffset + npp.GetTextHeight();
-    win.right   = win.left + lvWidth;
-    win.bottom  = win.top + lvHeight;
-
-    xOffset = win.right - maxWin.right;
-    if (xOffset > 0)
-    {
-        win.left    -= xOffset;
-        win.right   -= xOffset;
-    }
-
-    if (win.bottom > maxWin.bottom)
-    {
-        win.bottom  = maxWin.top + yOffset;
-        win.top     = win.bottom - lvHeight;
-    }
-
-    MoveWindow(_hWnd, win.left, win.top, win.right - win.left, win.bottom - win.top, TRUE);
-
-    GetClientRect(_hWnd, &win);
-    MoveWindow(_hLVWnd, 0, 0, win.right - win.left, win.bottom - win.top, TRUE);
-}
-
-
-/**
- *  \brief
- */
-void AutoCompleteWin::onDblClick()
-{
-    TCHAR itemTxt[MAX_PATH];
-    LVITEM lvItem       = {0};
-    lvItem.mask         = LVIF_TEXT;
-    lvItem.iItem        = ListView_GetNextItem(_hLVWnd, -1, LVNI_SELECTED);
-    lvItem.pszText      = itemTxt;
-    lvItem.cchTextMax   = _countof(itemTxt);
-
-    ListView_GetItem(_hLVWnd, &lvItem);
-    lvItem.pszText[lvItem.cchTextMax - 1] = 0;
-
-    CTextA completion(itemTxt);
-    INpp::Get().ReplaceWordMulti(completion.C_str(), true);
-
-    SendMessage(_hWnd, WM_CLOSE, 0, 0);
-}
-
-
-/**
- *  \brief
- */
-bool AutoCompleteWin::onKeyDown(int keyCode)
-{
-    switch (keyCode)
-    {
-        case VK_UP:
-        case VK_DOWN:
-        return false;
-
-        case VK_TAB:
-        case VK_RETURN:
-            onDblClick();
-        return true;
-
-        case VK_LEFT:
-        case VK_RIGHT:
-        case VK_ESCAPE:
-        case VK_CONTROL:
-        case VK_MENU:
-            SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        return true;
-
-        case VK_DELETE:
-            INpp::Get().ReplaceWordMulti("", true);
-            SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        return true;
-
-        case VK_BACK:
-        {
-            INpp& npp = INpp::Get();
-            npp.ClearSelectionMulti();
-            npp.Backspace();
-            if (npp.GetWordSize(true) < _cmdTagLen)
-            {
-                SendMessage(_hWnd, WM_CLOSE, 0, 0);
-                return true;
-            }
-        }
-        break;
-
-        default:
-        {
-            BYTE keysState[256];
-            WORD character;
-
-            if (!GetKeyboardState(keysState))
-                return false;
-            if (ToAscii(keyCode, MapVirtualKey(keyCode, MAPVK_VK_TO_VSC), keysState, &character, 1) != 1)
-                return false;
-
-            INpp& npp = INpp::Get();
-
-            if (npp.GetSelectionsCount() == 1)
-            {
-                npp.AddText((char*)&character, 1);
-            }
-            else
-            {
-                const char charStr[] {(char)character, '\0'};
-                npp.InsertTextAtMultiPos(charStr);
-            }
-
-            if (keyCode == VK_SPACE)
-            {
-                SendMessage(_hWnd, WM_CLOSE, 0, 0);
-                return true;
-            }
-        }
-    }
-
-    if (!INpp::Get().IsPreviousCharWordEnd())
-    {
-        CTextA wordA;
-        INpp::Get().GetWord(wordA, true, true, true);
-        CText word(wordA.C_str());
-        int lvItemsCnt = filterLV(word);
-
-        if (lvItemsCnt == 0)
-        {
-            SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        }
-        else if (lvItemsCnt == 1)
-        {
-            TCHAR itemTxt[MAX_PATH];
-            LVITEM lvItem       = {0};
-            lvItem.mask         = LVIF_TEXT;
-            lvItem.iItem        = ListView_GetNextItem(_hLVWnd, -1, LVNI_SELECTED);
-            lvItem.pszText      = itemTxt;
-            lvItem.cchTextMax   = _countof(itemTxt);
-
-            ListView_GetItem(_hLVWnd, &lvItem);
-            lvItem.pszText[lvItem.cchTextMax - 1] = 0;
-
-            if (!_tcscmp(word.C_str(), lvItem.pszText))
-                SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        }
-    }
-    else
-    {
-        SendMessage(_hWnd, WM_CLOSE, 0, 0);
-    }
-
-    return true;
-}
-
-
-/**
- *  \brief
- */
-LRESULT APIENTRY AutoCompleteWin::wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-    switch (uMsg)
-    {
-        case WM_CREATE:
-        return 0;
-
-        case WM_SETFOCUS:
-            SetFocus(ACW->_hLVWnd);
-        return 0;
-
-        case WM_NOTIFY:
-            switch (((LPNMHDR)lParam)->code)
-            {
-                case NM_KILLFOCUS:
-                    SendMessage(hWnd, WM_CLOSE, 0, 0);
-                return 0;
-
-                case LVN_KEYDOWN:
-                    if (ACW->onKeyDown(((LPNMLVKEYDOWN)lParam)->wVKey))
-                        return 1;
-                break;
-
-                case NM_DBLCLK:
-                    ACW->onDblClick();
-                return 0;
-            }
-        break;
-
-        case WM_DESTROY:
-            ACW = nullptr;
-        return 0;
-    }
-
-    return DefWindowProc(hWnd, uMsg, wParam, lParam);
-}
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags AutoComplete window
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma comment (lib, "comctl32")
+
+
+#include <windows.h>
+#include <commctrl.h>
+#include <algorithm>
+#include "Common.h"
+#include "INpp.h"
+#include "GTags.h"
+#include "AutoCompleteWin.h"
+#include "Cmd.h"
+#include "LineParser.h"
+#include "FuzzyMatcher.h"
+#include "Config.h"
+
+
+namespace GTags
+{
+
+const TCHAR AutoCompleteWin::cClassName[]   = _T("AutoCompleteWin");
+const int AutoCompleteWin::cBackgroundColor = COLOR_INFOBK;
+const int AutoCompleteWin::cWidth           = 400;
+const size_t AutoCompleteWin::cMaxFuzzyMatches  = 1000;
+
+
+std::unique_ptr<AutoCompleteWin> AutoCompleteWin::ACW {nullptr};
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::Register()
+{
+    WNDCLASS wc         = {0};
+    wc.style            = CS_PARENTDC | CS_HREDRAW | CS_VREDRAW;
+    wc.lpfnWndProc      = wndProc;
+    wc.hInstance        = HMod;
+    wc.hCursor          = LoadCursor(NULL, IDC_ARROW);
+    wc.hbrBackground    = GetSysColorBrush(cBackgroundColor);
+    wc.lpszClassName    = cClassName;
+
+    RegisterClass(&wc);
+
+    INITCOMMONCONTROLSEX icex   = {0};
+    icex.dwSize                 = sizeof(icex);
+    icex.dwICC                  = ICC_LISTVIEW_CLASSES;
+
+    InitCommonControlsEx(&icex);
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::Unregister()
+{
+    UnregisterClass(cClassName, HMod);
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::Show(const CmdPtr_t& cmd)
+{
+    if (ACW)
+        return;
+
+    ACW = std::make_unique<AutoCompleteWin>(cmd);
+
+    if (ACW->composeWindow(cmd->Name()) == NULL)
+    {
+        ACW = nullptr;
+        return;
+    }
+
+    const CmdTimingPtr_t& timing = cmd->Timing();
+    if (timing)
+    {
+        timing->Mark(CmdTiming::UI_LOAD);
+
+        // Left to the list view first paint - when the completion list actually becomes visible
+        ACW->_paintTiming = timing;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+AutoCompleteWin::AutoCompleteWin(const CmdPtr_t& cmd) :
+    _hWnd(NULL), _hLVWnd(NULL), _hFont(NULL), _cmdId(cmd->Id()), _ic(cmd->IgnoreCase()),
+    _cmdTagLen((int)(_cmdId == AUTOCOMPLETE_FILE ? cmd->Tag().Len() - 1 : cmd->Tag().Len())),
+    _db(cmd->Db()), _completion(cmd->Parser()), _filtered(false)
+{}
+
+
+/**
+ *  \brief
+ */
+AutoCompleteWin::~AutoCompleteWin()
+{
+    INpp::Get().ClearSelectionMulti();
+    INpp::Get().EndUndoAction();
+
+    if (_hFont)
+        DeleteObject(_hFont);
+}
+
+
+/**
+ *  \brief
+ */
+HWND AutoCompleteWin::composeWindow(const TCHAR* header)
+{
+    HWND hOwner = INpp::Get().GetSciHandle();
+    RECT win;
+
+    GetWindowRect(hOwner, &win);
+
+    _hWnd = CreateWindow(cClassName, NULL,
+            WS_POPUP | WS_BORDER,
+            win.left, win.top, win.right - win.left, win.bottom - win.top,
+            hOwner, NULL, HMod, NULL);
+    if (_hWnd == NULL)
+        return NULL;
+
+    INpp::Get().RegisterWinForDarkMode(_hWnd);
+
+    GetClientRect(_hWnd, &win);
+
+    _hLVWnd = CreateWindow(WC_LISTVIEW, NULL, WS_CHILD | WS_VISIBLE |
+            LVS_REPORT | LVS_SINGLESEL | LVS_NOLABELWRAP | LVS_NOSORTHEADER | LVS_OWNERDATA,
+            0, 0, win.right - win.left, win.bottom - win.top,
+            _hWnd, NULL, HMod, NULL);
+
+    HDC hdc = GetWindowDC(_hLVWnd);
+
+    _hFont = CreateFont(
+            -MulDiv(UIFontSize, GetDeviceCaps(hdc, LOGPIXELSY), 72),
+            0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, ANSI_CHARSET,
+            OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
+            FF_DONTCARE | DEFAULT_PITCH, UIFontName.C_str());
+
+    ReleaseDC(_hLVWnd, hdc);
+
+    if (_hFont)
+        SendMessage(_hLVWnd, WM_SETFONT, (WPARAM)_hFont, TRUE);
+
+    ListView_SetExtendedListViewStyle(_hLVWnd, LVS_EX_LABELTIP | LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER);
+
+    TCHAR buf[32];
+    _tcscpy_s(buf, _countof(buf), header);
+
+    LVCOLUMN lvCol      = {0};
+    lvCol.mask          = LVCF_TEXT | LVCF_WIDTH;
+    lvCol.pszText       = buf;
+    lvCol.cchTextMax    = _countof(buf);
+    lvCol.cx            = cWidth;
+    ListView_InsertColumn(_hLVWnd, 0, &lvCol);
+
+    DWORD backgroundColor = GetSysColor(cBackgroundColor);
+    ListView_SetBkColor(_hLVWnd, backgroundColor);
+    ListView_SetTextBkColor(_hLVWnd, backgroundColor);
+
+    CTextA wordA;
+    INpp::Get().GetWord(wordA, true, true, true);
+    CText word(wordA.C_str());
+
+    // The fuzzy completion is of all symbols - close it when the word gets shorter than it was
+    if (!_cmdTagLen)
+        _cmdTagLen = (int)word.Len();
+
+    if (!filterLV(word))
+    {
+        SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        return NULL;
+    }
+
+    resizeLV();
+
+    ShowWindow(_hWnd, SW_SHOWNORMAL);
+    UpdateWindow(_hWnd);
+
+    INpp::Get().BeginUndoAction();
+
+    return _hWnd;
+}
+
+
+/**
+ *  \brief  The completion list is sorted ignoring case so the matches are a range in it
+ */
+int AutoCompleteWin::filterLV(const CText& filter)
+{
+    const size_t len = filter.Len();
+
+    size_t first, last;
+
+    if (GTagsSettings._fuzzyCompl && len)
+    {
+        const LineParser* parser = static_cast<const LineParser*>(_completion.get());
+
+        // The best matches are not a subset of the previous ones so there is no narrowing
+        FuzzyMatcher(filter.C_str(), _ic).SelectBest(parser->GetList(), parser->GetCharBags(), cMaxFuzzyMatches,
+                _matches);
+    }
+    else if (_filtered && len >= _filter.Len() && !_tcsncmp(filter.C_str(), _filter.C_str(), _filter.Len()))
+    {
+        // The filter only grew - narrow the previous matches instead of searching the whole list
+        LineParser::FindPrefix(_matches, filter.C_str(), len, first, last);
+
+        _matches.erase(_matches.begin() + last, _matches.end());
+        _matches.erase(_matches.begin(), _matches.begin() + first);
+    }
+    else
+    {
+        const std::vector<TCHAR*>& list = _completion->GetList();
+
+        LineParser::FindPrefix(list, filter.C_str(), len, first, last);
+
+        _matches.assign(list.begin() + first, list.begin() + last);
+    }
+
+    if (!_ic && len && !GTagsSettings._fuzzyCompl)
+    {
+        _matches.erase(std::remove_if(_matches.begin(), _matches.end(),
+            [&filter, len](const TCHAR* entry) { return (_tcsncmp(entry, filter.C_str(), len) != 0); }),
+            _matches.end());
+    }
+
+    _filter = filter;
+    _filtered = !GTagsSettings._fuzzyCompl;
+
+    // _matches stay in list order for the narrowing above
+    _db->Usage().Rank(_matches, !GTagsSettings._fuzzyCompl || !len, filter.C_str(), len, _ic, _ranked);
+
+    const int itemsCount = (int)_matches.size();
+
+    ListView_SetItemCountEx(_hLVWnd, itemsCount, 0);
+
+    if (itemsCount > 0)
+    {
+        ListView_SetItemState(_hLVWnd, 0, LVIS_FOCUSED | LVIS_SELECTED, LVIS_FOCUSED | LVIS_SELECTED);
+        ListView_EnsureVisible(_hLVWnd, 0, FALSE);
+    }
+
+    return itemsCount;
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::resizeLV()
+{
+    bool scroll = false;
+    int rowsCount = ListView_GetItemCount(_hLVWnd);
+    if (rowsCount > 7)
+    {
+        rowsCount = 7;
+        scroll = true;
+    }
+
+    RECT win;
+    ListView_GetItemRect(_hLVWnd, 0, &win, LVIR_BOUNDS);
+    int lvWidth     = win.right - win.left;
+    int lvHeight    = (win.bottom - win.top) * rowsCount;
+
+    HWND hHeader = ListView_GetHeader(_hLVWnd);
+    GetWindowRect(hHeader, &win);
+    lvHeight += win.bottom - win.top;
+
+    RECT maxWin;
+    INpp& npp = INpp::Get();
+    GetWindowRect(npp.GetSciHandle(), &maxWin);
+
+    int maxWidth = (maxWin.right - maxWin.left) - 30;
+    if (scroll)
+        maxWidth -= GetSystemMetrics(SM_CXVSCROLL);
+    if (lvWidth > maxWidth)
+        lvWidth = maxWidth;
+
+    ListView_SetColumnWidth(_hLVWnd, 0, lvWidth);
+
+    if (scroll)
+        lvWidth += GetSystemMetrics(SM_CXVSCROLL);
+
+    win.left    = maxWin.left;
+    win.top     = maxWin.top;
+    win.right   = win.left + lvWidth;
+    win.bottom  = win.top + lvHeight;
+
+    AdjustWindowRect(&win, (DWORD)GetWindowLongPtr(_hWnd, GWL_STYLE), FALSE);
+    lvWidth     = win.right - win.left;
+    lvHeight    = win.bottom - win.top;
+
+    int xOffset, yOffset;
+    npp.GetPointPos(&xOffset, &yOffset);
+
+    win.left    = maxWin.left + xOffset;
+    win.top     = maxWin.top + yOffset + npp.GetTextHeight();
+    win.right   = win.left + lvWidth;
+    win.bottom  = win.top + lvHeight;
+
+    xOffset = win.right - maxWin.right;
+    if (xOffset > 0)
+    {
+        win.left    -= xOffset;
+        win.right   -= xOffset;
+    }
+
+    if (win.bottom > maxWin.bottom)
+    {
+        win.bottom  = maxWin.top + yOffset;
+        win.top     = win.bottom - lvHeight;
+    }
+
+    MoveWindow(_hWnd, win.left, win.top, win.right - win.left, win.bottom - win.top, TRUE);
+
+    GetClientRect(_hWnd, &win);
+    MoveWindow(_hLVWnd, 0, 0, win.right - win.left, win.bottom - win.top, TRUE);
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::onGetDispInfo(NMLVDISPINFO* pDispInfo)
+{
+    LVITEM& lvItem = pDispInfo->item;
+
+    const std::vector<TCHAR*>& items = shown();
+
+    if ((lvItem.mask & LVIF_TEXT) && lvItem.iItem >= 0 && lvItem.iItem < (int)items.size())
+        lvItem.pszText = items[lvItem.iItem];
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::onPrePaint()
+{
+    if (_paintTiming)
+    {
+        _paintTiming->Mark(CmdTiming::FIRST_PAINT);
+        _paintTiming = nullptr;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void AutoCompleteWin::onDblClick()
+{
+    const std::vector<TCHAR*>& items = shown();
+
+    const int iItem = ListView_GetNextItem(_hLVWnd, -1, LVNI_SELECTED);
+    if (iItem < 0 || iItem >= (int)items.size())
+        return;
+
+    _db->Usage().RecordCompletion(items[iItem]);
+
+    CTextA completion(items[iItem]);
+    INpp::Get().ReplaceWordMulti(completion.C_str(), true);
+
+    SendMessage(_hWnd, WM_CLOSE, 0, 0);
+}
+
+
+/**
+ *  \brief
+ */
+bool AutoCompleteWin::onKeyDown(int keyCode)
+{
+    switch (keyCode)
+    {
+        case VK_UP:
+        case VK_DOWN:
+        return false;
+
+        case VK_TAB:
+        case VK_RETURN:
+            onDblClick();
+        return true;
+
+        case VK_LEFT:
+        case VK_RIGHT:
+        case VK_ESCAPE:
+        case VK_CONTROL:
+        case VK_MENU:
+            SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        return true;
+
+        case VK_DELETE:
+            INpp::Get().ReplaceWordMulti("", true);
+            SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        return true;
+
+        case VK_BACK:
+        {
+            INpp& npp = INpp::Get();
+            npp.ClearSelectionMulti();
+            npp.Backspace();
+            if (npp.GetWordSize(true) < _cmdTagLen)
+            {
+                SendMessage(_hWnd, WM_CLOSE, 0, 0);
+                return true;
+            }
+        }
+        break;
+
+        default:
+        {
+            BYTE keysState[256];
+            WORD character;
+
+            if (!GetKeyboardState(keysState))
+                return false;
+            if (ToAscii(keyCode, MapVirtualKey(keyCode, MAPVK_VK_TO_VSC), keysState, &character, 1) != 1)
+                return false;
+
+            INpp& npp = INpp::Get();
+
+            if (npp.GetSelectionsCount() == 1)
+            {
+                npp.AddText((char*)&character, 1);
+            }
+            else
+            {
+                const char charStr[] {(char)character, '\0'};
+                npp.InsertTextAtMultiPos(charStr);
+            }
+
+            if (keyCode == VK_SPACE)
+            {
+                SendMessage(_hWnd, WM_CLOSE, 0, 0);
+                return true;
+            }
+        }
+    }
+
+    if (!INpp::Get().IsPreviousCharWordEnd())
+    {
+        CTextA wordA;
+        INpp::Get().GetWord(wordA, true, true, true);
+        CText word(wordA.C_str());
+        int lvItemsCnt = filterLV(word);
+
+        if (lvItemsCnt == 0)
+        {
+            SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        }
+        else if (lvItemsCnt == 1)
+        {
+            if (!_tcscmp(word.C_str(), shown()[0]))
+                SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        }
+    }
+    else
+    {
+        SendMessage(_hWnd, WM_CLOSE, 0, 0);
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+LRESULT APIENTRY AutoCompleteWin::wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    switch (uMsg)
+    {
+        case WM_CREATE:
+        return 0;
+
+        case WM_SETFOCUS:
+            SetFocus(ACW->_hLVWnd);
+        return 0;
+
+        case WM_NOTIFY:
+            switch (((LPNMHDR)lParam)->code)
+            {
+                case NM_KILLFOCUS:
+                    SendMessage(hWnd, WM_CLOSE, 0, 0);
+                return 0;
+
+                case LVN_KEYDOWN:
+                    if (ACW->onKeyDown(((LPNMLVKEYDOWN)lParam)->wVKey))
+                        return 1;
+                break;
+
+                case LVN_GETDISPINFO:
+                    ACW->onGetDispInfo((NMLVDISPINFO*)lParam);
+                return 0;
+
+                case NM_DBLCLK:
+                    ACW->onDblClick();
+                return 0;
+
+                case NM_CUSTOMDRAW:
+                    if (((LPNMCUSTOMDRAW)lParam)->dwDrawStage == CDDS_PREPAINT)
+                        ACW->onPrePaint();
+                return CDRF_DODEFAULT;
+            }
+        break;
+
+        case WM_DESTROY:
+            ACW = nullptr;
+        return 0;
+    }
+
+    return DefWindowProc(hWnd, uMsg, wParam, lParam);
+}
+
+} // namespace GTags
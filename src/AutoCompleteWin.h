@@ -1,86 +1,106 @@
-/**
- *  \file
- *  \brief  GTags AutoComplete window
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <windows.h>
-#include <tchar.h>
-#include <memory>
-#include "Common.h"
-#include "CmdDefines.h"
-
-
-namespace GTags
-{
-
-/**
- *  \class  AutoCompleteWin
- *  \brief
- */
-class AutoCompleteWin
-{
-public:
-    static void Register();
-    static void Unregister();
-
-    static void Show(const CmdPtr_t& cmd);
-
-    static bool IsShown()
-    {
-        return (ACW != nullptr);
-    }
-
-    AutoCompleteWin(const CmdPtr_t& cmd);
-    AutoCompleteWin(const AutoCompleteWin&);
-    ~AutoCompleteWin();
-
-private:
-    static const TCHAR  cClassName[];
-    static const int    cBackgroundColor;
-    static const int    cWidth;
-
-    static LRESULT APIENTRY wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-
-    AutoCompleteWin& operator=(const AutoCompleteWin&) = delete;
-
-    HWND composeWindow(const TCHAR* header);
-    int filterLV(const CText& filter);
-    void resizeLV();
-
-    void onDblClick();
-    bool onKeyDown(int keyCode);
-
-    static std::unique_ptr<AutoCompleteWin> ACW;
-
-    HWND            _hWnd;
-    HWND            _hLVWnd;
-    HFONT           _hFont;
-    const CmdId_t   _cmdId;
-    const bool      _ic;
-    const int       _cmdTagLen;
-    ParserPtr_t     _completion;
-};
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags AutoComplete window
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <memory>
+#include <vector>
+#include "Common.h"
+#include "CmdDefines.h"
+#include "DbManager.h"
+#include "CmdTiming.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  AutoCompleteWin
+ *  \brief
+ */
+class AutoCompleteWin
+{
+public:
+    static void Register();
+    static void Unregister();
+
+    static void Show(const CmdPtr_t& cmd);
+
+    static bool IsShown()
+    {
+        return (ACW != nullptr);
+    }
+
+    AutoCompleteWin(const CmdPtr_t& cmd);
+    AutoCompleteWin(const AutoCompleteWin&);
+    ~AutoCompleteWin();
+
+private:
+    static const TCHAR  cClassName[];
+    static const int    cBackgroundColor;
+    static const int    cWidth;
+    static const size_t cMaxFuzzyMatches;
+
+    static LRESULT APIENTRY wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+    AutoCompleteWin& operator=(const AutoCompleteWin&) = delete;
+
+    HWND composeWindow(const TCHAR* header);
+    int filterLV(const CText& filter);
+    void resizeLV();
+
+    // The used matches ranked first if any
+    inline const std::vector<TCHAR*>& shown() const
+    {
+        return (_ranked.empty() ? _matches : _ranked);
+    }
+
+    void onGetDispInfo(NMLVDISPINFO* pDispInfo);
+    void onPrePaint();
+    void onDblClick();
+    bool onKeyDown(int keyCode);
+
+    static std::unique_ptr<AutoCompleteWin> ACW;
+
+    HWND            _hWnd;
+    HWND            _hLVWnd;
+    HFONT           _hFont;
+    const CmdId_t   _cmdId;
+    const bool      _ic;
+    int             _cmdTagLen;
+    DbHandle        _db;
+    ParserPtr_t     _completion;
+    CmdTimingPtr_t  _paintTiming; // Stamped on the first list view paint
+
+    // The virtual list view items - narrowed when the filter grows
+    std::vector<TCHAR*> _matches;
+    CText               _filter;
+    bool                _filtered;
+    std::vector<TCHAR*> _ranked;
+};
+
+} // namespace GTags
@@ -0,0 +1,154 @@
+/**
+ *  \file
+ *  \brief  Binary blob writing and bounds checked reading for the session and spill files
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string>
+
+
+namespace GTags
+{
+
+/**
+ *  \brief
+ */
+template<typename T>
+inline void put(std::vector<char>& out, const T& val)
+{
+    const char* pVal = reinterpret_cast<const char*>(&val);
+    out.insert(out.end(), pVal, pVal + sizeof(T));
+}
+
+
+/**
+ *  \brief
+ */
+inline void putStr(std::vector<char>& out, const char* str, size_t len)
+{
+    put(out, (uint64_t)len);
+    out.insert(out.end(), str, str + len);
+}
+
+
+/**
+ *  \brief
+ */
+template<typename T>
+inline void putArray(std::vector<char>& out, const std::vector<T>& arr)
+{
+    put(out, (uint64_t)arr.size());
+
+    const char* pArr = reinterpret_cast<const char*>(arr.data());
+    out.insert(out.end(), pArr, pArr + arr.size() * sizeof(T));
+}
+
+
+/**
+ *  \class  BlobReader
+ *  \brief  Bounds checked reader of the session and spill data - any overrun fails all following reads
+ */
+class BlobReader
+{
+public:
+    BlobReader(const char* data, size_t size) : _pos(data), _end(data + size), _ok(data != NULL) {}
+
+    inline bool Ok() const { return _ok; }
+    inline const char* Pos() const { return _pos; }
+
+    const char* Skip(uint64_t size)
+    {
+        if (!_ok || size > (uint64_t)(_end - _pos))
+        {
+            _ok = false;
+            return NULL;
+        }
+
+        const char* pData = _pos;
+        _pos += size;
+
+        return pData;
+    }
+
+    template<typename T>
+    T Get()
+    {
+        T val = T();
+
+        const char* pData = Skip(sizeof(T));
+        if (pData)
+            memcpy(&val, pData, sizeof(T));
+
+        return val;
+    }
+
+    const char* GetData(size_t& len)
+    {
+        const uint64_t size = Get<uint64_t>();
+        const char* pData = Skip(size);
+
+        len = pData ? (size_t)size : 0;
+
+        return pData;
+    }
+
+    void GetStr(std::string& str)
+    {
+        size_t len;
+        const char* pData = GetData(len);
+
+        if (pData)
+            str.assign(pData, len);
+        else
+            str.clear();
+    }
+
+    template<typename T>
+    void GetArray(std::vector<T>& arr)
+    {
+        const uint64_t count = Get<uint64_t>();
+        const char* pData = (count <= (uint64_t)(_end - _pos) / sizeof(T)) ? Skip(count * sizeof(T)) : Skip(~0ULL);
+
+        if (pData)
+        {
+            arr.resize((size_t)count);
+            memcpy(arr.data(), pData, (size_t)count * sizeof(T));
+        }
+        else
+        {
+            arr.clear();
+        }
+    }
+
+private:
+    const char*         _pos;
+    const char* const   _end;
+    bool                _ok;
+};
+
+} // namespace GTags
@@ -1,129 +1,218 @@
-/**
- *  \file
- *  \brief  GTags command class
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2015-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <windows.h>
-#include <tchar.h>
-#include <cstdint>
-#include <vector>
-#include "Common.h"
-#include "CmdDefines.h"
-#include "DbManager.h"
-
-
-namespace GTags
-{
-
-class CmdEngine;
-
-
-/**
- *  \class  ResultParser
- *  \brief
- */
-class ResultParser
-{
-public:
-    virtual ~ResultParser() {}
-
-    virtual intptr_t Parse(const CmdPtr_t&) = 0;
-    virtual const CTextA& GetText() const { return _buf; }
-    virtual const std::vector<TCHAR*>& GetList() const { return _lines; }
-
-protected:
-    CTextA              _buf;
-    std::vector<TCHAR*> _lines;
-};
-
-
-/**
- *  \class  Cmd
- *  \brief
- */
-class Cmd
-{
-public:
-    static const TCHAR* CmdName[];
-
-    Cmd(CmdId_t id, DbHandle db = NULL, ParserPtr_t parser = ParserPtr_t(NULL),
-            const TCHAR* tag = NULL, bool ignoreCase = false, bool regExp = false, bool autorun = false);
-    ~Cmd() {}
-
-    inline void Id(CmdId_t id) { _id = id; }
-    inline CmdId_t Id() const { return _id; }
-
-    inline const TCHAR* Name() const { return CmdName[_id]; }
-
-    inline DbHandle Db() const { return _db; }
-
-    inline void Tag(const CText& tag) { _tag = tag; }
-    inline const CText& Tag() const { return _tag; }
-
-    inline void Parser(const ParserPtr_t& parser) { _parser = parser; }
-    inline const ParserPtr_t& Parser() const { return _parser; }
-
-    inline void RegExp(bool re) { _regExp = re; }
-    inline bool RegExp() const { return _regExp; }
-
-    inline void IgnoreCase(bool ic) { _ignoreCase = ic; }
-    inline bool IgnoreCase() const { return _ignoreCase; }
-
-    inline bool IsAutorun() const { return _autorun; }
-
-    inline void SkipLibs(bool skipLibs) { _skipLibs = skipLibs; }
-    inline bool SkipLibs() const { return _skipLibs; }
-
-    inline void Status(CmdStatus_t stat) { _status = stat; }
-    inline CmdStatus_t Status() const { return _status; }
-
-    inline char* Result() { return _result.data(); }
-    inline const char* Result() const { return _result.data(); }
-    inline size_t ResultLen() const { return _result.size() - 1; }
-
-    void AppendToResult(const std::vector<char>& data);
-    void SetResult(const std::vector<char>& data)
-    {
-        _result.assign(data.begin(), data.end());
-    }
-
-private:
-    friend class CmdEngine;
-
-    CmdId_t             _id;
-    DbHandle            _db;
-
-    CText               _tag;
-    ParserPtr_t         _parser;
-    bool                _ignoreCase;
-    bool                _regExp;
-    bool                _autorun; // Used only for AutoComplete command to distinguish between auto and manual run
-    bool                _skipLibs;
-
-    CmdStatus_t         _status;
-    std::vector<char>   _result;
-};
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags command class
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2015-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include "Common.h"
+#include "CmdDefines.h"
+#include "DbManager.h"
+#include "CmdTiming.h"
+#include "ReadPipe.h"
+
+
+namespace GTags
+{
+
+class CmdEngine;
+
+
+/**
+ *  \class  ResultParser
+ *  \brief
+ */
+class ResultParser
+{
+public:
+    virtual ~ResultParser() {}
+
+    virtual intptr_t Parse(const CmdPtr_t&) = 0;
+    virtual const CTextA& GetText() const { return _buf; }
+    virtual const std::vector<TCHAR*>& GetList() const { return _lines; }
+
+protected:
+    CTextA              _buf;
+    std::vector<TCHAR*> _lines;
+};
+
+
+/**
+ *  \class  Cmd
+ *  \brief
+ */
+class Cmd
+{
+public:
+    static const TCHAR* CmdName[];
+
+    Cmd(CmdId_t id, DbHandle db = NULL, ParserPtr_t parser = ParserPtr_t(NULL),
+            const TCHAR* tag = NULL, bool ignoreCase = false, bool regExp = false, bool autorun = false);
+    ~Cmd() {}
+
+    inline void Id(CmdId_t id) { _id = id; }
+    inline CmdId_t Id() const { return _id; }
+
+    inline const TCHAR* Name() const { return CmdName[_id]; }
+
+    inline DbHandle Db() const { return _db; }
+
+    inline void Tag(const CText& tag) { _tag = tag; }
+    inline const CText& Tag() const { return _tag; }
+
+    inline void Parser(const ParserPtr_t& parser) { _parser = parser; }
+    inline const ParserPtr_t& Parser() const { return _parser; }
+
+    inline void RegExp(bool re) { _regExp = re; }
+    inline bool RegExp() const { return _regExp; }
+
+    inline void IgnoreCase(bool ic) { _ignoreCase = ic; }
+    inline bool IgnoreCase() const { return _ignoreCase; }
+
+    inline bool IsAutorun() const { return _autorun; }
+
+    inline void SkipLibs(bool skipLibs) { _skipLibs = skipLibs; }
+    inline bool SkipLibs() const { return _skipLibs; }
+
+    inline void LinesOffset(unsigned offset) { _linesOffset = offset; }
+    inline unsigned LinesOffset() const { return _linesOffset; }
+
+    // Search only under this database subfolder - used to re-query a single updated file
+    inline void LocalDir(const CPath& dir) { _localDir = dir; }
+    inline const CPath& LocalDir() const { return _localDir; }
+
+    inline bool IsTruncated() const { return _truncated; }
+
+    inline const CmdTimingPtr_t& Timing() const { return _timing; }
+
+    inline void Status(CmdStatus_t stat) { _status = stat; }
+    inline CmdStatus_t Status() const { return _status; }
+
+    // The command output is gathered into one buffer here, on the first call - for the short messages shown whole
+    inline char* Result() { _output.AppendTo(_result); return _result.data(); }
+    inline bool HasResult() const { return (!_result.empty() || _output.Len()); }
+    inline size_t ResultLen() const { return (_result.empty() ? 0 : _result.size() - 1) + _output.Len(); }
+
+    // Reads the result in order as it is kept - f(const char* data, size_t len) is called for each part
+    template<typename F>
+    void ForEachResultPart(F f) const
+    {
+        if (_result.size() > 1)
+            f(_result.data(), _result.size() - 1);
+
+        for (size_t i = 0; i < _output.ChunksCount(); ++i)
+            f(_output.ChunkData(i), (size_t)_output.ChunkLen(i));
+    }
+
+    // Reads the result line by line - f(const char* line, size_t len) gets each line without its EOL and
+    // returns false to stop. Only the lines split between two parts are copied. Returns false if stopped
+    template<typename F>
+    bool ForEachResultLine(F f) const
+    {
+        std::string split;
+        bool stopped = false;
+
+        ForEachResultPart([&f, &split, &stopped](const char* pData, size_t len)
+        {
+            const char* const pEnd = pData + len;
+            const char* pSrc = pData;
+            const char* pEol;
+
+            for (; !stopped && (pEol = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc))) != NULL;
+                    pSrc = pEol + 1)
+            {
+                if (split.empty())
+                {
+                    stopped = !callForLine(f, pSrc, pEol - pSrc);
+                }
+                else
+                {
+                    split.append(pSrc, pEol - pSrc);
+                    stopped = !callForLine(f, split.data(), split.size());
+                    split.clear();
+                }
+            }
+
+            if (!stopped)
+                split.append(pSrc, pEnd - pSrc);
+        });
+
+        if (!stopped && !split.empty())
+            stopped = !callForLine(f, split.data(), split.size());
+
+        return !stopped;
+    }
+
+    void AppendToResult(ReadPipe::Output&& output);
+    void AppendToResult(const std::vector<char>& data);
+    void AppendToResult(std::vector<char>&& data);
+    void SetResult(const std::vector<char>& data)
+    {
+        _output.Release();
+        _result.assign(data.begin(), data.end());
+    }
+    void SetResult(std::vector<char>&& data)
+    {
+        _output.Release();
+        _result = std::move(data);
+    }
+
+private:
+    friend class CmdEngine;
+
+    template<typename F>
+    static bool callForLine(F& f, const char* pLine, size_t len)
+    {
+        if (len && pLine[len - 1] == '\r')
+            --len;
+
+        return f(pLine, len);
+    }
+
+    CmdId_t             _id;
+    DbHandle            _db;
+
+    CText               _tag;
+    ParserPtr_t         _parser;
+    bool                _ignoreCase;
+    bool                _regExp;
+    bool                _autorun; // Used only for AutoComplete command to distinguish between auto and manual run
+    bool                _skipLibs;
+    unsigned            _linesOffset; // Output lines to skip - used to continue truncated results
+    CPath               _localDir;
+
+    CmdStatus_t         _status;
+    bool                _truncated;
+    std::vector<char>   _result;
+    ReadPipe::Output    _output; // The output appended last, not gathered into _result yet
+    CmdTimingPtr_t      _timing; // Set by CmdEngine on each run
+};
+
+} // namespace GTags
@@ -0,0 +1,551 @@
+/**
+ *  \file
+ *  \brief  GTags binaries output capture, replay and faking - development builds only
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifdef DEVEL
+
+#include "CmdCapture.h"
+#include <process.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string>
+#include "ReadPipe.h"
+
+
+/*
+ *  Capture file layout (little endian):
+ *
+ *  "GTCAP01\n"
+ *  u32 command line length, command line (UTF-8, binaries folder stripped)
+ *  u64 process exit time in us since spawn
+ *  records until EOF: u8 stream (1 - stdout, 2 - stderr), u64 time in us since spawn, u32 length, data
+ */
+
+
+namespace
+{
+
+enum CaptureStream_t
+{
+    STDOUT_STREAM = 1,
+    STDERR_STREAM = 2
+};
+
+
+/**
+ *  \struct  Replay
+ *  \brief
+ */
+struct Replay
+{
+    std::vector<char>   data;
+    size_t              recordsPos;
+    uint64_t            exitTime;
+    HANDLE              hDataIn;
+    HANDLE              hErrorIn;
+    HANDLE              hStop;
+};
+
+
+/**
+ *  \brief  The binaries folder is machine specific - key the captures by what follows it
+ */
+const TCHAR* captureKey(const CText& cmdLine)
+{
+    const TCHAR* pKey = _tcsstr(cmdLine.C_str(), _T(".exe\""));
+    if (pKey == NULL)
+        return cmdLine.C_str();
+
+    while (pKey > cmdLine.C_str() && *(pKey - 1) != _T('\\') && *(pKey - 1) != _T('"'))
+        --pKey;
+
+    return pKey;
+}
+
+
+/**
+ *  \brief
+ */
+uint64_t toUs(LONGLONG time, LONGLONG origin)
+{
+    static LONGLONG freq = 0;
+
+    if (!freq)
+    {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        freq = f.QuadPart;
+    }
+
+    if (time <= origin)
+        return 0;
+
+    return (uint64_t)((time - origin) * 1000000 / freq);
+}
+
+
+/**
+ *  \brief
+ */
+void writeRecord(FILE* fp, uint8_t stream, uint64_t time, const char* data, uint32_t len)
+{
+    fwrite(&stream, sizeof(stream), 1, fp);
+    fwrite(&time, sizeof(time), 1, fp);
+    fwrite(&len, sizeof(len), 1, fp);
+    fwrite(data, 1, len, fp);
+}
+
+
+/**
+ *  \brief
+ */
+void writeRecord(std::vector<char>& buf, uint8_t stream, uint64_t time, const char* data, uint32_t len)
+{
+    const char* pStream = reinterpret_cast<const char*>(&stream);
+    const char* pTime = reinterpret_cast<const char*>(&time);
+    const char* pLen = reinterpret_cast<const char*>(&len);
+
+    buf.insert(buf.end(), pStream, pStream + sizeof(stream));
+    buf.insert(buf.end(), pTime, pTime + sizeof(time));
+    buf.insert(buf.end(), pLen, pLen + sizeof(len));
+    buf.insert(buf.end(), data, data + len);
+}
+
+
+/**
+ *  \brief  Waits until the given time since replay start - returns false if the replay was stopped
+ */
+bool waitUntil(HANDLE hStop, LONGLONG start, uint64_t timeUs)
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    const uint64_t elapsedUs = toUs(now.QuadPart, start);
+    const DWORD waitMs = (timeUs > elapsedUs) ? (DWORD)((timeUs - elapsedUs) / 1000) : 0;
+
+    return (WaitForSingleObject(hStop, waitMs) == WAIT_TIMEOUT);
+}
+
+} // anonymous namespace
+
+
+namespace GTags
+{
+
+const char  CmdCapture::cMagic[]            = "GTCAP01\n";
+const TCHAR CmdCapture::cCaptureDirVar[]    = _T("NPPGTAGS_CAPTURE_DIR");
+const TCHAR CmdCapture::cReplayDirVar[]     = _T("NPPGTAGS_REPLAY_DIR");
+const TCHAR CmdCapture::cBinDirVar[]        = _T("NPPGTAGS_BIN_DIR");
+const TCHAR CmdCapture::cFakeVar[]          = _T("NPPGTAGS_FAKE");
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::GetCaptureDir(CPath& dir)
+{
+    return getDir(cCaptureDirVar, dir);
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::GetReplayDir(CPath& dir)
+{
+    return getDir(cReplayDirVar, dir);
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::GetBinariesDir(CPath& dir)
+{
+    return getDir(cBinDirVar, dir);
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::GetFakeSpec(FakeSpec& spec)
+{
+    TCHAR buf[256];
+
+    const DWORD len = GetEnvironmentVariable(cFakeVar, buf, _countof(buf));
+    if (len == 0 || len >= _countof(buf))
+        return false;
+
+    spec.lines  = 1000;
+    spec.rate   = 0;
+    spec.chunk  = 100;
+    spec.delay  = 0;
+    spec.exit   = 0;
+    spec.error  = false;
+
+    TCHAR* pContext = NULL;
+
+    for (TCHAR* pTok = _tcstok_s(buf, _T(",; "), &pContext); pTok; pTok = _tcstok_s(NULL, _T(",; "), &pContext))
+    {
+        TCHAR* pVal = _tcschr(pTok, _T('='));
+        if (pVal == NULL)
+            continue;
+
+        *pVal++ = 0;
+        const unsigned val = (unsigned)_tcstoul(pVal, NULL, 10);
+
+        if (!_tcsicmp(pTok, _T("lines")))
+            spec.lines = val;
+        else if (!_tcsicmp(pTok, _T("rate")))
+            spec.rate = val;
+        else if (!_tcsicmp(pTok, _T("chunk")))
+            spec.chunk = val;
+        else if (!_tcsicmp(pTok, _T("delay")))
+            spec.delay = val;
+        else if (!_tcsicmp(pTok, _T("exit")))
+            spec.exit = val;
+        else if (!_tcsicmp(pTok, _T("error")))
+            spec.error = (val != 0);
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::Save(const CPath& dir, const CText& cmdLine, const ReadPipe& dataPipe, const ReadPipe& errorPipe,
+        LONGLONG spawnTime, LONGLONG exitTime)
+{
+    CPath file;
+    getCaptureFile(dir, cmdLine, file);
+
+    FILE* fp;
+    _tfopen_s(&fp, file.C_str(), _T("wb"));
+    if (fp == NULL)
+        return false;
+
+    const CTextA key(captureKey(cmdLine));
+    const uint32_t keyLen = (uint32_t)key.Len();
+    const uint64_t exitUs = toUs(exitTime, spawnTime);
+
+    fwrite(cMagic, 1, sizeof(cMagic) - 1, fp);
+    fwrite(&keyLen, sizeof(keyLen), 1, fp);
+    fwrite(key.C_str(), 1, keyLen, fp);
+    fwrite(&exitUs, sizeof(exitUs), 1, fp);
+
+    const std::vector<ReadPipe::CaptureRead>& dataReads = dataPipe.GetCaptureReads();
+    const std::vector<ReadPipe::CaptureRead>& errorReads = errorPipe.GetCaptureReads();
+
+    // Merge both streams reads in time order
+    size_t d = 0, e = 0;
+
+    while (d < dataReads.size() || e < errorReads.size())
+    {
+        if (e == errorReads.size() || (d < dataReads.size() && dataReads[d].time <= errorReads[e].time))
+        {
+            const ReadPipe::CaptureRead& read = dataReads[d++];
+            writeRecord(fp, STDOUT_STREAM, toUs(read.time, spawnTime),
+                    dataPipe.GetCaptureData().data() + read.pos, read.len);
+        }
+        else
+        {
+            const ReadPipe::CaptureRead& read = errorReads[e++];
+            writeRecord(fp, STDERR_STREAM, toUs(read.time, spawnTime),
+                    errorPipe.GetCaptureData().data() + read.pos, read.len);
+        }
+    }
+
+    fclose(fp);
+
+    return true;
+}
+
+
+/**
+ *  \brief  Starts feeding a captured output to the pipes - takes ownership of the pipe handles on success
+ */
+bool CmdCapture::StartReplay(const CPath& dir, const CText& cmdLine, HANDLE hDataIn, HANDLE hErrorIn,
+        PROCESS_INFORMATION& pi)
+{
+    CPath file;
+    getCaptureFile(dir, cmdLine, file);
+
+    FILE* fp;
+    _tfopen_s(&fp, file.C_str(), _T("rb"));
+    if (fp == NULL)
+        return false;
+
+    Replay* replay = new Replay;
+
+    char buf[4096];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+        replay->data.insert(replay->data.end(), buf, buf + len);
+
+    fclose(fp);
+
+    const size_t magicLen = sizeof(cMagic) - 1;
+    uint32_t keyLen = 0;
+
+    if (replay->data.size() < magicLen + sizeof(keyLen) || memcmp(replay->data.data(), cMagic, magicLen))
+    {
+        delete replay;
+        return false;
+    }
+
+    memcpy(&keyLen, replay->data.data() + magicLen, sizeof(keyLen));
+
+    // The file name is a hash of the key - a file with another key stored is a collision or is corrupt
+    const CTextA key(captureKey(cmdLine));
+    const size_t headerLen = magicLen + sizeof(keyLen);
+
+    if (keyLen > replay->data.size() - headerLen ||
+            replay->data.size() - headerLen - keyLen < sizeof(replay->exitTime) ||
+            keyLen != key.Len() || memcmp(replay->data.data() + headerLen, key.C_str(), keyLen))
+    {
+        delete replay;
+        return false;
+    }
+
+    replay->recordsPos = headerLen + keyLen + sizeof(replay->exitTime);
+
+    memcpy(&replay->exitTime, replay->data.data() + replay->recordsPos - sizeof(replay->exitTime),
+            sizeof(replay->exitTime));
+
+    return startThread(replay, hDataIn, hErrorIn, pi);
+}
+
+
+/**
+ *  \brief  Starts feeding synthetic output in the command format - takes ownership of the pipe handles on success
+ */
+bool CmdCapture::StartFake(const FakeSpec& spec, CmdId_t id, const CText& tag, HANDLE hDataIn, HANDLE hErrorIn,
+        PROCESS_INFORMATION& pi)
+{
+    Replay* replay = new Replay;
+    replay->recordsPos = 0;
+
+    const CTextA tagA(tag.C_str());
+    const uint64_t delayUs = (uint64_t)spec.delay * 1000;
+    uint64_t time = delayUs;
+
+    if (spec.error)
+    {
+        const char* msg = "global: fake error.\n";
+        writeRecord(replay->data, STDERR_STREAM, time, msg, (uint32_t)strlen(msg));
+    }
+    else if (id == VERSION || id == CTAGS_VERSION)
+    {
+        const char* msg = "fake (GNU GLOBAL) 0.0.0\n";
+        writeRecord(replay->data, STDOUT_STREAM, time, msg, (uint32_t)strlen(msg));
+    }
+    else if (id != CREATE_DATABASE && id != UPDATE_SINGLE)
+    {
+        const unsigned chunk = spec.chunk ? spec.chunk : 1;
+        std::string lines;
+        char line[512];
+
+        for (unsigned i = 0; i < spec.lines; i += chunk)
+        {
+            lines.clear();
+
+            for (unsigned j = i; j < spec.lines && j < i + chunk; ++j)
+            {
+                if (id == AUTOCOMPLETE || id == AUTOCOMPLETE_SYMBOL)
+                    _snprintf_s(line, _countof(line), _TRUNCATE, "%s_%u\n", tagA.C_str(), j);
+                else if (id == AUTOCOMPLETE_FILE || id == FIND_FILE)
+                    _snprintf_s(line, _countof(line), _TRUNCATE, "dir%u/%s_%u.c\n", j % 97, tagA.C_str(), j);
+                else
+                    _snprintf_s(line, _countof(line), _TRUNCATE, "dir%u/file%u.c:%u:    %s_%u();\n",
+                            (j / 50) % 97, j / 50, j % 50 + 1, tagA.C_str(), j);
+
+                lines += line;
+            }
+
+            if (spec.rate)
+                time = delayUs + (uint64_t)i * 1000000 / spec.rate;
+
+            writeRecord(replay->data, STDOUT_STREAM, time, lines.data(), (uint32_t)lines.size());
+        }
+    }
+
+    replay->exitTime = time + (uint64_t)spec.exit * 1000;
+
+    return startThread(replay, hDataIn, hErrorIn, pi);
+}
+
+
+/**
+ *  \brief
+ */
+void CmdCapture::EndReplay(PROCESS_INFORMATION& pi)
+{
+    SetEvent(pi.hThread);
+
+    // The replay might be blocked writing to a pipe nobody reads anymore
+    CancelSynchronousIo(pi.hProcess);
+    WaitForSingleObject(pi.hProcess, INFINITE);
+
+    CloseHandle(pi.hProcess);
+    CloseHandle(pi.hThread);
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::getDir(const TCHAR* envVar, CPath& dir)
+{
+    CPath envDir(MAX_PATH);
+
+    const DWORD len = GetEnvironmentVariable(envVar, envDir.C_str(), (DWORD)envDir.Size());
+    if (len == 0 || len >= envDir.Size())
+        return false;
+
+    envDir.AutoFit();
+    envDir.AsFolder();
+
+    if (!envDir.Exists())
+        return false;
+
+    dir = envDir;
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdCapture::startThread(void* data, HANDLE hDataIn, HANDLE hErrorIn, PROCESS_INFORMATION& pi)
+{
+    Replay* replay = static_cast<Replay*>(data);
+
+    replay->hDataIn = hDataIn;
+    replay->hErrorIn = hErrorIn;
+    replay->hStop = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+    HANDLE hThread = replay->hStop ? (HANDLE)_beginthreadex(NULL, 0, replayThread, replay, 0, NULL) : NULL;
+    if (hThread == NULL)
+    {
+        if (replay->hStop)
+            CloseHandle(replay->hStop);
+        delete replay;
+        return false;
+    }
+
+    // The replay thread stands for the process and the stop event - for its main thread
+    pi.hProcess     = hThread;
+    pi.hThread      = replay->hStop;
+    pi.dwProcessId  = 0;
+    pi.dwThreadId   = 0;
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+void CmdCapture::getCaptureFile(const CPath& dir, const CText& cmdLine, CPath& file)
+{
+    // FNV-1a of the capture key
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (const TCHAR* pKey = captureKey(cmdLine); *pKey; ++pKey)
+    {
+        hash ^= (uint64_t)*pKey;
+        hash *= 1099511628211ULL;
+    }
+
+    TCHAR name[32];
+    _sntprintf_s(name, _countof(name), _TRUNCATE, _T("%016llx.gtcap"), hash);
+
+    file = dir;
+    file += name;
+}
+
+
+/**
+ *  \brief
+ */
+unsigned __stdcall CmdCapture::replayThread(void* data)
+{
+    Replay* replay = static_cast<Replay*>(data);
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    const char* pRec = replay->data.data() + replay->recordsPos;
+    const char* const pEnd = replay->data.data() + replay->data.size();
+
+    const size_t headerLen = sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint32_t);
+    bool stopped = false;
+
+    while (!stopped && pEnd - pRec >= (ptrdiff_t)headerLen)
+    {
+        uint8_t stream;
+        uint64_t time;
+        uint32_t len;
+
+        memcpy(&stream, pRec, sizeof(stream));
+        memcpy(&time, pRec + sizeof(stream), sizeof(time));
+        memcpy(&len, pRec + sizeof(stream) + sizeof(time), sizeof(len));
+        pRec += headerLen;
+
+        if ((size_t)(pEnd - pRec) < len)
+            break;
+
+        if (!waitUntil(replay->hStop, start.QuadPart, time))
+        {
+            stopped = true;
+            break;
+        }
+
+        DWORD written;
+        if (!WriteFile(stream == STDOUT_STREAM ? replay->hDataIn : replay->hErrorIn, pRec, len, &written, NULL))
+            stopped = true;
+
+        pRec += len;
+    }
+
+    if (!stopped)
+        waitUntil(replay->hStop, start.QuadPart, replay->exitTime);
+
+    // Closing the pipes makes the readers see the end of the output
+    CloseHandle(replay->hDataIn);
+    CloseHandle(replay->hErrorIn);
+
+    delete replay;
+
+    return 0;
+}
+
+} // namespace GTags
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ *  \file
+ *  \brief  GTags binaries output capture, replay and faking - development builds only
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#ifdef DEVEL
+
+#include <windows.h>
+#include <tchar.h>
+#include "Common.h"
+#include "CmdDefines.h"
+
+
+class ReadPipe;
+
+
+namespace GTags
+{
+
+/**
+ *  \class  CmdCapture
+ *  \brief  Records the exact output and pacing of the GTags binaries runs and replays them later
+ *
+ *  Capture is enabled by setting NPPGTAGS_CAPTURE_DIR environment variable to an existing folder.
+ *  Replay is enabled by setting NPPGTAGS_REPLAY_DIR environment variable to a folder with captures -
+ *  commands that have a capture there are not run but their output is fed to the pipes instead.
+ *  Synthetic output is generated instead of running any command if NPPGTAGS_FAKE environment variable
+ *  is set - see FakeSpec. NPPGTAGS_BIN_DIR environment variable overrides the GTags binaries folder.
+ */
+class CmdCapture
+{
+public:
+    /**
+     *  \struct  FakeSpec
+     *  \brief  Parsed from NPPGTAGS_FAKE="lines=100000,rate=20000,chunk=100,delay=500,exit=0,error=0"
+     */
+    struct FakeSpec
+    {
+        unsigned    lines;      // Output lines count
+        unsigned    rate;       // Output lines per second, 0 - as fast as possible
+        unsigned    chunk;      // Lines per pipe write
+        unsigned    delay;      // ms before the first output
+        unsigned    exit;       // ms between the last output and the process exit
+        bool        error;      // Output an error message on stderr only
+    };
+
+    static bool GetCaptureDir(CPath& dir);
+    static bool GetReplayDir(CPath& dir);
+    static bool GetBinariesDir(CPath& dir);
+    static bool GetFakeSpec(FakeSpec& spec);
+
+    static bool Save(const CPath& dir, const CText& cmdLine, const ReadPipe& dataPipe, const ReadPipe& errorPipe,
+            LONGLONG spawnTime, LONGLONG exitTime);
+
+    static bool StartReplay(const CPath& dir, const CText& cmdLine, HANDLE hDataIn, HANDLE hErrorIn,
+            PROCESS_INFORMATION& pi);
+    static bool StartFake(const FakeSpec& spec, CmdId_t id, const CText& tag, HANDLE hDataIn, HANDLE hErrorIn,
+            PROCESS_INFORMATION& pi);
+    static void EndReplay(PROCESS_INFORMATION& pi);
+
+    // Replays have no real process
+    static inline bool IsReplay(const PROCESS_INFORMATION& pi) { return (pi.dwProcessId == 0); }
+
+private:
+    static const char       cMagic[];
+    static const TCHAR      cCaptureDirVar[];
+    static const TCHAR      cReplayDirVar[];
+    static const TCHAR      cBinDirVar[];
+    static const TCHAR      cFakeVar[];
+
+    static bool getDir(const TCHAR* envVar, CPath& dir);
+    static bool startThread(void* replay, HANDLE hDataIn, HANDLE hErrorIn, PROCESS_INFORMATION& pi);
+    static void getCaptureFile(const CPath& dir, const CText& cmdLine, CPath& file);
+
+    static unsigned __stdcall replayThread(void* data);
+};
+
+} // namespace GTags
+
+#endif
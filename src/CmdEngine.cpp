@@ -1,372 +1,854 @@
-/**
- *  \file
- *  \brief  GTags command execution engine
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include <windows.h>
-#include <tchar.h>
-#include <process.h>
-#include "Common.h"
-#include "INpp.h"
-#include "Config.h"
-#include "GTags.h"
-#include "ReadPipe.h"
-#include "CmdEngine.h"
-#include "Cmd.h"
-
-
-namespace GTags
-{
-
-const TCHAR* CmdEngine::CmdLine[] = {
-    _T("\"%s\\gtags.exe\" -c --skip-unreadable"),                           // CREATE_DATABASE
-    _T("\"%s\\gtags.exe\" -c --skip-unreadable --single-update \"%s\""),    // UPDATE_SINGLE
-    _T("\"%s\\global.exe\" -cT \"%s\""),                                    // AUTOCOMPLETE
-    _T("\"%s\\global.exe\" -cs \"%s\""),                                    // AUTOCOMPLETE_SYMBOL
-    _T("\"%s\\global.exe\" -cPo --match-part=all \"%s\""),                  // AUTOCOMPLETE_FILE
-    _T("\"%s\\global.exe\" -Po \"%s\""),                                    // FIND_FILE
-    _T("\"%s\\global.exe\" -dT --result=grep --path-style=abslib \"%s\""),  // FIND_DEFINITION
-    _T("\"%s\\global.exe\" -r --result=grep \"%s\""),                       // FIND_REFERENCE
-    _T("\"%s\\global.exe\" -s --result=grep \"%s\""),                       // FIND_SYMBOL
-    _T("\"%s\\global.exe\" -g --result=grep \"%s\""),                       // GREP
-    _T("\"%s\\global.exe\" -gO --result=grep \"%s\""),                      // GREP_TEXT
-    _T("\"%s\\global.exe\" --version"),                                     // VERSION
-    _T("\"%s\\ctags.exe\" --version")                                       // CTAGS_VERSION
-};
-
-
-/**
- *  \brief
- */
-bool CmdEngine::Run(const CmdPtr_t& cmd, CompletionCB complCB)
-{
-    if (!complCB)
-        return false;
-
-    CmdEngine* engine = new CmdEngine(cmd, complCB);
-    cmd->Status(RUN_ERROR);
-
-    engine->_hThread = (HANDLE)_beginthreadex(NULL, 0, threadFunc, engine, 0, NULL);
-    if (engine->_hThread == NULL)
-    {
-        delete engine;
-        return false;
-    }
-
-    return true;
-}
-
-
-/**
- *  \brief
- */
-CmdEngine::CmdEngine(const CmdPtr_t& cmd, CompletionCB complCB) :
-    _cmd(cmd), _complCB(complCB), _hThread(NULL)
-{
-}
-
-
-/**
- *  \brief
- */
-CmdEngine::~CmdEngine()
-{
-    SendMessage(MainWndH, WM_RUN_CMD_CALLBACK, (WPARAM)_complCB, (LPARAM)(&_cmd));
-
-    if (_hThread)
-        CloseHandle(_hThread);
-}
-
-
-/**
- *  \brief
- */
-unsigned __stdcall CmdEngine::threadFunc(void* data)
-{
-    CmdEngine* engine = static_cast<CmdEngine*>(data);
-    unsigned r = engine->start();
-
-    delete engine;
-
-    return r;
-}
-
-
-/**
- *  \brief
- */
-unsigned CmdEngine::start()
-{
-    ReadPipe dataPipe;
-    ReadPipe errorPipe;
-
-    PROCESS_INFORMATION pi;
-
-    if (!runProcess(pi, dataPipe, errorPipe))
-        return 1;
-
-    bool showActivityWin = true;
-    if (_cmd->_id != CREATE_DATABASE && _cmd->_id != UPDATE_SINGLE)
-    {
-        // Wait 300 ms and if process has finished don't show Activity Window
-        if (WaitForSingleObject(pi.hProcess, 300) == WAIT_OBJECT_0)
-            showActivityWin = false;
-    }
-
-    if (showActivityWin)
-    {
-        HANDLE hCancel = CreateEvent(NULL, TRUE, FALSE, NULL);
-
-        if (hCancel)
-        {
-            CText header(_cmd->Name());
-
-            if (_cmd->_id != VERSION && _cmd->_id != CTAGS_VERSION)
-            {
-                header += _T(" - \"");
-                if (_cmd->_id == CREATE_DATABASE)
-                    header += _cmd->Db()->GetPath();
-                else
-                    header += _cmd->Tag();
-                header += _T('\"');
-            }
-
-            SendMessage(MainWndH, WM_OPEN_ACTIVITY_WIN,
-                    reinterpret_cast<WPARAM>(header.C_str()), reinterpret_cast<LPARAM>(hCancel));
-
-            HANDLE waitHandles[] = {pi.hProcess, hCancel};
-            DWORD handleId = WaitForMultipleObjects(2, waitHandles, FALSE, INFINITE) - WAIT_OBJECT_0;
-            if (handleId > 0 && handleId < 2 && waitHandles[handleId] == hCancel)
-                _cmd->_status = CANCELLED;
-
-            SendMessage(MainWndH, WM_CLOSE_ACTIVITY_WIN, 0, reinterpret_cast<LPARAM>(hCancel));
-
-            CloseHandle(hCancel);
-        }
-        else
-        {
-            WaitForSingleObject(pi.hProcess, INFINITE);
-        }
-    }
-
-    endProcess(pi);
-
-    if (_cmd->_status == CANCELLED)
-        return 1;
-
-    if (!dataPipe.GetOutput().empty())
-    {
-        _cmd->AppendToResult(dataPipe.GetOutput());
-    }
-    else if (!errorPipe.GetOutput().empty())
-    {
-        if (_cmd->_id != CREATE_DATABASE && _cmd->_id != UPDATE_SINGLE)
-        {
-            _cmd->SetResult(errorPipe.GetOutput());
-            _cmd->_status = FAILED;
-            return 1;
-        }
-
-        if (_cmd->_id == CREATE_DATABASE)
-            _cmd->SetResult(errorPipe.GetOutput());
-    }
-
-    _cmd->_status = OK;
-
-    if (_cmd->_parser)
-    {
-        if (_cmd->Result())
-        {
-            const intptr_t parsedEntries = _cmd->_parser->Parse(_cmd);
-
-            if (parsedEntries < 0)
-            {
-                _cmd->_status = PARSE_ERROR;
-                return 1;
-            }
-            else if (parsedEntries == 0)
-            {
-                _cmd->_status = PARSE_EMPTY; // No results to display actually (due to some filtering)
-                return 1;
-            }
-        }
-        // Blink the auto-complete word to inform the user if nothing is found
-        else if (_cmd->_id == AUTOCOMPLETE_FILE ||
-                ((_cmd->_id == AUTOCOMPLETE || _cmd->_id == AUTOCOMPLETE_SYMBOL) && !_cmd->_autorun))
-        {
-            CTextA wordA;
-            INpp::Get().GetWord(wordA, true, true);
-
-            if (wordA.Len())
-            {
-                CText word(wordA.C_str());
-
-                TCHAR* tag = _cmd->_tag.C_str();
-                size_t len = _cmd->_tag.Len();
-                if (_cmd->_id == AUTOCOMPLETE_FILE)
-                {
-                    ++tag;
-                    --len;
-                }
-
-                if (!_tcsncmp(word.C_str(), tag, len))
-                    Sleep(50);
-            }
-        }
-    }
-
-    if (_cmd->_id == CREATE_DATABASE)
-        _cmd->Db()->SaveCfg();
-
-    return 0;
-}
-
-
-/**
- *  \brief
- */
-void CmdEngine::composeCmd(CText& buf) const
-{
-    CPath path(DllPath);
-    path.StripFilename();
-    path += cBinariesFolder;
-
-    buf.Resize(2048);
-
-    if (_cmd->_id == CREATE_DATABASE || _cmd->_id == VERSION || _cmd->_id == CTAGS_VERSION)
-        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, CmdLine[_cmd->_id], path.C_str());
-    else
-        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, CmdLine[_cmd->_id], path.C_str(),
-                _cmd->Tag().C_str());
-
-    if (_cmd->_id == CREATE_DATABASE || _cmd->_id == UPDATE_SINGLE)
-    {
-        path += _T("\\gtags.conf");
-        if (path.FileExists())
-        {
-            buf += _T(" --gtagsconf \"");
-            buf += path;
-            buf += _T("\"");
-            buf += _T(" --gtagslabel=");
-            buf += _cmd->Db()->GetConfig().Parser();
-        }
-    }
-    else if (_cmd->_id != VERSION && _cmd->_id != CTAGS_VERSION)
-    {
-        if (_cmd->_ignoreCase)
-            buf += _T(" -i");
-        else
-            buf += _T(" -M");
-
-        if (!_cmd->_regExp)
-            buf += _T(" --literal");
-    }
-}
-
-
-/**
- *  \brief
- */
-void CmdEngine::setEnvironmentVars() const
-{
-    CText buf;
-
-    if (!_cmd->_skipLibs && (_cmd->_id == AUTOCOMPLETE || _cmd->_id == FIND_DEFINITION))
-    {
-        const DbConfig& cfg = _cmd->Db()->GetConfig();
-        if (cfg._useLibDb && cfg._libDbPaths.size())
-        {
-            if (!cfg._libDbPaths[0].IsSubpathOf(_cmd->Db()->GetPath()))
-                buf += cfg._libDbPaths[0];
-
-            for (size_t i = 1; i < cfg._libDbPaths.size(); ++i)
-            {
-                if (!cfg._libDbPaths[i].IsSubpathOf(_cmd->Db()->GetPath()))
-                {
-                    buf += _T(';');
-                    buf += cfg._libDbPaths[i];
-                }
-            }
-        }
-    }
-
-    if (_cmd->Db())
-        SetEnvironmentVariable(_T("GTAGSDBPATH"), _cmd->Db()->GetPath().C_str());
-
-    SetEnvironmentVariable(_T("GTAGSLIBPATH"), buf.C_str());
-}
-
-
-/**
- *  \brief
- */
-bool CmdEngine::runProcess(PROCESS_INFORMATION& pi, ReadPipe& dataPipe, ReadPipe& errorPipe)
-{
-    const DWORD createFlags = NORMAL_PRIORITY_CLASS | CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT;
-    const TCHAR* currentDir = (_cmd->_id == VERSION || _cmd->_id == CTAGS_VERSION) ?
-            NULL : _cmd->Db()->GetPath().C_str();
-
-    CText cmdBuf;
-    composeCmd(cmdBuf);
-
-    setEnvironmentVars();
-
-    STARTUPINFO si  = {0};
-    si.cb           = sizeof(si);
-    si.dwFlags      = STARTF_USESTDHANDLES;
-    si.hStdError    = errorPipe.GetInputHandle();
-    si.hStdOutput   = dataPipe.GetInputHandle();
-
-    if (!CreateProcess(NULL, cmdBuf.C_str(), NULL, NULL, TRUE, createFlags, NULL, currentDir, &si, &pi))
-    {
-        _cmd->_status = RUN_ERROR;
-        return false;
-    }
-
-    SetThreadPriority(pi.hThread, THREAD_PRIORITY_NORMAL);
-
-    if (!errorPipe.Open() || !dataPipe.Open())
-    {
-        endProcess(pi);
-        _cmd->_status = RUN_ERROR;
-        return false;
-    }
-
-    return true;
-}
-
-
-/**
- *  \brief
- */
-void CmdEngine::endProcess(PROCESS_INFORMATION& pi)
-{
-    DWORD r;
-    GetExitCodeProcess(pi.hProcess, &r);
-    if (r == STILL_ACTIVE)
-        TerminateProcess(pi.hProcess, 0);
-
-    CloseHandle(pi.hThread);
-    CloseHandle(pi.hProcess);
-}
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags command execution engine
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <process.h>
+#include "Common.h"
+#include "INpp.h"
+#include "Config.h"
+#include "GTags.h"
+#include "ReadPipe.h"
+#include "ActivityWin.h"
+#include "CmdEngine.h"
+#include "Cmd.h"
+#include "CmdTiming.h"
+#include "Tracer.h"
+
+#ifdef DEVEL
+#include "CmdCapture.h"
+#endif
+
+
+namespace GTags
+{
+
+MpscQueue<CmdEngine::Event> CmdEngine::Events;
+bool                        CmdEngine::InCallback = false;
+
+
+const TCHAR* CmdEngine::CmdLine[] = {
+    _T("\"%s\\gtags.exe\" -c --skip-unreadable"),                           // CREATE_DATABASE
+    _T("\"%s\\gtags.exe\" -c --skip-unreadable --single-update \"%s\""),    // UPDATE_SINGLE
+    _T("\"%s\\global.exe\" -cT \"%s\""),                                    // AUTOCOMPLETE
+    _T("\"%s\\global.exe\" -cs \"%s\""),                                    // AUTOCOMPLETE_SYMBOL
+    _T("\"%s\\global.exe\" -cPo --match-part=all \"%s\""),                  // AUTOCOMPLETE_FILE
+    _T("\"%s\\global.exe\" -Po \"%s\""),                                    // FIND_FILE
+    _T("\"%s\\global.exe\" -dT --result=grep --path-style=abslib \"%s\""),  // FIND_DEFINITION
+    _T("\"%s\\global.exe\" -r --result=grep \"%s\""),                       // FIND_REFERENCE
+    _T("\"%s\\global.exe\" -s --result=grep \"%s\""),                       // FIND_SYMBOL
+    _T("\"%s\\global.exe\" -g --result=grep \"%s\""),                       // GREP
+    _T("\"%s\\global.exe\" -gO --result=grep \"%s\""),                      // GREP_TEXT
+    _T("\"%s\\global.exe\" --version"),                                     // VERSION
+    _T("\"%s\\ctags.exe\" --version")                                       // CTAGS_VERSION
+};
+
+
+const TCHAR CmdEngine::cListFilesCmdLine[] = _T("\"%s\\global.exe\" -Po");
+
+
+/**
+ *  \brief
+ */
+bool CmdEngine::Run(const CmdPtr_t& cmd, CompletionCB complCB)
+{
+    if (!complCB)
+        return false;
+
+    CmdEngine* engine = new CmdEngine(cmd, complCB);
+    cmd->Status(RUN_ERROR);
+    cmd->_timing = std::make_shared<CmdTiming>(cmd->Id(), cmd->Tag());
+
+    // Command chained from another command's completion callback
+    if (InCallback && Tracer::IsOn())
+    {
+        engine->_chainFlowId = Tracer::NewFlowId();
+        Tracer::FlowStart("chain", engine->_chainFlowId);
+    }
+
+    engine->_hThread = (HANDLE)_beginthreadex(NULL, 0, threadFunc, engine, 0, NULL);
+    if (engine->_hThread == NULL)
+    {
+        delete engine;
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief  Handles the queued worker threads events - called in the UI thread
+ */
+void CmdEngine::ProcessEvents()
+{
+    std::vector<Event> events;
+    Events.PopAll(events);
+
+    // Handle Activity Window events first - completion callbacks might open modal windows and their message loop
+    // could process further events out of order otherwise
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        Event& ev = events[i];
+
+        if (ev._type == Event::OPEN_ACTIVITY_WIN)
+        {
+            bool closed = false;
+
+            // Don't bother showing the window if it is going to be closed right away
+            for (size_t j = i + 1; j < events.size(); ++j)
+            {
+                if (events[j]._type == Event::CLOSE_ACTIVITY_WIN && events[j]._hCancel == ev._hCancel)
+                {
+                    closed = true;
+                    break;
+                }
+            }
+
+            if (!closed)
+                ActivityWin::Show(ev._header.C_str(), ev._hCancel);
+        }
+        else if (ev._type == Event::CLOSE_ACTIVITY_WIN)
+        {
+            HWND hActivityWin = ActivityWin::GetHwnd(ev._hCancel);
+
+            if (hActivityWin)
+                SendMessage(hActivityWin, WM_CLOSE, 0, 0);
+
+            // The cancel event is owned by the UI thread once posted - the worker doesn't wait on it anymore
+            CloseHandle(ev._hCancel);
+        }
+    }
+
+    for (const auto& ev : events)
+    {
+        if (ev._type == Event::CMD_DONE && ev._complCB && ev._cmd)
+        {
+            // Keep the timing of this run - a callback may re-run the same command
+            CmdTimingPtr_t timing = ev._cmd->Timing();
+
+            if (timing)
+            {
+                timing->_status = ev._cmd->Status();
+                CmdTimingLog::Add(timing);
+            }
+
+            const LONGLONG cbStart = CmdTiming::Now();
+
+            // Callbacks might be nested through modal windows message loops
+            const bool wasInCallback = InCallback;
+
+            InCallback = true;
+            ev._complCB(ev._cmd);
+            InCallback = wasInCallback;
+
+            if (Tracer::IsOn())
+            {
+                CTextA name("callback: ");
+                name += ev._cmd->Name();
+
+                Tracer::FlowEnd("completion", ev._flowId, cbStart);
+                Tracer::Complete(name.C_str(), "ui", cbStart, CmdTiming::Now(),
+                        Tracer::Arg("status", CmdTiming::StatusName[ev._cmd->Status()]));
+            }
+        }
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void CmdEngine::postEvent(Event&& ev)
+{
+    // Wake up the UI thread only once per batch of events
+    if (Events.Push(std::move(ev)))
+        PostMessage(MainWndH, WM_CMD_ENGINE_EVENTS, 0, 0);
+}
+
+
+/**
+ *  \brief
+ */
+CmdEngine::CmdEngine(const CmdPtr_t& cmd, CompletionCB complCB) :
+    _cmd(cmd), _complCB(complCB), _hThread(NULL), _chainFlowId(0), _complFlowId(0), _listFiles(false)
+{
+}
+
+
+/**
+ *  \brief
+ */
+CmdEngine::~CmdEngine()
+{
+    postEvent(Event(_cmd, _complCB, _complFlowId));
+
+    if (_hThread)
+        CloseHandle(_hThread);
+}
+
+
+/**
+ *  \brief
+ */
+unsigned __stdcall CmdEngine::threadFunc(void* data)
+{
+    CmdEngine* engine = static_cast<CmdEngine*>(data);
+
+    const LONGLONG start = CmdTiming::Now();
+
+    if (Tracer::IsOn())
+    {
+        Tracer::ThreadName("CmdEngine");
+        Tracer::FlowEnd("chain", engine->_chainFlowId, start);
+    }
+
+    unsigned r = engine->start();
+
+    engine->trace(start);
+
+    delete engine;
+
+    return r;
+}
+
+
+/**
+ *  \brief
+ */
+unsigned CmdEngine::start()
+{
+    if (usePathIndex())
+    {
+        if (queryPathIndex())
+            return parseResult();
+
+        // Run global to list all database files instead and answer from the index loaded from them
+        _listFiles = true;
+    }
+
+    ReadPipe dataPipe;
+    ReadPipe errorPipe;
+
+    PROCESS_INFORMATION pi;
+
+    if (!runProcess(pi, dataPipe, errorPipe))
+        return 1;
+
+    // Signaled when results limit is reached - the process is not waited to finish then
+    HANDLE hLimit = dataPipe.GetLimitEvent();
+
+    bool showActivityWin = true;
+    if (_cmd->_id != CREATE_DATABASE && _cmd->_id != UPDATE_SINGLE)
+    {
+        HANDLE waitHandles[] = {pi.hProcess, hLimit};
+
+        // Wait 300 ms and if process has finished don't show Activity Window
+        const DWORD r = WaitForMultipleObjects(hLimit ? 2 : 1, waitHandles, FALSE, 300);
+        if (r == WAIT_OBJECT_0 || r == WAIT_OBJECT_0 + 1)
+            showActivityWin = false;
+    }
+
+    if (showActivityWin)
+    {
+        HANDLE hCancel = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+        if (hCancel)
+        {
+            CText header(_cmd->Name());
+
+            if (_cmd->_id != VERSION && _cmd->_id != CTAGS_VERSION)
+            {
+                header += _T(" - \"");
+                if (_cmd->_id == CREATE_DATABASE)
+                    header += _cmd->Db()->GetPath();
+                else
+                    header += _cmd->Tag();
+                header += _T('\"');
+            }
+
+            Event openEv(Event::OPEN_ACTIVITY_WIN, hCancel);
+            openEv._header = header;
+            postEvent(std::move(openEv));
+
+            HANDLE waitHandles[] = {pi.hProcess, hCancel, hLimit};
+            DWORD handleId = WaitForMultipleObjects(hLimit ? 3 : 2, waitHandles, FALSE, INFINITE) - WAIT_OBJECT_0;
+            if (handleId > 0 && handleId < 2 && waitHandles[handleId] == hCancel)
+                _cmd->_status = CANCELLED;
+
+            // hCancel is closed by the UI thread after the Activity Window is gone
+            postEvent(Event(Event::CLOSE_ACTIVITY_WIN, hCancel));
+        }
+        else
+        {
+            HANDLE waitHandles[] = {pi.hProcess, hLimit};
+            WaitForMultipleObjects(hLimit ? 2 : 1, waitHandles, FALSE, INFINITE);
+        }
+    }
+
+    CmdTiming& timing = *_cmd->_timing;
+    timing.Mark(CmdTiming::EXIT);
+
+    endProcess(pi);
+
+    if (_cmd->_status == CANCELLED)
+        return 1;
+
+    timing._outputLen = dataPipe.GetOutputLen();
+    timing.Mark(CmdTiming::FIRST_BYTE, dataPipe.GetFirstReadTime());
+    timing.Mark(CmdTiming::LAST_BYTE, dataPipe.GetLastReadTime());
+
+#ifdef DEVEL
+    if (!_captureDir.IsEmpty())
+    {
+        // Waits the error pipe reader to finish as well
+        errorPipe.GetOutputLen();
+        CmdCapture::Save(_captureDir, _captureCmd, dataPipe, errorPipe,
+                timing.Stamp(CmdTiming::SPAWN), timing.Stamp(CmdTiming::EXIT));
+    }
+#endif
+
+    if (dataPipe.GetOutputLen())
+    {
+        ReadPipe::Output output;
+        dataPipe.MoveOutput(output);
+
+        _cmd->AppendToResult(std::move(output));
+        _cmd->_truncated = dataPipe.IsLimitReached();
+    }
+    else if (errorPipe.GetOutputLen())
+    {
+        if (_cmd->_id != CREATE_DATABASE && _cmd->_id != UPDATE_SINGLE)
+        {
+            std::vector<char> output;
+            errorPipe.MoveOutput(output);
+
+            _cmd->SetResult(std::move(output));
+            _cmd->_status = FAILED;
+            return 1;
+        }
+
+        if (_cmd->_id == CREATE_DATABASE)
+        {
+            std::vector<char> output;
+            errorPipe.MoveOutput(output);
+
+            _cmd->SetResult(std::move(output));
+        }
+    }
+
+    if (_listFiles)
+    {
+        // Straight from the output chunks - the files list is never gathered into one buffer
+        _cmd->Db()->Paths().Load([this](const auto& addLine) { _cmd->ForEachResultLine(addLine); });
+        queryPathIndex();
+    }
+    else if (_cmd->_id == UPDATE_SINGLE)
+    {
+        updatePathIndex();
+    }
+
+    return parseResult();
+}
+
+
+/**
+ *  \brief
+ */
+unsigned CmdEngine::parseResult()
+{
+    CmdTiming& timing = *_cmd->_timing;
+
+    _cmd->_status = OK;
+
+    if (_cmd->_parser)
+    {
+        if (_cmd->HasResult())
+        {
+            const LONGLONG parseStart = CmdTiming::Now();
+            const intptr_t parsedEntries = _cmd->_parser->Parse(_cmd);
+
+            timing.Mark(CmdTiming::PARSE);
+            Tracer::Complete("parse", "engine", parseStart, timing.Stamp(CmdTiming::PARSE),
+                    Tracer::Arg("entries", (long long)parsedEntries));
+
+            if (parsedEntries < 0)
+            {
+                _cmd->_status = PARSE_ERROR;
+                return 1;
+            }
+            else if (parsedEntries == 0)
+            {
+                _cmd->_status = PARSE_EMPTY; // No results to display actually (due to some filtering)
+                return 1;
+            }
+        }
+        // Blink the auto-complete word to inform the user if nothing is found
+        else if (_cmd->_id == AUTOCOMPLETE_FILE ||
+                ((_cmd->_id == AUTOCOMPLETE || _cmd->_id == AUTOCOMPLETE_SYMBOL) && !_cmd->_autorun))
+        {
+            CTextA wordA;
+            INpp::Get().GetWord(wordA, true, true);
+
+            if (wordA.Len())
+            {
+                CText word(wordA.C_str());
+
+                TCHAR* tag = _cmd->_tag.C_str();
+                size_t len = _cmd->_tag.Len();
+                if (_cmd->_id == AUTOCOMPLETE_FILE)
+                {
+                    ++tag;
+                    --len;
+                }
+
+                if (!_tcsncmp(word.C_str(), tag, len))
+                    Sleep(50);
+            }
+        }
+    }
+
+    if (_cmd->_id == CREATE_DATABASE)
+        _cmd->Db()->SaveCfg();
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Literal file searches are answered from the database files list
+ */
+bool CmdEngine::usePathIndex() const
+{
+    return ((_cmd->_id == FIND_FILE || _cmd->_id == AUTOCOMPLETE_FILE) && !_cmd->_regExp && _cmd->Db());
+}
+
+
+/**
+ *  \brief  Sets the command result as global would - returns false if the index is not loaded yet
+ */
+bool CmdEngine::queryPathIndex()
+{
+    const LONGLONG lookupStart = CmdTiming::Now();
+
+    const PathIndex& paths = _cmd->Db()->Paths();
+    const CTextA tag(_cmd->_tag.C_str());
+
+    std::vector<char> output;
+    bool truncated = false;
+
+    if (_cmd->_id == FIND_FILE)
+    {
+        const unsigned limit = (GTagsSettings._resultsLimit > 0) ? (unsigned)GTagsSettings._resultsLimit : 0;
+
+        if (!paths.FindFiles(tag.C_str(), _cmd->_ignoreCase, _cmd->_linesOffset, limit, output, truncated))
+            return false;
+    }
+    // The completion tag starts with '/' to match only whole path parts
+    else if (!paths.CompleteFiles(tag.C_str() + (tag.Len() ? 1 : 0), _cmd->_ignoreCase, output))
+    {
+        return false;
+    }
+
+    _cmd->SetResult(std::move(output));
+    _cmd->_truncated = truncated;
+    _cmd->_timing->_outputLen = _cmd->ResultLen();
+
+    Tracer::Complete("path index", "engine", lookupStart, CmdTiming::Now(),
+            Tracer::Arg("bytes", (long long)_cmd->_timing->_outputLen));
+
+    return true;
+}
+
+
+/**
+ *  \brief  Keeps the database files list up to date after a single file update - the file might have been
+ *          created, renamed or deleted. A new file is added only if GTags indexed it (it is not skipped by
+ *          gtags.conf, binary or unreadable) and it is not under the ignored sub-paths
+ */
+void CmdEngine::updatePathIndex()
+{
+    PathIndex& paths = _cmd->Db()->Paths();
+    const CPath& dbPath = _cmd->Db()->GetPath();
+
+    // Loaded by the next file search otherwise
+    if (!paths.IsLoaded() || _cmd->Tag().Len() <= dbPath.Len())
+        return;
+
+    CTextA file(_cmd->Tag().C_str() + dbPath.Len());
+
+    for (char* pChar = file.C_str(); *pChar; ++pChar)
+        if (*pChar == '\\')
+            *pChar = '/';
+
+    if (!CPath(_cmd->Tag().C_str()).FileExists())
+    {
+        paths.Update(file.C_str(), false);
+        return;
+    }
+
+    if (paths.HasFile(file.C_str()))
+        return;
+
+    const CText relPath(file.C_str());
+
+    for (const TCHAR* pChar = relPath.C_str(); *pChar; ++pChar)
+    {
+        if (_tcschr(_T("\\^$.|?*+()[]{}"), *pChar))
+            _checkFile += _T('\\');
+        _checkFile += *pChar;
+    }
+
+    ReadPipe dataPipe;
+    ReadPipe errorPipe;
+
+    PROCESS_INFORMATION pi;
+
+    const bool started = runProcess(pi, dataPipe, errorPipe);
+
+    _checkFile.Clear();
+
+    // The list can't be kept up to date - load it again on the next file search
+    if (!started)
+    {
+        paths.Clear();
+        return;
+    }
+
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    endProcess(pi);
+
+    std::vector<char> output;
+    dataPipe.MoveOutput(output);
+
+    const DbConfig& cfg = _cmd->Db()->GetConfig();
+    bool indexed = false;
+
+    // The regexp matches other paths as well - look for the exact one
+    for (char* pLine = output.data(); pLine && *pLine && !indexed;)
+    {
+        char* pEol = pLine + strcspn(pLine, "\r\n");
+        const char* pPath = (pLine[0] == '.' && pLine[1] == '/') ? pLine + 2 : pLine;
+
+        if ((size_t)(pEol - pPath) == file.Len() && !strncmp(pPath, file.C_str(), file.Len()))
+        {
+            indexed = true;
+
+            // The same check as the file search results filtering
+            if (cfg._usePathFilter)
+            {
+                CPath entry;
+                entry.Append(pLine, pEol - pLine);
+
+                for (const auto& filter : cfg._pathFilters)
+                {
+                    if (filter.IsParentOf(entry))
+                    {
+                        indexed = false;
+                        break;
+                    }
+                }
+            }
+
+            break;
+        }
+
+        pLine = pEol + strspn(pEol, "\r\n");
+    }
+
+    paths.Update(file.C_str(), indexed);
+}
+
+
+/**
+ *  \brief
+ */
+void CmdEngine::composeCmd(CText& buf) const
+{
+    CPath path(DllPath);
+    path.StripFilename();
+    path += cBinariesFolder;
+
+#ifdef DEVEL
+    if (CmdCapture::GetBinariesDir(path))
+        path.Erase(path.Len() - 1, 1);
+#endif
+
+    buf.Resize(2048);
+
+    if (_listFiles)
+    {
+        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, cListFilesCmdLine, path.C_str());
+        return;
+    }
+
+    if (!_checkFile.IsEmpty())
+    {
+        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, CmdLine[FIND_FILE], path.C_str(), _checkFile.C_str());
+        return;
+    }
+
+    if (_cmd->_id == CREATE_DATABASE || _cmd->_id == VERSION || _cmd->_id == CTAGS_VERSION)
+        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, CmdLine[_cmd->_id], path.C_str());
+    else
+        _sntprintf_s(buf.C_str(), buf.Size(), _TRUNCATE, CmdLine[_cmd->_id], path.C_str(),
+                _cmd->Tag().C_str());
+
+    if (_cmd->_id == CREATE_DATABASE || _cmd->_id == UPDATE_SINGLE)
+    {
+        path += _T("\\gtags.conf");
+        if (path.FileExists())
+        {
+            buf += _T(" --gtagsconf \"");
+            buf += path;
+            buf += _T("\"");
+            buf += _T(" --gtagslabel=");
+            buf += _cmd->Db()->GetConfig().Parser();
+        }
+    }
+    else if (_cmd->_id != VERSION && _cmd->_id != CTAGS_VERSION)
+    {
+        if (_cmd->_ignoreCase)
+            buf += _T(" -i");
+        else
+            buf += _T(" -M");
+
+        if (!_cmd->_regExp)
+            buf += _T(" --literal");
+
+        // Results only under the current folder with paths still relative to the database root
+        if (!_cmd->_localDir.IsEmpty())
+            buf += _T(" -l --path-style=through");
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void CmdEngine::setEnvironmentVars() const
+{
+    CText buf;
+
+    if (!_cmd->_skipLibs && (_cmd->_id == AUTOCOMPLETE || _cmd->_id == FIND_DEFINITION))
+    {
+        const DbConfig& cfg = _cmd->Db()->GetConfig();
+        if (cfg._useLibDb && cfg._libDbPaths.size())
+        {
+            if (!cfg._libDbPaths[0].IsSubpathOf(_cmd->Db()->GetPath()))
+                buf += cfg._libDbPaths[0];
+
+            for (size_t i = 1; i < cfg._libDbPaths.size(); ++i)
+            {
+                if (!cfg._libDbPaths[i].IsSubpathOf(_cmd->Db()->GetPath()))
+                {
+                    buf += _T(';');
+                    buf += cfg._libDbPaths[i];
+                }
+            }
+        }
+    }
+
+    if (_cmd->Db())
+        SetEnvironmentVariable(_T("GTAGSDBPATH"), _cmd->Db()->GetPath().C_str());
+
+    SetEnvironmentVariable(_T("GTAGSLIBPATH"), buf.C_str());
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdEngine::runProcess(PROCESS_INFORMATION& pi, ReadPipe& dataPipe, ReadPipe& errorPipe)
+{
+    const DWORD createFlags = NORMAL_PRIORITY_CLASS | CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT;
+    const TCHAR* currentDir = (_cmd->_id == VERSION || _cmd->_id == CTAGS_VERSION) ? NULL :
+            (_cmd->_localDir.IsEmpty() ? _cmd->Db()->GetPath().C_str() : _cmd->_localDir.C_str());
+
+    CText cmdBuf;
+    composeCmd(cmdBuf);
+
+    setEnvironmentVars();
+
+    if (!_listFiles && (_cmd->_id == FIND_FILE || _cmd->_id == FIND_DEFINITION || _cmd->_id == FIND_REFERENCE ||
+        _cmd->_id == FIND_SYMBOL || _cmd->_id == GREP || _cmd->_id == GREP_TEXT))
+    {
+        // Single file re-queries need all results of the file
+        if ((_cmd->_linesOffset || GTagsSettings._resultsLimit > 0) && _cmd->_localDir.IsEmpty())
+            dataPipe.SetLinesLimit(_cmd->_linesOffset, (unsigned)GTagsSettings._resultsLimit);
+
+        // Bound the in-flight output - the rest can be loaded on demand like with the results limit
+        if (GTagsSettings._resultsBytesLimit > 0 && _cmd->_localDir.IsEmpty())
+            dataPipe.SetBytesLimit((size_t)GTagsSettings._resultsBytesLimit << 20);
+    }
+
+#ifdef DEVEL
+    if (replayProcess(pi, cmdBuf, dataPipe, errorPipe))
+    {
+        if (_checkFile.IsEmpty())
+            _cmd->_timing->Mark(CmdTiming::SPAWN);
+
+        if (!errorPipe.Open() || !dataPipe.Open())
+        {
+            endProcess(pi);
+            _cmd->_status = RUN_ERROR;
+            return false;
+        }
+
+        return true;
+    }
+
+    if (CmdCapture::GetCaptureDir(_captureDir))
+    {
+        _captureCmd = cmdBuf;
+        dataPipe.EnableCapture();
+        errorPipe.EnableCapture();
+    }
+    else
+    {
+        _captureDir.Clear();
+    }
+#endif
+
+    STARTUPINFO si  = {0};
+    si.cb           = sizeof(si);
+    si.dwFlags      = STARTF_USESTDHANDLES;
+    si.hStdError    = errorPipe.GetInputHandle();
+    si.hStdOutput   = dataPipe.GetInputHandle();
+
+    if (!CreateProcess(NULL, cmdBuf.C_str(), NULL, NULL, TRUE, createFlags, NULL, currentDir, &si, &pi))
+    {
+        _cmd->_status = RUN_ERROR;
+        return false;
+    }
+
+    SetThreadPriority(pi.hThread, THREAD_PRIORITY_NORMAL);
+
+    // The updated file check is timed as part of the update
+    if (_checkFile.IsEmpty())
+        _cmd->_timing->Mark(CmdTiming::SPAWN);
+
+    if (!errorPipe.Open() || !dataPipe.Open())
+    {
+        endProcess(pi);
+        _cmd->_status = RUN_ERROR;
+        return false;
+    }
+
+    return true;
+}
+
+
+#ifdef DEVEL
+/**
+ *  \brief  Feeds the pipes with a fake or a captured output instead of running the command if requested
+ */
+bool CmdEngine::replayProcess(PROCESS_INFORMATION& pi, const CText& cmdBuf, ReadPipe& dataPipe,
+        ReadPipe& errorPipe)
+{
+    CmdCapture::FakeSpec spec;
+    const bool fake = CmdCapture::GetFakeSpec(spec);
+
+    if (!fake && !CmdCapture::GetReplayDir(_captureDir))
+        return false;
+
+    HANDLE hDataIn, hErrorIn;
+    const HANDLE hSelf = GetCurrentProcess();
+    bool started = false;
+
+    if (DuplicateHandle(hSelf, dataPipe.GetInputHandle(), hSelf, &hDataIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+    {
+        if (DuplicateHandle(hSelf, errorPipe.GetInputHandle(), hSelf, &hErrorIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+        {
+            // Commands without a capture are run normally
+            if (fake)
+                started = CmdCapture::StartFake(spec, _cmd->_id, _cmd->Tag(), hDataIn, hErrorIn, pi);
+            else
+                started = CmdCapture::StartReplay(_captureDir, cmdBuf, hDataIn, hErrorIn, pi);
+
+            if (!started)
+                CloseHandle(hErrorIn);
+        }
+
+        if (!started)
+            CloseHandle(hDataIn);
+    }
+
+    _captureDir.Clear();
+
+    return started;
+}
+#endif
+
+
+/**
+ *  \brief
+ */
+void CmdEngine::endProcess(PROCESS_INFORMATION& pi)
+{
+#ifdef DEVEL
+    if (CmdCapture::IsReplay(pi))
+    {
+        CmdCapture::EndReplay(pi);
+        return;
+    }
+#endif
+
+    DWORD r;
+    GetExitCodeProcess(pi.hProcess, &r);
+    if (r == STILL_ACTIVE)
+        TerminateProcess(pi.hProcess, 0);
+
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+}
+
+
+/**
+ *  \brief  Records the command run in the trace - called at the end of the engine thread
+ */
+void CmdEngine::trace(LONGLONG start)
+{
+    if (!Tracer::IsOn())
+        return;
+
+    const CmdTiming& timing = *_cmd->_timing;
+
+    std::string args = Tracer::Arg("search", _cmd->Tag().C_str());
+    args += ",";
+    args += Tracer::Arg("status", CmdTiming::StatusName[_cmd->_status]);
+    args += ",";
+    args += Tracer::Arg("output_bytes", (long long)timing._outputLen);
+
+    Tracer::Complete("spawn", "engine", start, timing.Stamp(CmdTiming::SPAWN));
+    Tracer::Complete("process", "engine", timing.Stamp(CmdTiming::SPAWN), timing.Stamp(CmdTiming::EXIT));
+
+    _complFlowId = Tracer::NewFlowId();
+    Tracer::FlowStart("completion", _complFlowId);
+
+    CTextA name(_cmd->Name());
+    Tracer::Complete(name.C_str(), "engine", start, CmdTiming::Now(), args);
+}
+
+} // namespace GTags
@@ -1,69 +1,121 @@
-/**
- *  \file
- *  \brief  GTags command execution engine
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2022 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <windows.h>
-#include <tchar.h>
-#include "Common.h"
-#include "CmdDefines.h"
-
-
-class ReadPipe;
-
-
-namespace GTags
-{
-
-/**
- *  \class  CmdEngine
- *  \brief
- */
-class CmdEngine
-{
-public:
-    static bool Run(const CmdPtr_t& cmd, CompletionCB complCB);
-
-private:
-    static const TCHAR* CmdLine[];
-
-    static unsigned __stdcall threadFunc(void* data);
-
-    CmdEngine(const CmdPtr_t& cmd, CompletionCB complCB);
-    ~CmdEngine();
-    CmdEngine& operator=(const CmdEngine&) = delete;
-
-    unsigned start();
-    void composeCmd(CText& buf) const;
-    void setEnvironmentVars() const;
-    bool runProcess(PROCESS_INFORMATION& pi, ReadPipe& dataPipe, ReadPipe& errorPipe);
-    void endProcess(PROCESS_INFORMATION& pi);
-
-    CmdPtr_t            _cmd;
-    CompletionCB const  _complCB;
-    HANDLE              _hThread;
-};
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags command execution engine
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <vector>
+#include "Common.h"
+#include "CmdDefines.h"
+#include "MpscQueue.h"
+
+
+class ReadPipe;
+
+
+namespace GTags
+{
+
+/**
+ *  \class  CmdEngine
+ *  \brief
+ */
+class CmdEngine
+{
+public:
+    static bool Run(const CmdPtr_t& cmd, CompletionCB complCB);
+    static void ProcessEvents();
+
+private:
+    /**
+     *  \struct  Event
+     *  \brief  Worker thread notification to be handled in the UI thread
+     */
+    struct Event
+    {
+        enum Type_t
+        {
+            CMD_DONE,
+            OPEN_ACTIVITY_WIN,
+            CLOSE_ACTIVITY_WIN
+        };
+
+        Event(Type_t type, HANDLE hCancel) : _type(type), _complCB(NULL), _hCancel(hCancel), _flowId(0) {}
+        Event(const CmdPtr_t& cmd, CompletionCB complCB, unsigned flowId) :
+            _type(CMD_DONE), _cmd(cmd), _complCB(complCB), _hCancel(NULL), _flowId(flowId) {}
+
+        Type_t          _type;
+        CmdPtr_t        _cmd;
+        CompletionCB    _complCB;
+        HANDLE          _hCancel;
+        CText           _header;
+        unsigned        _flowId; // Trace flow from the engine thread to the completion callback
+    };
+
+    static MpscQueue<Event> Events;
+    static bool             InCallback;
+
+    static void postEvent(Event&& ev);
+
+    static const TCHAR* CmdLine[];
+    static const TCHAR  cListFilesCmdLine[];
+
+    static unsigned __stdcall threadFunc(void* data);
+
+    CmdEngine(const CmdPtr_t& cmd, CompletionCB complCB);
+    ~CmdEngine();
+    CmdEngine& operator=(const CmdEngine&) = delete;
+
+    unsigned start();
+    unsigned parseResult();
+    bool usePathIndex() const;
+    bool queryPathIndex();
+    void updatePathIndex();
+    void composeCmd(CText& buf) const;
+    void setEnvironmentVars() const;
+    bool runProcess(PROCESS_INFORMATION& pi, ReadPipe& dataPipe, ReadPipe& errorPipe);
+#ifdef DEVEL
+    bool replayProcess(PROCESS_INFORMATION& pi, const CText& cmdBuf, ReadPipe& dataPipe, ReadPipe& errorPipe);
+#endif
+    void endProcess(PROCESS_INFORMATION& pi);
+    void trace(LONGLONG start);
+
+    CmdPtr_t            _cmd;
+    CompletionCB const  _complCB;
+    HANDLE              _hThread;
+
+    unsigned            _chainFlowId; // Trace flow from the completion callback that started this command
+    unsigned            _complFlowId;
+    bool                _listFiles; // Run global to load the database path index
+    CText               _checkFile; // Run global to find out if this updated file is indexed - a regexp
+
+#ifdef DEVEL
+    CPath               _captureDir; // Set if the command output is to be captured
+    CText               _captureCmd;
+#endif
+};
+
+} // namespace GTags
@@ -0,0 +1,399 @@
+/**
+ *  \file
+ *  \brief  GTags command execution stages timing
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CmdTiming.h"
+#include <cstdio>
+#include <string>
+#include <algorithm>
+#include "INpp.h"
+
+
+namespace
+{
+
+/**
+ *  \brief
+ */
+void appendTime(CTextA& txt, double ms, const char* nullTxt)
+{
+    if (ms < 0)
+    {
+        txt += nullTxt;
+        return;
+    }
+
+    char buf[32];
+    _snprintf_s(buf, _countof(buf), _TRUNCATE, "%.3f", ms);
+    txt += buf;
+}
+
+
+/**
+ *  \brief
+ */
+void appendStartTime(CTextA& txt, const SYSTEMTIME& time)
+{
+    char buf[32];
+    _snprintf_s(buf, _countof(buf), _TRUNCATE, "%02u:%02u:%02u.%03u",
+            time.wHour, time.wMinute, time.wSecond, time.wMilliseconds);
+    txt += buf;
+}
+
+
+/**
+ *  \brief
+ */
+void appendCSVField(CTextA& txt, const char* str)
+{
+    txt += '"';
+
+    for (; *str; ++str)
+    {
+        if (*str == '"')
+            txt += '"';
+        txt += *str;
+    }
+
+    txt += '"';
+}
+
+
+/**
+ *  \brief
+ */
+void appendJSONString(CTextA& txt, const char* str)
+{
+    txt += '"';
+
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            txt += '\\';
+        txt += *str;
+    }
+
+    txt += '"';
+}
+
+} // anonymous namespace
+
+
+namespace GTags
+{
+
+const char* CmdTiming::CmdIdName[] = {
+    "CREATE_DATABASE",
+    "UPDATE_SINGLE",
+    "AUTOCOMPLETE",
+    "AUTOCOMPLETE_SYMBOL",
+    "AUTOCOMPLETE_FILE",
+    "FIND_FILE",
+    "FIND_DEFINITION",
+    "FIND_REFERENCE",
+    "FIND_SYMBOL",
+    "GREP",
+    "GREP_TEXT",
+    "VERSION",
+    "CTAGS_VERSION"
+};
+
+
+const char* CmdTiming::StatusName[] = {
+    "CANCELLED",
+    "RUN_ERROR",
+    "FAILED",
+    "PARSE_ERROR",
+    "PARSE_EMPTY",
+    "OK"
+};
+
+
+const char* CmdTiming::StageName[] = {
+    "spawn",
+    "first_byte",
+    "last_byte",
+    "exit",
+    "parse",
+    "ui_load",
+    "first_paint"
+};
+
+
+const size_t CmdTimingLog::cMaxRecords             = 100;
+const size_t CmdTimingLog::cMaxKeyToPopupSamples   = 1000;
+
+
+std::vector<CmdTimingPtr_t> CmdTimingLog::Records;
+size_t                      CmdTimingLog::Next = 0;
+
+std::vector<double>         CmdTimingLog::KeyToPopup;
+size_t                      CmdTimingLog::NextKeyToPopup = 0;
+
+
+/**
+ *  \brief
+ */
+LONGLONG CmdTiming::Now()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    return now.QuadPart;
+}
+
+
+/**
+ *  \brief
+ */
+CmdTiming::CmdTiming(CmdId_t id, const CText& tag) :
+    _id(id), _status(RUN_ERROR), _tag(tag.C_str()), _outputLen(0), _start(Now())
+{
+    GetLocalTime(&_startTime);
+
+    for (auto& stage : _stages)
+        stage = 0;
+}
+
+
+/**
+ *  \brief
+ */
+double CmdTiming::ToMs(LONGLONG ticks)
+{
+    static LONGLONG freq = 0;
+
+    if (!freq)
+    {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        freq = f.QuadPart;
+    }
+
+    return (double)ticks * 1000.0 / (double)freq;
+}
+
+
+/**
+ *  \brief
+ */
+double CmdTiming::Elapsed(Stage_t stage) const
+{
+    if (!_stages[stage])
+        return -1.0;
+
+    return ToMs(_stages[stage] - _start);
+}
+
+
+/**
+ *  \brief
+ */
+void CmdTimingLog::Add(const CmdTimingPtr_t& timing)
+{
+    if (!timing)
+        return;
+
+    if (Records.size() < cMaxRecords)
+    {
+        Records.push_back(timing);
+    }
+    else
+    {
+        Records[Next] = timing;
+        Next = (Next + 1) % cMaxRecords;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void CmdTimingLog::AddKeyToPopup(double ms)
+{
+    if (KeyToPopup.size() < cMaxKeyToPopupSamples)
+    {
+        KeyToPopup.push_back(ms);
+    }
+    else
+    {
+        KeyToPopup[NextKeyToPopup] = ms;
+        NextKeyToPopup = (NextKeyToPopup + 1) % cMaxKeyToPopupSamples;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void CmdTimingLog::ShowCSV()
+{
+    CTextA txt("command,search,status,start,output_bytes");
+
+    for (const char* stage : CmdTiming::StageName)
+    {
+        txt += ",";
+        txt += stage;
+        txt += "_ms";
+    }
+
+    txt += "\r\n";
+
+    // Oldest record first
+    for (size_t i = 0; i < Records.size(); ++i)
+    {
+        const CmdTiming& rec = *Records[(Next + i) % Records.size()];
+
+        txt += CmdTiming::CmdIdName[rec._id];
+        txt += ",";
+        appendCSVField(txt, rec._tag.C_str());
+        txt += ",";
+        txt += CmdTiming::StatusName[rec._status];
+        txt += ",";
+        appendStartTime(txt, rec._startTime);
+        txt += ",";
+        txt += std::to_string(rec._outputLen).c_str();
+
+        for (int stage = 0; stage < CmdTiming::STAGES_COUNT; ++stage)
+        {
+            txt += ",";
+            appendTime(txt, rec.Elapsed(static_cast<CmdTiming::Stage_t>(stage)), "");
+        }
+
+        txt += "\r\n";
+    }
+
+    double p50, p90, p99, max;
+
+    if (keyToPopupPercentiles(p50, p90, p99, max))
+    {
+        txt += "\r\nkeystroke_to_popup,samples,p50_ms,p90_ms,p99_ms,max_ms\r\n,";
+        txt += std::to_string(KeyToPopup.size()).c_str();
+        txt += ",";
+        appendTime(txt, p50, "");
+        txt += ",";
+        appendTime(txt, p90, "");
+        txt += ",";
+        appendTime(txt, p99, "");
+        txt += ",";
+        appendTime(txt, max, "");
+        txt += "\r\n";
+    }
+
+    show(txt);
+}
+
+
+/**
+ *  \brief
+ */
+void CmdTimingLog::ShowJSON()
+{
+    CTextA txt("{\"commands\": [");
+
+    for (size_t i = 0; i < Records.size(); ++i)
+    {
+        const CmdTiming& rec = *Records[(Next + i) % Records.size()];
+
+        txt += (i ? ",\r\n  {" : "\r\n  {");
+        txt += "\"command\": \"";
+        txt += CmdTiming::CmdIdName[rec._id];
+        txt += "\", \"search\": ";
+        appendJSONString(txt, rec._tag.C_str());
+        txt += ", \"status\": \"";
+        txt += CmdTiming::StatusName[rec._status];
+        txt += "\", \"start\": \"";
+        appendStartTime(txt, rec._startTime);
+        txt += "\", \"output_bytes\": ";
+        txt += std::to_string(rec._outputLen).c_str();
+
+        for (int stage = 0; stage < CmdTiming::STAGES_COUNT; ++stage)
+        {
+            txt += ", \"";
+            txt += CmdTiming::StageName[stage];
+            txt += "_ms\": ";
+            appendTime(txt, rec.Elapsed(static_cast<CmdTiming::Stage_t>(stage)), "null");
+        }
+
+        txt += "}";
+    }
+
+    txt += (Records.empty() ? "]" : "\r\n]");
+
+    double p50, p90, p99, max;
+
+    if (keyToPopupPercentiles(p50, p90, p99, max))
+    {
+        txt += ",\r\n\"keystroke_to_popup\": {\"samples\": ";
+        txt += std::to_string(KeyToPopup.size()).c_str();
+        txt += ", \"p50_ms\": ";
+        appendTime(txt, p50, "null");
+        txt += ", \"p90_ms\": ";
+        appendTime(txt, p90, "null");
+        txt += ", \"p99_ms\": ";
+        appendTime(txt, p99, "null");
+        txt += ", \"max_ms\": ";
+        appendTime(txt, max, "null");
+        txt += "}";
+    }
+
+    txt += "}\r\n";
+
+    show(txt);
+}
+
+
+/**
+ *  \brief
+ */
+bool CmdTimingLog::keyToPopupPercentiles(double& p50, double& p90, double& p99, double& max)
+{
+    if (KeyToPopup.empty())
+        return false;
+
+    std::vector<double> sorted(KeyToPopup);
+    std::sort(sorted.begin(), sorted.end());
+
+    const size_t last = sorted.size() - 1;
+
+    p50 = sorted[last * 50 / 100];
+    p90 = sorted[last * 90 / 100];
+    p99 = sorted[last * 99 / 100];
+    max = sorted[last];
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+void CmdTimingLog::show(const CTextA& txt)
+{
+    INpp& npp = INpp::Get();
+
+    npp.NewDocument();
+    npp.SetText(txt.C_str());
+}
+
+} // namespace GTags
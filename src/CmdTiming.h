@@ -0,0 +1,119 @@
+/**
+ *  \file
+ *  \brief  GTags command execution stages timing
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <memory>
+#include <vector>
+#include "Common.h"
+#include "CmdDefines.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  CmdTiming
+ *  \brief  Timestamps of the command execution stages - each stage is marked by the thread that does it
+ */
+class CmdTiming
+{
+public:
+    enum Stage_t
+    {
+        SPAWN = 0,
+        FIRST_BYTE,
+        LAST_BYTE,
+        EXIT,
+        PARSE,
+        UI_LOAD,
+        FIRST_PAINT,
+        STAGES_COUNT
+    };
+
+    static const char* CmdIdName[];
+    static const char* StatusName[];
+    static const char* StageName[];
+
+    static LONGLONG Now();
+    static double ToMs(LONGLONG ticks);
+
+    CmdTiming(CmdId_t id, const CText& tag);
+    ~CmdTiming() {}
+
+    inline void Mark(Stage_t stage) { _stages[stage] = Now(); }
+    inline void Mark(Stage_t stage, LONGLONG time) { _stages[stage] = time; }
+    inline bool IsMarked(Stage_t stage) const { return (_stages[stage] != 0); }
+    inline LONGLONG StartStamp() const { return _start; }
+    inline LONGLONG Stamp(Stage_t stage) const { return _stages[stage]; }
+
+    // Returns the stage time in ms since the command start or negative value if the stage wasn't reached
+    double Elapsed(Stage_t stage) const;
+
+    CmdId_t         _id;
+    CmdStatus_t     _status;
+    CTextA          _tag;
+    SYSTEMTIME      _startTime;
+    size_t          _outputLen;
+
+private:
+    LONGLONG        _start;
+    LONGLONG        _stages[STAGES_COUNT];
+};
+
+
+typedef std::shared_ptr<CmdTiming> CmdTimingPtr_t;
+
+
+/**
+ *  \class  CmdTimingLog
+ *  \brief  Ring buffer of the last executed commands timings - accessed in the UI thread only
+ */
+class CmdTimingLog
+{
+public:
+    static void Add(const CmdTimingPtr_t& timing);
+    static void AddKeyToPopup(double ms);
+    static void ShowCSV();
+    static void ShowJSON();
+
+private:
+    static const size_t cMaxRecords;
+    static const size_t cMaxKeyToPopupSamples;
+
+    static std::vector<CmdTimingPtr_t>  Records;
+    static size_t                       Next;
+
+    // Automatic autocomplete latency from the last typed char to the shown completion list
+    static std::vector<double>          KeyToPopup;
+    static size_t                       NextKeyToPopup;
+
+    static bool keyToPopupPercentiles(double& p50, double& p90, double& p99, double& max);
+    static void show(const CTextA& txt);
+};
+
+} // namespace GTags
@@ -1,116 +1,161 @@
-/**
- *  \file
- *  \brief  GTags database manager
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <tchar.h>
-#include <list>
-#include <memory>
-#include "Common.h"
-#include "Config.h"
-#include "CmdDefines.h"
-
-
-namespace GTags
-{
-
-/**
- *  \class  GTagsDb
- *  \brief
- */
-class GTagsDb : public std::enable_shared_from_this<GTagsDb>
-{
-public:
-    GTagsDb(const CPath& dbPath, bool writeEn);
-    ~GTagsDb() {}
-
-    inline const CPath& GetPath() const { return _path; }
-
-    inline const DbConfig& GetConfig() const { return _cfg; }
-    inline void SetConfig(const DbConfig& cfg) { _cfg = cfg; }
-
-    void Update(const CPath& file);
-    void ScheduleUpdate(const CPath& file);
-
-    inline void SaveCfg()
-    {
-        _cfg.SaveToFolder(_path);
-    }
-
-private:
-    friend class DbManager;
-
-    static void dbUpdateCB(const CmdPtr_t& cmd);
-
-    bool lock(bool writeEn);
-    bool unlock();
-
-    void runScheduledUpdate();
-
-    CPath       _path;
-    DbConfig    _cfg;
-
-    int     _readLocks;
-    bool    _writeLock;
-
-    std::list<CPath> _updateList;
-};
-
-
-typedef std::shared_ptr<GTagsDb> DbHandle;
-
-
-/**
- *  \class  DbManager
- *  \brief
- */
-class DbManager
-{
-public:
-    static DbManager& Get()
-    {
-        static DbManager Instance;
-        return Instance;
-    }
-
-    const DbHandle& RegisterDb(const CPath& dbPath);
-    bool UnregisterDb(const DbHandle& db);
-    DbHandle GetDb(const CPath& filePath, bool writeEn, bool* success);
-    DbHandle GetDbAt(const CPath& dbPath, bool writeEn, bool* success);
-    void PutDb(const DbHandle& db);
-    bool DbExistsInFolder(const CPath& folder);
-
-private:
-    DbManager() {}
-    DbManager(const DbManager&);
-    ~DbManager() {}
-
-    bool deleteDb(CPath& dbPath);
-    const DbHandle& lockDb(const CPath& dbPath, bool writeEn, bool* success);
-
-    std::list<DbHandle> _dbList;
-};
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags database manager
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <tchar.h>
+#include <list>
+#include <memory>
+#include "Common.h"
+#include "Config.h"
+#include "CmdDefines.h"
+#include "UsageModel.h"
+#include "PathIndex.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  GTagsDb
+ *  \brief
+ */
+class GTagsDb : public std::enable_shared_from_this<GTagsDb>
+{
+public:
+    GTagsDb(const CPath& dbPath, bool writeEn);
+    ~GTagsDb() {}
+
+    inline const CPath& GetPath() const { return _path; }
+
+    inline const DbConfig& GetConfig() const { return _cfg; }
+    inline void SetConfig(const DbConfig& cfg) { _cfg = cfg; }
+
+    void Update(const CPath& file);
+    void ScheduleUpdate(const CPath& file);
+
+    inline void SaveCfg()
+    {
+        _cfg.SaveToFolder(_path);
+    }
+
+    // Completion results cache - UI thread only, cleared on database write
+    ParserPtr_t FindCompletion(CmdId_t id, const CText& tag, bool ignoreCase, bool skipLibs);
+    void CacheCompletion(const CmdPtr_t& cmd);
+
+    // Files list for the file searches - loaded by the first one, thread safe
+    inline PathIndex& Paths() { return _paths; }
+
+    // Completions usage ranking - UI thread only, opened on first use
+    inline UsageModel& Usage()
+    {
+        _usage.Open(_path);
+        return _usage;
+    }
+
+private:
+    friend class DbManager;
+
+    /**
+     *  \struct  CachedCompletion
+     *  \brief
+     */
+    struct CachedCompletion
+    {
+        CmdId_t     _id;
+        CText       _tag;
+        bool        _ic;
+        bool        _skipLibs;
+        ParserPtr_t _parser;
+    };
+
+    static const size_t cMaxCachedCompletions;
+
+    static inline CmdId_t complId(CmdId_t id)
+    {
+        return (id == AUTOCOMPLETE_SYMBOL) ? AUTOCOMPLETE : id;
+    }
+
+    static void dbUpdateCB(const CmdPtr_t& cmd);
+
+    bool lock(bool writeEn);
+    bool unlock();
+
+    void traceLocks() const;
+    void traceLockFail(bool writeEn) const;
+
+    void runScheduledUpdate();
+
+    CPath       _path;
+    DbConfig    _cfg;
+
+    int     _readLocks;
+    bool    _writeLock;
+
+    std::list<CPath> _updateList;
+
+    std::list<CachedCompletion> _complCache; // Most recently used first
+
+    UsageModel  _usage;
+    PathIndex   _paths;
+};
+
+
+typedef std::shared_ptr<GTagsDb> DbHandle;
+
+
+/**
+ *  \class  DbManager
+ *  \brief
+ */
+class DbManager
+{
+public:
+    static DbManager& Get()
+    {
+        static DbManager Instance;
+        return Instance;
+    }
+
+    const DbHandle& RegisterDb(const CPath& dbPath);
+    bool UnregisterDb(const DbHandle& db);
+    DbHandle GetDb(const CPath& filePath, bool writeEn, bool* success);
+    DbHandle GetDbAt(const CPath& dbPath, bool writeEn, bool* success);
+    DbHandle FindDb(const CPath& dbPath) const;
+    void PutDb(const DbHandle& db);
+    bool DbExistsInFolder(const CPath& folder);
+
+private:
+    DbManager() {}
+    DbManager(const DbManager&);
+    ~DbManager() {}
+
+    bool deleteDb(CPath& dbPath);
+    const DbHandle& lockDb(const CPath& dbPath, bool writeEn, bool* success);
+
+    std::list<DbHandle> _dbList;
+};
+
+} // namespace GTags
@@ -0,0 +1,296 @@
+/**
+ *  \file
+ *  \brief  Fuzzy subsequence matching and ranking of completion entries
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FuzzyMatcher.h"
+#include <algorithm>
+
+
+namespace
+{
+
+const size_t cMaxPatternLen = 128;
+
+
+enum CharClass
+{
+    OTHER,
+    LOWER,
+    UPPER,
+    DIGIT,
+    ALNUM
+};
+
+
+/**
+ *  \brief
+ */
+inline uint64_t charBit(TCHAR c)
+{
+    if (c >= _T('a') && c <= _T('z'))
+        return 1ULL << (c - _T('a'));
+    if (c >= _T('A') && c <= _T('Z'))
+        return 1ULL << (c - _T('A'));
+    if (c >= _T('0') && c <= _T('9'))
+        return 1ULL << (26 + c - _T('0'));
+    if (c == _T('_'))
+        return 1ULL << 36;
+    if (c < 128)
+        return 1ULL << (37 + (c & 15));
+
+    return 1ULL << 53;
+}
+
+
+/**
+ *  \brief  Character class for the word starts - the C runtime classification only for the non-ASCII chars
+ */
+inline CharClass charClass(TCHAR c)
+{
+    if (c < 128)
+    {
+        if (c >= _T('a') && c <= _T('z'))
+            return LOWER;
+        if (c >= _T('A') && c <= _T('Z'))
+            return UPPER;
+        if (c >= _T('0') && c <= _T('9'))
+            return DIGIT;
+
+        return OTHER;
+    }
+
+    if (_istdigit(c))
+        return DIGIT;
+    if (_istlower(c))
+        return LOWER;
+    if (_istupper(c))
+        return UPPER;
+
+    return _istalnum(c) ? ALNUM : OTHER;
+}
+
+
+/**
+ *  \struct  Candidate
+ *  \brief
+ */
+struct Candidate
+{
+    int     score;
+    size_t  idx;
+
+    // Equal scores keep the list order
+    inline bool operator<(const Candidate& rhs) const
+    {
+        return (score > rhs.score || (score == rhs.score && idx < rhs.idx));
+    }
+};
+
+} // anonymous namespace
+
+
+namespace GTags
+{
+
+const int FuzzyMatcher::cMatchScore         = 16;
+const int FuzzyMatcher::cFirstCharBonus     = 32;
+const int FuzzyMatcher::cWordStartBonus     = 24;
+const int FuzzyMatcher::cConsecutiveBonus   = 16;
+const int FuzzyMatcher::cMaxGapPenalty      = 8;
+
+
+/**
+ *  \brief
+ */
+uint64_t FuzzyMatcher::CharBag(const TCHAR* str)
+{
+    uint64_t bag = 0;
+
+    for (; *str; ++str)
+        bag |= charBit(*str);
+
+    return bag;
+}
+
+
+/**
+ *  \brief
+ */
+FuzzyMatcher::FuzzyMatcher(const TCHAR* pattern, bool ignoreCase) :
+    _pattern(pattern), _len(std::min(_tcslen(pattern), cMaxPatternLen)), _ic(ignoreCase), _bag(CharBag(pattern)),
+    _otherCase(pattern, pattern + _len)
+{
+    if (_ic)
+        for (TCHAR& c : _otherCase)
+            c = _istupper(c) ? _totlower(c) : _totupper(c);
+}
+
+
+/**
+ *  \brief  Greedy left to right match that prefers word starts whenever the rest of the pattern still fits
+ */
+bool FuzzyMatcher::Score(const TCHAR* entry, int& score) const
+{
+    const size_t entryLen = _tcslen(entry);
+
+    if (entryLen < _len)
+        return false;
+
+    score = 0;
+
+    if (!_len)
+        return true;
+
+    // The last entry position each pattern char can match at so that the rest of the pattern still matches
+    size_t lastPos[cMaxPatternLen];
+
+    size_t pos = entryLen;
+    for (size_t i = _len; i-- > 0;)
+    {
+        while (pos > 0 && !charsMatch(i, entry[pos - 1]))
+            --pos;
+
+        if (pos == 0)
+            return false;
+
+        lastPos[i] = --pos;
+    }
+
+    size_t prevMatch = 0;
+    pos = 0;
+
+    for (size_t i = 0; i < _len; ++i)
+    {
+        while (!charsMatch(i, entry[pos]))
+            ++pos;
+
+        const bool consecutive = (i > 0 && pos == prevMatch + 1);
+
+        if (!consecutive && !isWordStart(entry, pos))
+        {
+            for (size_t k = pos + 1; k <= lastPos[i]; ++k)
+            {
+                if (charsMatch(i, entry[k]) && isWordStart(entry, k))
+                {
+                    pos = k;
+                    break;
+                }
+            }
+        }
+
+        const size_t gap = (i > 0) ? pos - prevMatch - 1 : pos;
+
+        score += cMatchScore - (int)std::min(gap, (size_t)cMaxGapPenalty);
+
+        if (pos == 0)
+            score += cFirstCharBonus;
+        else if (isWordStart(entry, pos))
+            score += cWordStartBonus;
+
+        if (i > 0 && pos == prevMatch + 1)
+            score += cConsecutiveBonus;
+
+        prevMatch = pos++;
+    }
+
+    // Slightly prefer shorter entries
+    score -= (int)((entryLen - _len) >> 3);
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+void FuzzyMatcher::SelectBest(const std::vector<TCHAR*>& list, const std::vector<uint64_t>& bags,
+        size_t maxCount, std::vector<TCHAR*>& matches) const
+{
+    matches.clear();
+
+    if (!maxCount)
+        return;
+
+    const bool prefilter = (bags.size() == list.size());
+
+    // The matches are collected and cut down to the best maxCount whenever there are twice as many - linear
+    // time, a bounded heap pops and pushes on almost every match when many entries score the same
+    std::vector<Candidate> best;
+    best.reserve(std::min(list.size(), 2 * maxCount));
+
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        if (prefilter && (bags[i] & _bag) != _bag)
+            continue;
+
+        Candidate c;
+        if (!Score(list[i], c.score))
+            continue;
+
+        c.idx = i;
+
+        if (best.size() == 2 * maxCount)
+        {
+            std::nth_element(best.begin(), best.begin() + maxCount, best.end());
+            best.resize(maxCount);
+        }
+
+        best.push_back(c);
+    }
+
+    if (best.size() > maxCount)
+    {
+        std::nth_element(best.begin(), best.begin() + maxCount, best.end());
+        best.resize(maxCount);
+    }
+
+    std::sort(best.begin(), best.end());
+
+    matches.resize(best.size());
+
+    for (size_t i = 0; i < best.size(); ++i)
+        matches[i] = list[best[i].idx];
+}
+
+
+/**
+ *  \brief
+ */
+bool FuzzyMatcher::isWordStart(const TCHAR* entry, size_t pos)
+{
+    if (pos == 0)
+        return true;
+
+    const CharClass prev = charClass(entry[pos - 1]);
+    const CharClass curr = charClass(entry[pos]);
+
+    if (prev == OTHER)
+        return (curr != OTHER);
+
+    if (prev == LOWER && curr == UPPER)
+        return true;
+
+    return ((prev == DIGIT) != (curr == DIGIT));
+}
+
+} // namespace GTags
@@ -0,0 +1,83 @@
+/**
+ *  \file
+ *  \brief  Fuzzy subsequence matching and ranking of completion entries
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <cstdint>
+#include <vector>
+
+
+namespace GTags
+{
+
+/**
+ *  \class  FuzzyMatcher
+ *  \brief  Matches the pattern characters in order anywhere in the entry - word starts
+ *          (after '_', digits or on lower to upper case change) and consecutive matches rank higher
+ */
+class FuzzyMatcher
+{
+public:
+    // Case folded set of the string characters - an entry can match only if it has all pattern characters
+    static uint64_t CharBag(const TCHAR* str);
+
+    FuzzyMatcher(const TCHAR* pattern, bool ignoreCase);
+    ~FuzzyMatcher() {}
+
+    // Returns false if entry doesn't match
+    bool Score(const TCHAR* entry, int& score) const;
+
+    // Fills matches with the best maxCount entries in descending score order - bags are optional
+    void SelectBest(const std::vector<TCHAR*>& list, const std::vector<uint64_t>& bags, size_t maxCount,
+            std::vector<TCHAR*>& matches) const;
+
+private:
+    static const int cMatchScore;
+    static const int cFirstCharBonus;
+    static const int cWordStartBonus;
+    static const int cConsecutiveBonus;
+    static const int cMaxGapPenalty;
+
+    FuzzyMatcher(const FuzzyMatcher&) = delete;
+    FuzzyMatcher& operator=(const FuzzyMatcher&) = delete;
+
+    static bool isWordStart(const TCHAR* entry, size_t pos);
+
+    // Pattern char i - compared with its other case variant folded upfront instead of folding each entry char
+    inline bool charsMatch(size_t i, TCHAR e) const
+    {
+        return (e == _pattern[i] || e == _otherCase[i]);
+    }
+
+    const TCHAR* const  _pattern;
+    const size_t        _len;
+    const bool          _ic;
+    const uint64_t      _bag;
+    std::vector<TCHAR>  _otherCase;
+};
+
+} // namespace GTags
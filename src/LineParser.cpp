@@ -1,63 +1,124 @@
-/**
- *  \file
- *  \brief  Line parser (splitter) class
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2015-2022 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "LineParser.h"
-#include "StrUniquenessChecker.h"
-
-
-namespace GTags
-{
-
-/**
- *  \brief
- */
-intptr_t LineParser::Parse(const CmdPtr_t& cmd)
-{
-    intptr_t result = 0;
-
-    const bool filterReoccurring = cmd->Db()->GetConfig()._useLibDb;
-
-    StrUniquenessChecker<TCHAR> strChecker;
-
-    _lines.clear();
-    _buf = cmd->Result();
-
-    TCHAR* pTmp = NULL;
-    for (TCHAR* pToken = _tcstok_s(_buf.C_str(), _T("\n\r"), &pTmp); pToken;
-            pToken = _tcstok_s(NULL, _T("\n\r"), &pTmp))
-    {
-        if (cmd->Id() == FIND_FILE || cmd->Id() == AUTOCOMPLETE_FILE)
-            ++pToken;
-
-        if ((!filterReoccurring) || strChecker.IsUnique(pToken))
-        {
-            _lines.push_back(pToken);
-            ++result;
-        }
-    }
-
-    return result;
-}
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  Line parser (splitter) class
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2015-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "LineParser.h"
+#include "StrUniquenessChecker.h"
+#include "FuzzyMatcher.h"
+#include "Config.h"
+#include "GTags.h"
+#include <cstring>
+#include <algorithm>
+
+
+namespace GTags
+{
+
+/**
+ *  \brief
+ */
+intptr_t LineParser::Parse(const CmdPtr_t& cmd)
+{
+    intptr_t result = 0;
+
+    const bool filterReoccurring = cmd->Db()->GetConfig()._useLibDb;
+
+    StrUniquenessChecker<TCHAR> strChecker;
+
+    _lines.clear();
+    _buf.Clear();
+    _buf.Reserve(cmd->ResultLen());
+
+    size_t linesCount = 0;
+
+    // Converted straight from the output chunks - the command output is never gathered into one buffer
+    cmd->ForEachResultPart([this, &linesCount](const char* pData, size_t len)
+    {
+        const char* const pEnd = pData + len;
+
+        for (const char* pSrc = pData;
+                (pSrc = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc))) != NULL; ++pSrc)
+            ++linesCount;
+
+        _buf.Append(pData, len);
+    });
+
+    _lines.reserve(linesCount + 1);
+    if (filterReoccurring)
+        strChecker.Reserve(linesCount + 1);
+
+    TCHAR* pTmp = NULL;
+    for (TCHAR* pToken = _tcstok_s(_buf.C_str(), _T("\n\r"), &pTmp); pToken;
+            pToken = _tcstok_s(NULL, _T("\n\r"), &pTmp))
+    {
+        if (cmd->Id() == FIND_FILE || cmd->Id() == AUTOCOMPLETE_FILE)
+            ++pToken;
+
+        if ((!filterReoccurring) || strChecker.IsUnique(pToken))
+        {
+            _lines.push_back(pToken);
+            ++result;
+        }
+    }
+
+    // Sort here in the worker thread so the UI can binary search for prefixes
+    std::sort(_lines.begin(), _lines.end(), Less);
+
+    _bags.clear();
+
+    if (GTagsSettings._fuzzyCompl)
+    {
+        _bags.reserve(_lines.size());
+
+        for (const auto& line : _lines)
+            _bags.push_back(FuzzyMatcher::CharBag(line));
+    }
+
+    return result;
+}
+
+
+/**
+ *  \brief
+ */
+void LineParser::FindPrefix(const std::vector<TCHAR*>& list, const TCHAR* prefix, size_t len,
+        size_t& first, size_t& last)
+{
+    if (!len)
+    {
+        first = 0;
+        last = list.size();
+        return;
+    }
+
+    auto lower = std::lower_bound(list.begin(), list.end(), prefix,
+        [len](const TCHAR* entry, const TCHAR* pfx) { return (_tcsnicmp(entry, pfx, len) < 0); });
+
+    auto upper = std::upper_bound(lower, list.end(), prefix,
+        [len](const TCHAR* pfx, const TCHAR* entry) { return (_tcsnicmp(pfx, entry, len) < 0); });
+
+    first = lower - list.begin();
+    last = upper - list.begin();
+}
+
+} // namespace GTags
@@ -0,0 +1,121 @@
+/**
+ *  \file
+ *  \brief  Lock-free multiple producers single consumer queue
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2016 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+
+/**
+ *  \class  MpscQueue
+ *  \brief  Producers push items one by one, the consumer takes all queued items at once
+ */
+template<typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() : _head(NULL) {}
+
+    ~MpscQueue()
+    {
+        Node* node = _head.exchange(NULL);
+
+        while (node)
+        {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    /**
+     *  \brief  Returns true if the queue was empty - the consumer should be woken up then
+     */
+    bool Push(T&& item)
+    {
+        Node* node = new Node(std::move(item));
+        Node* head = _head.load(std::memory_order_relaxed);
+
+        do
+        {
+            node->next = head;
+        }
+        while (!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+        return (head == NULL);
+    }
+
+    /**
+     *  \brief  Appends all queued items to items in the order they were pushed
+     */
+    void PopAll(std::vector<T>& items)
+    {
+        Node* node = _head.exchange(NULL, std::memory_order_acquire);
+        Node* first = NULL;
+
+        // The list is in LIFO order - reverse it
+        while (node)
+        {
+            Node* next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+        }
+
+        while (first)
+        {
+            Node* next = first->next;
+            items.push_back(std::move(first->item));
+            delete first;
+            first = next;
+        }
+    }
+
+    bool IsEmpty() const
+    {
+        return (_head.load(std::memory_order_relaxed) == NULL);
+    }
+
+private:
+    /**
+     *  \struct  Node
+     *  \brief
+     */
+    struct Node
+    {
+        Node(T&& i) : item(std::move(i)), next(NULL) {}
+
+        T       item;
+        Node*   next;
+    };
+
+    MpscQueue(const MpscQueue&) = delete;
+    const MpscQueue& operator=(const MpscQueue&) = delete;
+
+    std::atomic<Node*> _head;
+};
@@ -0,0 +1,633 @@
+/**
+ *  \file
+ *  \brief  In-memory index of the database files paths
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PathIndex.h"
+#include <cstring>
+#include <algorithm>
+
+
+namespace GTags
+{
+
+const uint32_t PathIndex::cNone = UINT32_MAX;
+
+
+/**
+ *  \brief
+ */
+void PathIndex::Clear()
+{
+    AUTOLOCK(_lock);
+
+    clear();
+}
+
+
+/**
+ *  \brief
+ */
+bool PathIndex::IsLoaded() const
+{
+    AUTOLOCK(_lock);
+
+    return _loaded;
+}
+
+
+/**
+ *  \brief
+ */
+void PathIndex::Update(const char* path, bool exists)
+{
+    AUTOLOCK(_lock);
+
+    if (!_loaded)
+        return;
+
+    const size_t len = strlen(path);
+
+    if (exists)
+        add(path, len, true);
+    else
+        remove(path, len);
+}
+
+
+/**
+ *  \brief
+ */
+bool PathIndex::HasFile(const char* path)
+{
+    AUTOLOCK(_lock);
+
+    if (!_loaded)
+        return false;
+
+    const size_t len = strlen(path);
+
+    const char* pName = path + len;
+    while (pName > path && *(pName - 1) != '/')
+        --pName;
+
+    const uint32_t dir = findDir(path, pName - path, false, true);
+
+    return (dir != cNone && findFile(dir, pName, path + len - pName) != cNone);
+}
+
+
+/**
+ *  \brief  The files are scanned in path order so the search stops at the limit. Each directory path is checked
+ *          once - the files are checked only for a match that ends in their name
+ */
+bool PathIndex::FindFiles(const char* pattern, bool ignoreCase, unsigned skip, unsigned maxCount,
+        std::vector<char>& out, bool& truncated) const
+{
+    AUTOLOCK(_lock);
+
+    out.clear();
+    truncated = false;
+
+    if (!_loaded)
+        return false;
+
+    std::string pat(pattern);
+    if (ignoreCase)
+        fold(pat);
+
+    // The parent directories come first - a directory matches if its parent does or its own name part does
+    const size_t overlap = pat.empty() ? 0 : pat.size() - 1;
+    std::vector<char> dirMatches(_dirs.size(), 0);
+
+    for (uint32_t i = 1; i < _dirs.size(); ++i)
+    {
+        const Dir& dir = _dirs[i];
+
+        if (dirMatches[dir.parent])
+        {
+            dirMatches[i] = 1;
+            continue;
+        }
+
+        const size_t parentLen = dir.path.size() - dir.name.size() - 1;
+        const size_t from = (parentLen > overlap) ? parentLen - overlap : 0;
+
+        dirMatches[i] = contains(NULL, 0, dir.path.c_str() + from, dir.path.size() - from, pat, ignoreCase);
+    }
+
+    const size_t last = maxCount ? (size_t)skip + maxCount : SIZE_MAX;
+    size_t found = 0;
+
+    for (uint32_t id : _filesByPath)
+    {
+        const File& file = _files[id];
+        const std::string& dirPath = _dirs[file.dir].path;
+
+        if (!dirMatches[file.dir])
+        {
+            // The match might start in the directory path and end in the name
+            const size_t from = (dirPath.size() > overlap) ? dirPath.size() - overlap : 0;
+
+            if (!contains(dirPath.c_str() + from, dirPath.size() - from, file.name.c_str(), file.name.size(),
+                    pat, ignoreCase))
+                continue;
+        }
+
+        if (found == last)
+        {
+            truncated = true;
+            break;
+        }
+
+        if (found++ < skip)
+            continue;
+
+        if (_dotPrefix)
+            out.insert(out.end(), { '.', '/' });
+
+        out.insert(out.end(), dirPath.begin(), dirPath.end());
+        appendLine(out, file.name);
+    }
+
+    if (!out.empty())
+        out.push_back(0);
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool PathIndex::CompleteFiles(const char* prefix, bool ignoreCase, std::vector<char>& out) const
+{
+    AUTOLOCK(_lock);
+
+    out.clear();
+
+    if (!_loaded)
+        return false;
+
+    const size_t len = strlen(prefix);
+
+    std::vector<std::string> parts;
+    size_t first, last;
+
+    prefixRange(_filesByName, _files, prefix, len, first, last);
+
+    for (size_t i = first; i < last; ++i)
+    {
+        const File& file = _files[_filesByName[i]];
+
+        if (ignoreCase || !strncmp(file.name.c_str(), prefix, len))
+            parts.push_back("/" + file.name);
+    }
+
+    prefixRange(_dirsByName, _dirs, prefix, len, first, last);
+
+    std::vector<uint32_t> files;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        const Dir& dir = _dirs[_dirsByName[i]];
+
+        if (!ignoreCase && strncmp(dir.name.c_str(), prefix, len))
+            continue;
+
+        // The part starts at the directory name
+        const size_t from = dir.path.size() - dir.name.size() - 1;
+
+        files.clear();
+        subtreeFiles(_dirsByName[i], files);
+
+        for (uint32_t f : files)
+            parts.push_back("/" + _dirs[_files[f].dir].path.substr(from) + _files[f].name);
+    }
+
+    std::sort(parts.begin(), parts.end());
+    parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+
+    for (const auto& part : parts)
+        appendLine(out, part);
+
+    if (!out.empty())
+        out.push_back(0);
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool PathIndex::nameLess(const std::string& a, const std::string& b)
+{
+    const int r = _stricmp(a.c_str(), b.c_str());
+    return (r ? (r < 0) : (a < b));
+}
+
+
+/**
+ *  \brief  Folds ASCII letters only - multi-byte UTF-8 sequences are left as they are
+ */
+void PathIndex::fold(std::string& str)
+{
+    for (auto& c : str)
+        c = fold(c);
+}
+
+
+/**
+ *  \brief  Looks for pattern (folded if ignoreCase) in head followed by tail without joining them.
+ *          head is short - it is the end of a directory path that a match in tail might start in
+ */
+bool PathIndex::contains(const char* head, size_t headLen, const char* tail, size_t tailLen,
+        const std::string& pattern, bool ignoreCase)
+{
+    const char* const pat = pattern.c_str();
+    const size_t patLen = pattern.size();
+
+    if (!patLen)
+        return true;
+    if (patLen > headLen + tailLen)
+        return false;
+
+    for (size_t i = 0; i < headLen && i + patLen <= headLen + tailLen; ++i)
+    {
+        size_t j = 0;
+
+        for (; j < patLen; ++j)
+        {
+            const char c = (i + j < headLen) ? head[i + j] : tail[i + j - headLen];
+
+            if ((ignoreCase ? fold(c) : c) != pat[j])
+                break;
+        }
+
+        if (j == patLen)
+            return true;
+    }
+
+    if (patLen > tailLen)
+        return false;
+
+    const char* const pLast = tail + tailLen - patLen;
+
+    if (!ignoreCase)
+    {
+        for (const char* pSrc = tail; pSrc <= pLast; ++pSrc)
+        {
+            pSrc = static_cast<const char*>(memchr(pSrc, pat[0], pLast - pSrc + 1));
+            if (pSrc == NULL)
+                return false;
+
+            if (!memcmp(pSrc + 1, pat + 1, patLen - 1))
+                return true;
+        }
+
+        return false;
+    }
+
+    for (const char* pSrc = tail; pSrc <= pLast; ++pSrc)
+    {
+        if (fold(*pSrc) != pat[0])
+            continue;
+
+        size_t j = 1;
+        for (; j < patLen && fold(pSrc[j]) == pat[j]; ++j);
+
+        if (j == patLen)
+            return true;
+    }
+
+    return false;
+}
+
+
+/**
+ *  \brief
+ */
+void PathIndex::appendLine(std::vector<char>& out, const std::string& line)
+{
+    out.insert(out.end(), line.begin(), line.end());
+    out.push_back('\n');
+}
+
+
+/**
+ *  \brief  Adds a line of the files list being loaded
+ */
+void PathIndex::loadLine(const char* pLine, size_t len)
+{
+    if (len > 2 && pLine[0] == '.' && pLine[1] == '/')
+    {
+        _dotPrefix = true;
+        pLine += 2;
+        len -= 2;
+    }
+
+    if (len)
+        add(pLine, len, false);
+}
+
+
+/**
+ *  \brief  Builds the lookup indexes once all the files list is loaded
+ */
+void PathIndex::loadDone()
+{
+    _dirsByName.reserve(_dirs.size() - 1);
+    for (uint32_t i = 1; i < _dirs.size(); ++i)
+        _dirsByName.push_back(i);
+
+    _filesByName.reserve(_files.size());
+    for (uint32_t i = 0; i < _files.size(); ++i)
+        _filesByName.push_back(i);
+
+    _filesByPath = _filesByName;
+
+    std::sort(_dirsByName.begin(), _dirsByName.end(),
+        [this](uint32_t a, uint32_t b) { return nameLess(_dirs[a].name, _dirs[b].name); });
+
+    std::sort(_filesByName.begin(), _filesByName.end(),
+        [this](uint32_t a, uint32_t b) { return nameLess(_files[a].name, _files[b].name); });
+
+    std::sort(_filesByPath.begin(), _filesByPath.end(),
+        [this](uint32_t a, uint32_t b) { return pathLess(a, b); });
+
+    _loaded = true;
+}
+
+
+/**
+ *  \brief
+ */
+void PathIndex::clear()
+{
+    _loaded = false;
+    _dotPrefix = false;
+
+    _dirs.clear();
+    _files.clear();
+    _freeFiles.clear();
+    _dirsByName.clear();
+    _filesByName.clear();
+    _filesByPath.clear();
+
+    Dir root;
+    root.parent = cNone;
+    _dirs.push_back(root);
+}
+
+
+/**
+ *  \brief
+ */
+void PathIndex::add(const char* path, size_t len, bool sorted)
+{
+    const char* pName = path + len;
+    while (pName > path && *(pName - 1) != '/')
+        --pName;
+
+    const size_t nameLen = path + len - pName;
+    if (!nameLen)
+        return;
+
+    const uint32_t dir = findDir(path, pName - path, true, sorted);
+
+    if (sorted && findFile(dir, pName, nameLen) != cNone)
+        return;
+
+    uint32_t id;
+
+    if (_freeFiles.empty())
+    {
+        id = (uint32_t)_files.size();
+        _files.emplace_back();
+    }
+    else
+    {
+        id = _freeFiles.back();
+        _freeFiles.pop_back();
+    }
+
+    File& file = _files[id];
+    file.dir = dir;
+    file.name.assign(pName, nameLen);
+
+    _dirs[dir].files.push_back(id);
+
+    if (sorted)
+    {
+        auto pos = std::upper_bound(_filesByName.begin(), _filesByName.end(), id,
+            [this](uint32_t a, uint32_t b) { return nameLess(_files[a].name, _files[b].name); });
+
+        _filesByName.insert(pos, id);
+
+        pos = std::upper_bound(_filesByPath.begin(), _filesByPath.end(), id,
+            [this](uint32_t a, uint32_t b) { return pathLess(a, b); });
+
+        _filesByPath.insert(pos, id);
+    }
+}
+
+
+/**
+ *  \brief  Directories are not removed - empty ones just don't show in the results
+ */
+void PathIndex::remove(const char* path, size_t len)
+{
+    const char* pName = path + len;
+    while (pName > path && *(pName - 1) != '/')
+        --pName;
+
+    const uint32_t dir = findDir(path, pName - path, false, true);
+    if (dir == cNone)
+        return;
+
+    const uint32_t id = findFile(dir, pName, path + len - pName);
+    if (id == cNone)
+        return;
+
+    std::vector<uint32_t>& dirFiles = _dirs[dir].files;
+    dirFiles.erase(std::find(dirFiles.begin(), dirFiles.end(), id));
+
+    auto range = std::equal_range(_filesByName.begin(), _filesByName.end(), id,
+        [this](uint32_t a, uint32_t b) { return nameLess(_files[a].name, _files[b].name); });
+
+    _filesByName.erase(std::find(range.first, range.second, id));
+
+    range = std::equal_range(_filesByPath.begin(), _filesByPath.end(), id,
+        [this](uint32_t a, uint32_t b) { return pathLess(a, b); });
+
+    _filesByPath.erase(std::find(range.first, range.second, id));
+
+    _files[id].name.clear();
+    _freeFiles.push_back(id);
+}
+
+
+/**
+ *  \brief  path is the directory part of a file path - empty or ending with '/'
+ */
+uint32_t PathIndex::findDir(const char* path, size_t len, bool create, bool sorted)
+{
+    uint32_t dir = 0;
+
+    for (size_t start = 0; start < len;)
+    {
+        const char* pEnd = static_cast<const char*>(memchr(path + start, '/', len - start));
+        const size_t end = pEnd - path;
+
+        // Skip empty components
+        if (end == start)
+        {
+            ++start;
+            continue;
+        }
+
+        const std::string name(path + start, end - start);
+        uint32_t subdir = cNone;
+
+        for (uint32_t id : _dirs[dir].subdirs)
+        {
+            if (_dirs[id].name == name)
+            {
+                subdir = id;
+                break;
+            }
+        }
+
+        if (subdir == cNone)
+        {
+            if (!create)
+                return cNone;
+
+            subdir = (uint32_t)_dirs.size();
+
+            Dir newDir;
+            newDir.parent   = dir;
+            newDir.name     = name;
+            newDir.path     = _dirs[dir].path + name + '/';
+            _dirs.push_back(newDir);
+
+            _dirs[dir].subdirs.push_back(subdir);
+
+            if (sorted)
+            {
+                auto pos = std::upper_bound(_dirsByName.begin(), _dirsByName.end(), subdir,
+                    [this](uint32_t a, uint32_t b) { return nameLess(_dirs[a].name, _dirs[b].name); });
+
+                _dirsByName.insert(pos, subdir);
+            }
+        }
+
+        dir = subdir;
+        start = end + 1;
+    }
+
+    return dir;
+}
+
+
+/**
+ *  \brief
+ */
+uint32_t PathIndex::findFile(uint32_t dir, const char* name, size_t len) const
+{
+    for (uint32_t id : _dirs[dir].files)
+    {
+        const std::string& fileName = _files[id].name;
+
+        if (fileName.size() == len && !fileName.compare(0, len, name, len))
+            return id;
+    }
+
+    return cNone;
+}
+
+
+/**
+ *  \brief
+ */
+void PathIndex::subtreeFiles(uint32_t dir, std::vector<uint32_t>& files) const
+{
+    const Dir& d = _dirs[dir];
+
+    files.insert(files.end(), d.files.begin(), d.files.end());
+
+    for (uint32_t subdir : d.subdirs)
+        subtreeFiles(subdir, files);
+}
+
+
+/**
+ *  \brief  Compares the full paths (as std::string does) without joining the directory path and the name
+ */
+bool PathIndex::pathLess(uint32_t a, uint32_t b) const
+{
+    const File& fileA = _files[a];
+    const File& fileB = _files[b];
+
+    if (fileA.dir == fileB.dir)
+        return (fileA.name < fileB.name);
+
+    const std::string& dirA = _dirs[fileA.dir].path;
+    const std::string& dirB = _dirs[fileB.dir].path;
+
+    const size_t common = std::min(dirA.size(), dirB.size());
+
+    const int r = dirA.compare(0, common, dirB, 0, common);
+    if (r)
+        return (r < 0);
+
+    // One directory path is a prefix of the other - compare the rest of the longer one to the other name
+    if (dirA.size() < dirB.size())
+    {
+        const int rest = fileA.name.compare(0, std::string::npos, dirB, common, std::string::npos);
+        return (rest ? (rest < 0) : (fileA.name.size() < dirB.size() - common + fileB.name.size()));
+    }
+
+    const int rest = dirA.compare(common, std::string::npos, fileB.name);
+    return (rest ? (rest < 0) : (dirA.size() - common + fileA.name.size() < fileB.name.size()));
+}
+
+
+/**
+ *  \brief  The index is sorted ignoring case so the items starting with prefix are a range in it
+ */
+template<typename T>
+void PathIndex::prefixRange(const std::vector<uint32_t>& index, const std::vector<T>& items, const char* prefix,
+        size_t len, size_t& first, size_t& last) const
+{
+    auto lower = std::lower_bound(index.begin(), index.end(), prefix,
+        [&items, len](uint32_t id, const char* pfx) { return (_strnicmp(items[id].name.c_str(), pfx, len) < 0); });
+
+    auto upper = std::upper_bound(lower, index.end(), prefix,
+        [&items, len](const char* pfx, uint32_t id) { return (_strnicmp(pfx, items[id].name.c_str(), len) < 0); });
+
+    first = lower - index.begin();
+    last = upper - index.begin();
+}
+
+} // namespace GTags
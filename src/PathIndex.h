@@ -0,0 +1,140 @@
+/**
+ *  \file
+ *  \brief  In-memory index of the database files paths
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AutoLock.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  PathIndex
+ *  \brief  The database files list (as global -P prints it) with interned directories and a file names index
+ *
+ *  Answers the file searches and completions without running global. Loaded once from the full files list
+ *  and then kept up to date on single file updates. Thread safe.
+ */
+class PathIndex
+{
+public:
+    PathIndex() : _loaded(false), _dotPrefix(false) {}
+    ~PathIndex() {}
+
+    // Loads the global -P output - one path relative to the database root per line. forEachLine(addLine) has to
+    // call addLine(const char* line, size_t len) for each line without its EOL
+    template<typename F>
+    void Load(F forEachLine)
+    {
+        AUTOLOCK(_lock);
+
+        clear();
+
+        forEachLine([this](const char* pLine, size_t len) { loadLine(pLine, len); return true; });
+
+        loadDone();
+    }
+    void Clear();
+
+    bool IsLoaded() const;
+
+    // path is relative to the database root with '/' separators
+    void Update(const char* path, bool exists);
+    bool HasFile(const char* path);
+
+    // Fills out with global -P output of the paths containing pattern. Returns false if not loaded
+    bool FindFiles(const char* pattern, bool ignoreCase, unsigned skip, unsigned maxCount,
+            std::vector<char>& out, bool& truncated) const;
+
+    // Fills out with global -cP --match-part=all output - '/' followed by the path part starting
+    // with prefix (a directory or file name) to the end. Returns false if not loaded
+    bool CompleteFiles(const char* prefix, bool ignoreCase, std::vector<char>& out) const;
+
+private:
+    static const uint32_t cNone;
+
+    /**
+     *  \struct  Dir
+     *  \brief
+     */
+    struct Dir
+    {
+        uint32_t                parent;
+        std::string             name;
+        std::string             path; // Full relative path with trailing '/'
+        std::vector<uint32_t>   subdirs;
+        std::vector<uint32_t>   files;
+    };
+
+    /**
+     *  \struct  File
+     *  \brief
+     */
+    struct File
+    {
+        uint32_t    dir;
+        std::string name; // Empty if the file is removed
+    };
+
+    PathIndex(const PathIndex&) = delete;
+    PathIndex& operator=(const PathIndex&) = delete;
+
+    static bool nameLess(const std::string& a, const std::string& b);
+    static inline char fold(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c + 'a' - 'A') : c; }
+    static void fold(std::string& str);
+    static bool contains(const char* head, size_t headLen, const char* tail, size_t tailLen,
+            const std::string& pattern, bool ignoreCase);
+    static void appendLine(std::vector<char>& out, const std::string& line);
+
+    void clear();
+    void loadLine(const char* pLine, size_t len);
+    void loadDone();
+    void add(const char* path, size_t len, bool sorted);
+    void remove(const char* path, size_t len);
+    uint32_t findDir(const char* path, size_t len, bool create, bool sorted);
+    uint32_t findFile(uint32_t dir, const char* name, size_t len) const;
+    void subtreeFiles(uint32_t dir, std::vector<uint32_t>& files) const;
+    bool pathLess(uint32_t a, uint32_t b) const;
+
+    template<typename T>
+    void prefixRange(const std::vector<uint32_t>& index, const std::vector<T>& items, const char* prefix,
+            size_t len, size_t& first, size_t& last) const;
+
+    mutable Mutex           _lock;
+    bool                    _loaded;
+    bool                    _dotPrefix; // The paths are printed starting with "./"
+    std::vector<Dir>        _dirs;      // The first one is the root
+    std::vector<File>       _files;
+    std::vector<uint32_t>   _freeFiles;
+    std::vector<uint32_t>   _dirsByName;    // Sorted ignoring case for the prefix lookups
+    std::vector<uint32_t>   _filesByName;   // Sorted ignoring case for the prefix lookups
+    std::vector<uint32_t>   _filesByPath;   // Sorted by the full path - the file searches results order
+};
+
+} // namespace GTags
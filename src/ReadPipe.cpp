@@ -1,160 +1,515 @@
-/**
- *  \file
- *  \brief  Class that reads piped process output
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2015 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#include "ReadPipe.h"
-#include <process.h>
-
-
-const unsigned ReadPipe::cChunkSize = 4096;
-
-
-/**
- *  \brief
- */
-ReadPipe::ReadPipe() : _hIn(NULL), _hOut(NULL), _hThread(NULL)
-{
-    SECURITY_ATTRIBUTES attr    = {0};
-    attr.nLength                = sizeof(attr);
-    attr.bInheritHandle         = TRUE;
-
-    _ready = CreatePipe(&_hOut, &_hIn, &attr, 0);
-    if (_ready)
-        _ready = SetHandleInformation(_hOut, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT);
-}
-
-
-/**
- *  \brief
- */
-ReadPipe::~ReadPipe()
-{
-    if (_hThread)
-    {
-        Wait(INFINITE);
-    }
-    else
-    {
-        if (_hIn)
-            CloseHandle(_hIn);
-        if (_hOut)
-            CloseHandle(_hOut);
-    }
-}
-
-
-/**
- *  \brief
- */
-bool ReadPipe::Open()
-{
-    if (!_ready || !_hOut)
-        return false;
-    if (_hThread)
-        return true;
-
-    CloseHandle(_hIn);
-    _hIn = NULL;
-    _hThread = (HANDLE)_beginthreadex(NULL, 0, threadFunc, this, 0, NULL);
-    if (_hThread)
-        return true;
-
-    // on error
-    CloseHandle(_hOut);
-    _hOut = NULL;
-    return false;
-}
-
-
-/**
- *  \brief
- */
-DWORD ReadPipe::Wait(DWORD time_ms)
-{
-    if (!_hThread)
-        return WAIT_OBJECT_0;
-
-    DWORD r = WaitForSingleObject(_hThread, time_ms);
-    if (r != WAIT_TIMEOUT)
-    {
-        CloseHandle(_hOut);
-        _hOut = NULL;
-        CloseHandle(_hThread);
-        _hThread = NULL;
-    }
-
-    return r;
-}
-
-
-/**
- *  \brief
- */
-std::vector<char>& ReadPipe::GetOutput()
-{
-    if (_hThread)
-        Wait(INFINITE);
-
-    return _output;
-}
-
-
-/**
- *  \brief
- */
-unsigned __stdcall ReadPipe::threadFunc(void* data)
-{
-    return static_cast<ReadPipe*>(data)->thread();
-}
-
-
-/**
- *  \brief
- */
-unsigned ReadPipe::thread()
-{
-    DWORD bytesRead = 0;
-    unsigned totalBytesRead = 0;
-    unsigned chunkRemainingSize = 0;
-
-    for (;;)
-    {
-        if (!chunkRemainingSize)
-        {
-            _output.resize(totalBytesRead + cChunkSize);
-            chunkRemainingSize = cChunkSize;
-        }
-
-        if (!ReadFile(_hOut, _output.data() + totalBytesRead, chunkRemainingSize, &bytesRead, NULL))
-            break;
-
-        chunkRemainingSize -= bytesRead;
-        totalBytesRead += bytesRead;
-    }
-
-    _output.resize(totalBytesRead);
-    if (totalBytesRead)
-        _output.push_back(0);
-
-    return 0;
-}
+/**
+ *  \file
+ *  \brief  Class that reads piped process output
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2015 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ReadPipe.h"
+#include <process.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+
+const unsigned ReadPipe::cChunkSize        = 64 * 1024;
+const unsigned ReadPipe::cMaxPooledChunks  = 16;
+
+Mutex                       ReadPipe::PoolLock;
+std::vector<ReadPipe::Chunk*>  ReadPipe::Pool;
+
+
+/**
+ *  \brief
+ */
+ReadPipe::Chunk* ReadPipe::allocChunk()
+{
+    {
+        AUTOLOCK(PoolLock);
+
+        if (!Pool.empty())
+        {
+            Chunk* chunk = Pool.back();
+            Pool.pop_back();
+            chunk->len = 0;
+
+            return chunk;
+        }
+    }
+
+    Chunk* chunk = static_cast<Chunk*>(malloc(offsetof(Chunk, data) + cChunkSize));
+    if (chunk)
+        chunk->len = 0;
+
+    return chunk;
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::freeChunk(Chunk* chunk)
+{
+    {
+        AUTOLOCK(PoolLock);
+
+        if (Pool.size() < cMaxPooledChunks)
+        {
+            Pool.push_back(chunk);
+            return;
+        }
+    }
+
+    free(chunk);
+}
+
+
+/**
+ *  \brief
+ */
+ReadPipe::Output& ReadPipe::Output::operator=(Output&& other)
+{
+    if (this != &other)
+    {
+        Release();
+
+        _chunks.swap(other._chunks);
+        _len = other._len;
+        other._len = 0;
+    }
+
+    return *this;
+}
+
+
+/**
+ *  \brief  Appends the output to dst keeping it zero terminated - the chunks are released as they are copied
+ */
+void ReadPipe::Output::AppendTo(std::vector<char>& dst)
+{
+    if (!_len)
+        return;
+
+    // Only the final buffer is allocated - its pages get committed as the chunks are released
+    if (!dst.empty())
+        dst.pop_back();
+    dst.reserve(dst.size() + _len + 1);
+
+    for (Chunk* chunk : _chunks)
+    {
+        dst.insert(dst.cend(), chunk->data, chunk->data + chunk->len);
+        freeChunk(chunk);
+    }
+
+    dst.push_back(0);
+
+    _chunks.clear();
+    _len = 0;
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::Output::Release()
+{
+    for (Chunk* chunk : _chunks)
+        freeChunk(chunk);
+
+    _chunks.clear();
+    _len = 0;
+}
+
+
+/**
+ *  \brief
+ */
+ReadPipe::ReadPipe() : _hIn(NULL), _hOut(NULL), _hThread(NULL), _outputLen(0), _completeLen(0),
+    _linesToSkip(0), _linesLimit(0), _linesCount(0), _bytesLimit(0), _limitReached(false), _hLimitReached(NULL),
+    _firstReadTime(0), _lastReadTime(0)
+#ifdef DEVEL
+    , _capture(false)
+#endif
+{
+    SECURITY_ATTRIBUTES attr    = {0};
+    attr.nLength                = sizeof(attr);
+    attr.bInheritHandle         = TRUE;
+
+    _ready = CreatePipe(&_hOut, &_hIn, &attr, 0);
+    if (_ready)
+        _ready = SetHandleInformation(_hOut, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT);
+}
+
+
+/**
+ *  \brief
+ */
+ReadPipe::~ReadPipe()
+{
+    if (_hThread)
+    {
+        Wait(INFINITE);
+    }
+    else
+    {
+        if (_hIn)
+            CloseHandle(_hIn);
+        if (_hOut)
+            CloseHandle(_hOut);
+    }
+
+    if (_hLimitReached)
+        CloseHandle(_hLimitReached);
+
+    releaseChunks();
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::SetLinesLimit(unsigned skipLines, unsigned maxLines)
+{
+    // Limits can be set only before reading is started
+    if (_hThread)
+        return;
+
+    _linesToSkip = skipLines;
+    _linesLimit = maxLines;
+
+    if (_linesLimit && !_hLimitReached)
+        _hLimitReached = CreateEvent(NULL, TRUE, FALSE, NULL);
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::SetBytesLimit(size_t maxBytes)
+{
+    // Limits can be set only before reading is started
+    if (_hThread)
+        return;
+
+    _bytesLimit = maxBytes;
+
+    if (_bytesLimit && !_hLimitReached)
+        _hLimitReached = CreateEvent(NULL, TRUE, FALSE, NULL);
+}
+
+
+/**
+ *  \brief
+ */
+bool ReadPipe::Open()
+{
+    if (!_ready || !_hOut)
+        return false;
+    if (_hThread)
+        return true;
+
+    CloseHandle(_hIn);
+    _hIn = NULL;
+    _hThread = (HANDLE)_beginthreadex(NULL, 0, threadFunc, this, 0, NULL);
+    if (_hThread)
+        return true;
+
+    // on error
+    CloseHandle(_hOut);
+    _hOut = NULL;
+    return false;
+}
+
+
+/**
+ *  \brief
+ */
+DWORD ReadPipe::Wait(DWORD time_ms)
+{
+    if (!_hThread)
+        return WAIT_OBJECT_0;
+
+    DWORD r = WaitForSingleObject(_hThread, time_ms);
+    if (r != WAIT_TIMEOUT)
+    {
+        CloseHandle(_hOut);
+        _hOut = NULL;
+        CloseHandle(_hThread);
+        _hThread = NULL;
+    }
+
+    return r;
+}
+
+
+/**
+ *  \brief
+ */
+size_t ReadPipe::GetOutputLen()
+{
+    if (_hThread)
+        Wait(INFINITE);
+
+    return _outputLen;
+}
+
+
+/**
+ *  \brief  Hands over the output chunks as they are - no data is copied
+ */
+void ReadPipe::MoveOutput(Output& dst)
+{
+    if (_hThread)
+        Wait(INFINITE);
+
+    dst.Release();
+
+    dst._chunks.swap(_chunks);
+    dst._len = _outputLen;
+
+    _outputLen = 0;
+}
+
+
+/**
+ *  \brief  Gathers the output chunks into dst (zero terminated) releasing them as they are copied
+ */
+void ReadPipe::MoveOutput(std::vector<char>& dst)
+{
+    Output output;
+    MoveOutput(output);
+
+    dst.clear();
+    output.AppendTo(dst);
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::releaseChunks()
+{
+    for (Chunk* chunk : _chunks)
+        freeChunk(chunk);
+
+    _chunks.clear();
+    _outputLen = 0;
+}
+
+
+/**
+ *  \brief
+ */
+unsigned __stdcall ReadPipe::threadFunc(void* data)
+{
+    return static_cast<ReadPipe*>(data)->thread();
+}
+
+
+/**
+ *  \brief
+ */
+unsigned ReadPipe::thread()
+{
+    const bool limited = (_linesToSkip || _linesLimit || _bytesLimit);
+
+    Chunk* chunk = NULL;
+    DWORD bytesRead = 0;
+
+    for (;;)
+    {
+        if (!chunk || chunk->len == cChunkSize)
+        {
+            chunk = allocChunk();
+            if (!chunk)
+                break;
+
+            _chunks.push_back(chunk);
+        }
+
+        if (!ReadFile(_hOut, chunk->data + chunk->len, cChunkSize - chunk->len, &bytesRead, NULL))
+            break;
+
+        if (bytesRead)
+        {
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+
+            _lastReadTime = now.QuadPart;
+            if (!_firstReadTime)
+                _firstReadTime = _lastReadTime;
+
+#ifdef DEVEL
+            if (_capture)
+            {
+                _captureReads.push_back({_lastReadTime, _captureData.size(), (unsigned)bytesRead});
+                _captureData.insert(_captureData.end(), chunk->data + chunk->len, chunk->data + chunk->len + bytesRead);
+            }
+#endif
+        }
+
+        if (limited)
+            bytesRead = applyLimits(chunk->data + chunk->len, bytesRead);
+
+        chunk->len += bytesRead;
+        _outputLen += bytesRead;
+
+        if (_limitReached)
+        {
+            // Don't leave a partial line at the end of the output
+            trimOutput(_completeLen);
+            return 0;
+        }
+    }
+
+    // Drop the trailing empty chunk
+    if (chunk && !chunk->len)
+    {
+        _chunks.pop_back();
+        freeChunk(chunk);
+    }
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Applies the lines and bytes limits on the newly read data
+ *  \return The number of bytes to keep
+ */
+unsigned ReadPipe::applyLimits(char* pData, unsigned len)
+{
+    char* const pEnd = pData + len;
+    char* pLine = pData;
+
+    // Drop the lines already shown by a previous run
+    for (; _linesToSkip && pLine < pEnd; --_linesToSkip)
+    {
+        char* pEol = static_cast<char*>(memchr(pLine, '\n', pEnd - pLine));
+        if (pEol == NULL)
+        {
+            pLine = pEnd;
+            break;
+        }
+
+        pLine = pEol + 1;
+    }
+
+    if (pLine != pData)
+    {
+        len = (unsigned)(pEnd - pLine);
+        if (len)
+            memmove(pData, pLine, len);
+    }
+
+    if (!len)
+        return 0;
+
+    // The limit was hit exactly at the end of the previous data - there is more output. Past the bytes limit
+    // only while the first line is still being read
+    if ((_linesLimit && _linesCount == _linesLimit) || (_bytesLimit && _outputLen >= _bytesLimit && _completeLen))
+    {
+        _limitReached = true;
+        SetEvent(_hLimitReached);
+        return 0;
+    }
+
+    unsigned keepLen = len;
+
+    if (_bytesLimit && _outputLen + len > _bytesLimit)
+    {
+        keepLen = (_outputLen < _bytesLimit) ? (unsigned)(_bytesLimit - _outputLen) : 0;
+
+        // A first line longer than the limit is kept whole - the output would be empty otherwise
+        if (!_completeLen && !memchr(pData, '\n', keepLen))
+        {
+            char* pEol = static_cast<char*>(memchr(pData, '\n', len));
+            keepLen = pEol ? (unsigned)(pEol + 1 - pData) : len;
+        }
+
+        if (keepLen < len)
+        {
+            _limitReached = true;
+            SetEvent(_hLimitReached);
+        }
+    }
+
+    if (_linesLimit)
+    {
+        for (pLine = pData; pLine < pData + keepLen;)
+        {
+            char* pEol = static_cast<char*>(memchr(pLine, '\n', pData + keepLen - pLine));
+            if (pEol == NULL)
+                break;
+
+            pLine = pEol + 1;
+
+            if (++_linesCount == _linesLimit)
+            {
+                if (pLine < pData + len)
+                {
+                    _limitReached = true;
+                    SetEvent(_hLimitReached);
+                }
+
+                // Output ends on a complete line
+                _completeLen = _outputLen + (pLine - pData);
+
+                return (unsigned)(pLine - pData);
+            }
+        }
+    }
+
+    // Remember where the last complete line ends to trim the output there if the bytes budget is hit
+    for (pLine = pData + keepLen; pLine > pData; --pLine)
+    {
+        if (*(pLine - 1) == '\n')
+        {
+            _completeLen = _outputLen + (pLine - pData);
+            break;
+        }
+    }
+
+    return keepLen;
+}
+
+
+/**
+ *  \brief
+ */
+void ReadPipe::trimOutput(size_t len)
+{
+    while (!_chunks.empty() && _outputLen > len)
+    {
+        Chunk* chunk = _chunks.back();
+
+        if (_outputLen - chunk->len >= len)
+        {
+            _outputLen -= chunk->len;
+            _chunks.pop_back();
+            freeChunk(chunk);
+        }
+        else
+        {
+            chunk->len -= (unsigned)(_outputLen - len);
+            _outputLen = len;
+        }
+    }
+}
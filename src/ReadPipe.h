@@ -1,62 +1,162 @@
-/**
- *  \file
- *  \brief  Class that reads piped process output
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2015 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <windows.h>
-#include <vector>
-
-
-/**
- *  \class  ReadPipe
- *  \brief
- */
-class ReadPipe
-{
-public:
-    ReadPipe();
-    ~ReadPipe();
-
-    HANDLE GetInputHandle() { return _hIn; }
-    bool Open();
-    DWORD Wait(DWORD time_ms);
-    std::vector<char>& GetOutput();
-
-private:
-    static const unsigned cChunkSize;
-
-    static unsigned __stdcall threadFunc(void* data);
-
-    ReadPipe(const ReadPipe&);
-    const ReadPipe& operator=(const ReadPipe&);
-
-    unsigned thread();
-
-    BOOL                _ready;
-    HANDLE              _hIn;
-    HANDLE              _hOut;
-    HANDLE              _hThread;
-    std::vector<char>   _output;
-};
+/**
+ *  \file
+ *  \brief  Class that reads piped process output
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2015 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <vector>
+#include "AutoLock.h"
+
+
+/**
+ *  \class  ReadPipe
+ *  \brief
+ */
+class ReadPipe
+{
+private:
+    /**
+     *  \struct  Chunk
+     *  \brief
+     */
+    struct Chunk
+    {
+        unsigned    len;
+        char        data[1];
+    };
+
+public:
+    /**
+     *  \class  Output
+     *  \brief  The read output chunks - moved out of the pipe as they are, the data is copied only if gathered
+     */
+    class Output
+    {
+    public:
+        Output() : _len(0) {}
+        Output(Output&& other) : _chunks(std::move(other._chunks)), _len(other._len) { other._len = 0; }
+        ~Output() { Release(); }
+
+        Output& operator=(Output&& other);
+
+        inline size_t Len() const { return _len; }
+        inline size_t ChunksCount() const { return _chunks.size(); }
+        inline const char* ChunkData(size_t i) const { return _chunks[i]->data; }
+        inline unsigned ChunkLen(size_t i) const { return _chunks[i]->len; }
+
+        void AppendTo(std::vector<char>& dst);
+        void Release();
+
+    private:
+        friend class ReadPipe;
+
+        Output(const Output&) = delete;
+        Output& operator=(const Output&) = delete;
+
+        std::vector<Chunk*> _chunks;
+        size_t              _len;
+    };
+
+    ReadPipe();
+    ~ReadPipe();
+
+    HANDLE GetInputHandle() { return _hIn; }
+    void SetLinesLimit(unsigned skipLines, unsigned maxLines);
+    void SetBytesLimit(size_t maxBytes);
+    bool Open();
+    DWORD Wait(DWORD time_ms);
+
+    size_t GetOutputLen();
+    void MoveOutput(Output& dst);
+    void MoveOutput(std::vector<char>& dst);
+
+    HANDLE GetLimitEvent() const { return _hLimitReached; }
+    bool IsLimitReached() const { return _limitReached; }
+
+    // Performance counter values of the first and last read - 0 if nothing was read
+    LONGLONG GetFirstReadTime() const { return _firstReadTime; }
+    LONGLONG GetLastReadTime() const { return _lastReadTime; }
+
+#ifdef DEVEL
+    /**
+     *  \struct  CaptureRead
+     *  \brief  Raw read as it came from the pipe (before any limits are applied)
+     */
+    struct CaptureRead
+    {
+        LONGLONG    time;
+        size_t      pos;
+        unsigned    len;
+    };
+
+    void EnableCapture() { _capture = true; }
+    const std::vector<CaptureRead>& GetCaptureReads() const { return _captureReads; }
+    const std::vector<char>& GetCaptureData() const { return _captureData; }
+#endif
+
+private:
+    static const unsigned cChunkSize;
+    static const unsigned cMaxPooledChunks;
+
+    static Mutex                PoolLock;
+    static std::vector<Chunk*>  Pool;
+
+    static Chunk* allocChunk();
+    static void freeChunk(Chunk* chunk);
+
+    static unsigned __stdcall threadFunc(void* data);
+
+    ReadPipe(const ReadPipe&);
+    const ReadPipe& operator=(const ReadPipe&);
+
+    unsigned thread();
+    unsigned applyLimits(char* pData, unsigned len);
+    void trimOutput(size_t len);
+    void releaseChunks();
+
+    BOOL                _ready;
+    HANDLE              _hIn;
+    HANDLE              _hOut;
+    HANDLE              _hThread;
+    std::vector<Chunk*> _chunks;
+    size_t              _outputLen;
+    size_t              _completeLen;
+
+    unsigned            _linesToSkip;
+    unsigned            _linesLimit;
+    unsigned            _linesCount;
+    size_t              _bytesLimit;
+    bool                _limitReached;
+    HANDLE              _hLimitReached;
+
+    LONGLONG            _firstReadTime;
+    LONGLONG            _lastReadTime;
+
+#ifdef DEVEL
+    bool                        _capture;
+    std::vector<CaptureRead>    _captureReads;
+    std::vector<char>           _captureData;
+#endif
+};
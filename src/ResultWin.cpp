@@ -1,2363 +1,3437 @@
-/**
- *  \file
- *  \brief  GTags result Scintilla view window
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma comment (lib, "comctl32")
-
-
-#include "ResultWin.h"
-#include "INpp.h"
-#include "DbManager.h"
-#include "DocLocation.h"
-#include "ActivityWin.h"
-#include "Cmd.h"
-#include "CmdEngine.h"
-#include <cstdlib>
-#include <windowsx.h>
-#include <richedit.h>
-#include <commctrl.h>
-#include <vector>
-#include <string>
-#include "Common.h"
-#include "GTags.h"
-#include "NppAPI/dockingResource.h"
-#include "StrUniquenessChecker.h"
-
-
-// Scintilla user defined styles IDs
-enum SciStyles_t
-{
-    SCE_GTAGS_HEADER = 151,
-    SCE_GTAGS_PROJECT_PATH,
-    SCE_GTAGS_FILE,
-    SCE_GTAGS_LINE_NUM,
-    SCE_GTAGS_WORD2SEARCH
-};
-
-
-// Scintilla fold levels
-enum SciFoldLevels_t
-{
-    FILE_HEADER_LVL = SC_FOLDLEVELBASE,
-    RESULT_LVL
-};
-
-
-namespace GTags
-{
-
-const TCHAR ResultWin::cClassName[]         = _T("ResultWin");
-const TCHAR ResultWin::cSearchClassName[]   = _T("ResultSearchWin");
-const int ResultWin::cSearchBkgndColor      = COLOR_INFOBK;
-const unsigned ResultWin::cSearchFontSize   = 10;
-const int ResultWin::cSearchWidth           = 420;
-
-
-std::unique_ptr<ResultWin> ResultWin::RW {nullptr};
-
-HWND        ResultWin::_hSci    = NULL;
-SciFnDirect ResultWin::_sciFunc = NULL;
-sptr_t      ResultWin::_sciPtr  = 0;
-
-
-/**
- *  \brief
- */
-bool ResultWin::Activate()
-{
-    if (RW && TabCtrl_GetItemCount(RW->_hTab))
-    {
-        SetFocus(ResultWin::_hSci);
-        return true;
-    }
-
-    return false;
-};
-
-
-/**
- *  \brief
- */
-intptr_t ResultWin::TabParser::Parse(const CmdPtr_t& cmd)
-{
-    _filesCount = 0;
-    _hits = 0;
-    _headerStatusLen = 0;
-
-    _fileResults.clear();
-
-    // Add the search header - cmd name + search word + project path
-    _buf = cmd->Name();
-    _buf += " \"";
-    _buf += cmd->Tag().C_str();
-    _buf += "\"";
-
-    if (cmd->RegExp() || cmd->IgnoreCase())
-    {
-        _buf += " (";
-
-        if (cmd->RegExp())
-        {
-            _buf += "regexp";
-
-            if (cmd->IgnoreCase())
-                _buf += ", ";
-        }
-
-        if (cmd->IgnoreCase())
-            _buf += "ignore case";
-
-        _buf += ")";
-    }
-
-    _buf += " in \"";
-    _buf += cmd->Db()->GetPath().C_str();
-    _buf += "\"";
-
-    const size_t countsPos = _buf.Len();
-
-    intptr_t res;
-
-    // parsing command result
-    if (cmd->Id() == FIND_FILE)
-    {
-        res = parseFindFile(cmd);
-
-        // Add results sumary in header
-        if (res > 0)
-        {
-            std::string str = " (";
-
-            if (_filesCount == 1)
-            {
-                str += "1 hit)";
-            }
-            else
-            {
-                str += std::to_string(_filesCount);
-                str += " hits)";
-            }
-
-            _headerStatusLen = (int)str.size();
-
-            _buf.Insert(countsPos, str.c_str(), str.size());
-        }
-    }
-    else
-    {
-        res = parseCmd(cmd);
-
-        // Add results sumary in header
-        if (res > 0)
-        {
-            std::string str = " (";
-
-            if (_hits == 1)
-            {
-                str += "1 hit in 1 file)";
-            }
-            else
-            {
-                str += std::to_string(_hits);
-                str += " hits in ";
-
-                if (_filesCount == 1)
-                {
-                    str += "1 file)";
-                }
-                else
-                {
-                    str += std::to_string(_filesCount);
-                    str += " files)";
-                }
-            }
-
-            _headerStatusLen = (int)str.size();
-
-            _buf.Insert(countsPos, str.c_str(), str.size());
-        }
-    }
-
-    return res;
-}
-
-
-/**
- *  \brief
- */
-bool ResultWin::TabParser::filterEntry(const DbConfig& cfg, const char* pEntry, size_t len)
-{
-    if (cfg._usePathFilter)
-    {
-        CPath currentEntry;
-        currentEntry.Append(pEntry, len);
-
-        for (const auto& filter : cfg._pathFilters)
-        {
-            if (filter.IsParentOf(currentEntry))
-                return true;
-        }
-    }
-
-    return false;
-}
-
-
-/**
- *  \brief
- */
-intptr_t ResultWin::TabParser::parseFindFile(const CmdPtr_t& cmd)
-{
-    const char* pSrc = cmd->Result();
-    const char* pEol;
-
-    const DbConfig& cfg = cmd->Db()->GetConfig();
-
-    for (;;)
-    {
-        while (*pSrc == '\n' || *pSrc == '\r' || *pSrc == ' ' || *pSrc == '\t')
-            ++pSrc;
-        if (*pSrc == 0) break;
-
-        pEol = pSrc;
-        while (*pEol != '\n' && *pEol != '\r' && *pEol != 0)
-            ++pEol;
-
-        if (!filterEntry(cfg, pSrc, pEol - pSrc))
-        {
-            _buf += "\n\t";
-            _buf.Append(pSrc, pEol - pSrc);
-
-            addResultFile(pSrc, pEol - pSrc, 0);
-
-            ++_filesCount;
-        }
-
-        pSrc = pEol;
-    }
-
-    return _filesCount;
-}
-
-
-/**
- *  \brief
- */
-intptr_t ResultWin::TabParser::parseCmd(const CmdPtr_t& cmd)
-{
-    bool filterReoccurring = false;
-
-    const DbConfig& cfg = cmd->Db()->GetConfig();
-    if (cmd->Id() == FIND_DEFINITION && cfg._useLibDb)
-    {
-        for (const auto& libPath : cfg._libDbPaths)
-        {
-            if (libPath.IsParentOf(cmd->Db()->GetPath()))
-            {
-                filterReoccurring = true;
-                break;
-            }
-        }
-    }
-
-    StrUniquenessChecker<char> strChecker;
-
-    char*       pSrc = cmd->Result();
-    char*       pIdx;
-
-    const char* pLine;
-    const char* pPreviousFile = NULL;
-    unsigned    previousFileLen = 0;
-    bool        previousFileFiltered = false;
-
-    size_t      previousBufLen;
-
-    intptr_t    line = 0;
-
-    for (;;)
-    {
-        while (*pSrc == '\n' || *pSrc == '\r')
-            ++pSrc;
-        if (*pSrc == 0) break;
-
-        previousBufLen = _buf.Len();
-        pLine = pSrc;
-
-        pIdx = pSrc;
-        while (*pIdx != ':')
-            ++pIdx;
-
-        // Path is absolute (starts with drive letter)
-        if ((pIdx - pSrc == 1) && ((*(pIdx + 1) == '\\') || (*(pIdx + 1) == '/')))
-            while (*++pIdx != ':');
-
-        // add new file name to the UI buffer only if it is different
-        // than the previous one
-        if ((pPreviousFile == NULL) || ((unsigned)(pIdx - pSrc) != previousFileLen) ||
-            strncmp(pSrc, pPreviousFile, previousFileLen))
-        {
-            pPreviousFile = pSrc;
-            previousFileLen = (unsigned)(pIdx - pSrc);
-
-            if (filterEntry(cfg, pPreviousFile, previousFileLen))
-            {
-                previousFileFiltered = true;
-            }
-            else
-            {
-                ++line;
-                _buf += "\n\t";
-                _buf.Append(pPreviousFile, previousFileLen);
-
-                addResultFile(pPreviousFile, previousFileLen, line);
-
-                ++_filesCount;
-
-                previousFileFiltered = false;
-            }
-        }
-
-        if (previousFileFiltered)
-        {
-            while (*pSrc != '\n' && *pSrc != '\r')
-                ++pSrc;
-            continue;
-        }
-
-        pSrc = ++pIdx;
-        while (*pSrc != ':')
-            ++pSrc;
-
-        ++line;
-        _buf += "\n\t\tline ";
-        _buf.Append(pIdx, pSrc - pIdx);
-        _buf += ":\t";
-
-        pIdx = ++pSrc;
-        while (*pIdx == ' ' || *pIdx == '\t')
-            ++pIdx;
-
-        pSrc = pIdx + 1;
-        while (*pSrc != '\n' && *pSrc != '\r')
-            ++pSrc;
-
-        if (pSrc == pIdx + 1)
-            return -1;
-
-        _buf.Append(pIdx, pSrc - pIdx);
-
-        *pSrc++ = 0;
-
-        if (filterReoccurring && !strChecker.IsUnique(pLine))
-            _buf.Resize(previousBufLen);
-        else
-            ++_hits;
-    }
-
-    return _hits;
-}
-
-
-/**
- *  \brief
- */
-ResultWin::Tab::Tab(const CmdPtr_t& cmd) :
-    _cmdId(cmd->Id()), _regExp(cmd->RegExp()), _ignoreCase(cmd->IgnoreCase()),
-    _projectPath(cmd->Db()->GetPath().C_str()), _search(cmd->Tag().C_str()), _currentLine(1), _firstVisibleLine(0),
-    _parser(cmd->Parser()), _dirty(false)
-{
-}
-
-
-/**
- *  \brief
- */
-inline void ResultWin::Tab::SetFolded(intptr_t lineNum)
-{
-    _expandedLines.erase(lineNum);
-}
-
-
-/**
- *  \brief
- */
-inline void ResultWin::Tab::SetAllFolded()
-{
-    _expandedLines.clear();
-}
-
-
-/**
- *  \brief
- */
-inline void ResultWin::Tab::ClearFolded(intptr_t lineNum)
-{
-    _expandedLines.insert(lineNum);
-}
-
-
-/**
- *  \brief
- */
-inline bool ResultWin::Tab::IsFolded(intptr_t lineNum)
-{
-    return (_expandedLines.find(lineNum) == _expandedLines.end());
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::Tab::RestoreView(const Tab& oldTab)
-{
-    _currentLine = oldTab._currentLine;
-    _firstVisibleLine = oldTab._firstVisibleLine;
-
-    if (_cmdId == FIND_FILE)
-        return;
-
-    intptr_t currentLineAdjustment = 0;
-    intptr_t firstVisLineAdjustment = 0;
-
-    intptr_t lastCurrent = 0;
-    intptr_t lastFirst = 0;
-
-    const std::unordered_map<std::string, intptr_t>& newFileRes =
-            dynamic_cast<const TabParser*>(_parser.get())->getFileResults();
-
-    const std::unordered_map<std::string, intptr_t>& oldFileRes =
-            dynamic_cast<const TabParser*>(oldTab._parser.get())->getFileResults();
-
-    for (const auto& oldFile : oldFileRes)
-    {
-        if (oldTab._expandedLines.find(oldFile.second) == oldTab._expandedLines.end())
-            continue;
-
-        const auto newFile = newFileRes.find(oldFile.first);
-        if (newFile == newFileRes.end())
-            continue;
-
-        _expandedLines.insert(newFile->second);
-
-        if (_currentLine >= newFile->second && lastCurrent < newFile->second)
-        {
-            currentLineAdjustment = newFile->second - oldFile.second;
-            lastCurrent = newFile->second;
-        }
-
-        if (_firstVisibleLine >= newFile->second && lastFirst < newFile->second)
-        {
-            firstVisLineAdjustment = newFile->second - oldFile.second;
-            lastFirst = newFile->second;
-        }
-    }
-
-    _currentLine += currentLineAdjustment;
-    _firstVisibleLine += firstVisLineAdjustment;
-}
-
-
-/**
- *  \brief
- */
-HWND ResultWin::Register()
-{
-    if (RW)
-        return NULL;
-
-    WNDCLASS wc         = {0};
-    wc.style            = CS_PARENTDC | CS_HREDRAW | CS_VREDRAW;
-    wc.lpfnWndProc      = wndProc;
-    wc.hInstance        = HMod;
-    wc.hCursor          = LoadCursor(NULL, IDC_ARROW);
-    wc.hbrBackground    = GetSysColorBrush(COLOR_WINDOW);
-    wc.lpszClassName    = cClassName;
-
-    RegisterClass(&wc);
-
-    wc.lpfnWndProc      = searchWndProc;
-    wc.hbrBackground    = GetSysColorBrush(COLOR_BTNFACE);
-    wc.lpszClassName    = cSearchClassName;
-
-    RegisterClass(&wc);
-
-    INITCOMMONCONTROLSEX icex   = {0};
-    icex.dwSize                 = sizeof(icex);
-    icex.dwICC                  = ICC_STANDARD_CLASSES;
-
-    InitCommonControlsEx(&icex);
-
-    // Scintilla uses that, make sure it is not accidentally unloaded
-    LoadLibrary(_T("Riched20.dll"));
-
-    RW = std::make_unique<ResultWin>();
-
-    if (RW->composeWindow() == NULL)
-    {
-        Unregister();
-        return NULL;
-    }
-
-    tTbData data;
-    data.hClient        = RW->_hWnd;
-    data.pszName        = const_cast<TCHAR*>(cPluginName);
-    data.pszAddInfo     = NULL;
-    data.uMask          = DWS_DF_CONT_BOTTOM | DWS_ICONTAB;
-    data.hIconTab       = ( HICON )::LoadImage(HMod, MAKEINTRESOURCE(IDI_PLUGINPANEL),
-                              IMAGE_ICON, 0, 0, LR_LOADTRANSPARENT);
-    data.pszModuleName  = DllPath.GetFilename();
-    data.dlgID          = 0;
-
-    INpp& npp = INpp::Get();
-    npp.RegisterDockingWin(data);
-    npp.HideDockingWin(RW->_hWnd);
-
-    return RW->_hWnd;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::Unregister()
-{
-    if (RW)
-        RW = nullptr;
-
-    UnregisterClass(cClassName, HMod);
-    UnregisterClass(cSearchClassName, HMod);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::show()
-{
-    INpp& npp = INpp::Get();
-
-    if (GetFocus() != npp.ReadSciHandle())
-        SetFocus(npp.GetSciHandle());
-    else if (TabCtrl_GetItemCount(_hTab))
-        showWindow();
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::show(const CmdPtr_t& cmd)
-{
-    Tab* tab = new Tab(cmd);
-
-    bool isNewTab = false;
-    HWND hFocus = NULL;
-
-    int i;
-    for (i = TabCtrl_GetItemCount(_hTab); i; --i)
-    {
-        Tab* oldTab = getTab(i - 1);
-
-        if (oldTab && (*tab == *oldTab)) // same search tab already present?
-        {
-            if (_activeTab == oldTab) // is this the currently active tab?
-            {
-                _activeTab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
-                _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
-
-                _activeTab = NULL;
-                hFocus = GetFocus();
-            }
-
-            tab->RestoreView(*oldTab);
-
-            delete oldTab;
-            break;
-        }
-    }
-
-    if (i == 0) // search is completely new - add new tab or visit single result
-    {
-        if (visitSingleResult(tab))
-        {
-            delete tab;
-            return;
-        }
-
-        TCHAR buf[64];
-        _sntprintf_s(buf, _countof(buf), _TRUNCATE, _T("%s \"%s\""), cmd->Name(), cmd->Tag().C_str());
-
-        TCITEM tci  = {0};
-        tci.mask    = TCIF_TEXT | TCIF_PARAM;
-        tci.pszText = buf;
-        tci.lParam  = (LPARAM)tab;
-
-        i = TabCtrl_InsertItem(_hTab, TabCtrl_GetItemCount(_hTab), &tci);
-        if (i == -1)
-        {
-            delete tab;
-            return;
-        }
-
-        isNewTab = true;
-    }
-    else // same search tab exists - reuse it, just update results
-    {
-        TCITEM tci  = {0};
-        tci.mask    = TCIF_PARAM;
-        tci.lParam  = (LPARAM)tab;
-
-        if (!TabCtrl_SetItem(_hTab, --i, &tci))
-        {
-            TabCtrl_DeleteItem(_hTab, i);
-            delete tab;
-            tab = NULL;
-        }
-    }
-
-    if (tab == NULL)
-    {
-        if (_activeTab)
-            return;
-
-        int cnt = TabCtrl_GetItemCount(_hTab);
-        if (cnt == 0)
-        {
-            closeAllTabs();
-            return;
-        }
-
-        if (i > cnt - 1)
-            i = cnt - 1;
-        tab = getTab(i);
-    }
-
-    TabCtrl_SetCurSel(_hTab, i);
-    loadTab(tab, isNewTab);
-
-    showWindow(hFocus);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::close(const CmdPtr_t& cmd)
-{
-    int count = TabCtrl_GetItemCount(_hTab);
-    if (count == 0)
-        return;
-
-    CmdId_t cmdId       = cmd->Id();
-    CTextA  projectPath = cmd->Db()->GetPath().C_str();
-    CTextA  search      = cmd->Tag().C_str();
-
-    for (int i = count; i; --i)
-    {
-        Tab* oldTab = getTab(i - 1);
-
-        if (oldTab && ((cmdId == oldTab->_cmdId) ||
-            ((cmdId == FIND_SYMBOL) && ((oldTab->_cmdId == FIND_DEFINITION) || (oldTab->_cmdId == FIND_REFERENCE)))) &&
-            (projectPath == oldTab->_projectPath) && (search == oldTab->_search)) // same search tab already present?
-        {
-            --i;
-
-            if (_activeTab == oldTab) // is this the currently active tab?
-                _activeTab = NULL;
-            delete oldTab;
-
-            TabCtrl_DeleteItem(_hTab, i);
-
-            if (--count)
-            {
-                i = i ? i - 1 : 0;
-                Tab* tab = getTab(i);
-                TabCtrl_SetCurSel(_hTab, i);
-                if (tab)
-                    loadTab(tab);
-            }
-            else
-            {
-                sendSci(SCI_SETREADONLY, 0);
-                sendSci(SCI_CLEARALL);
-                sendSci(SCI_SETREADONLY, 1);
-
-                hideWindow();
-            }
-
-            return;
-        }
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::reRunCmd()
-{
-    if (!_activeTab)
-        return;
-
-    DbHandle db = getDatabaseAt(CPath(_activeTab->_projectPath.C_str()));
-    if (!db)
-        return;
-
-    ParserPtr_t parser(new ResultWin::TabParser);
-    CmdPtr_t cmd(new Cmd(_activeTab->_cmdId, db, parser, NULL, _activeTab->_ignoreCase, _activeTab->_regExp));
-
-    cmd->Tag(CText(_activeTab->_search.C_str()));
-    CmdEngine::Run(cmd, showResultCB);
-
-    _activeTab->_dirty = false;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::applyStyle()
-{
-    INpp& npp = INpp::Get();
-
-    char font[32];
-    npp.GetFontName(STYLE_DEFAULT, font);
-    int size = npp.GetFontSize(STYLE_DEFAULT);
-    COLORREF caretLineBackColor = npp.GetCaretLineBack();
-    COLORREF foreColor = npp.GetForegroundColor(STYLE_DEFAULT);
-    COLORREF backColor = npp.GetBackgroundColor(STYLE_DEFAULT);
-    COLORREF lineNumColor = npp.GetForegroundColor(STYLE_LINENUMBER);
-
-    COLORREF fileForeColor =
-            RGB(GetRValue(backColor) ^ 0xFF, GetGValue(backColor) ^ 0x7F, GetBValue(backColor) ^ 0x7F);
-    COLORREF findForeColor =
-            RGB(GetRValue(backColor) ^ 0x1C, GetGValue(backColor) ^ 0xFF, GetBValue(backColor) ^ 0xFF);
-
-    HFONT hFont = Tools::CreateFromSystemMenuFont();
-    if (hFont)
-        SendMessage(_hTab, WM_SETFONT, (WPARAM)hFont, TRUE);
-
-    sendSci(SCI_STYLERESETDEFAULT);
-    setStyle(STYLE_DEFAULT, foreColor, backColor, false, false, size, font);
-    sendSci(SCI_STYLECLEARALL);
-
-    setStyle(SCE_GTAGS_HEADER, foreColor, backColor, true);
-    setStyle(SCE_GTAGS_PROJECT_PATH, foreColor, backColor, true, true);
-    setStyle(SCE_GTAGS_FILE, fileForeColor, backColor, true);
-    setStyle(SCE_GTAGS_LINE_NUM, lineNumColor, backColor, false, true);
-    setStyle(SCE_GTAGS_WORD2SEARCH, findForeColor, backColor, true);
-
-    sendSci(SCI_SETCARETLINEBACK, caretLineBackColor);
-    sendSci(SCI_STYLESETHOTSPOT, SCE_GTAGS_WORD2SEARCH, true);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::notifyDBUpdate(const CmdPtr_t& cmd)
-{
-    // TODO: Hardcoded to true for now. Maybe make it a setting in the future
-    const bool alwaysUpdate = true || (cmd->Id() == CREATE_DATABASE);
-
-    const CTextA tag(cmd->Tag().C_str());
-    CTextA lastProjPath;
-
-    std::string updatedFile;
-
-    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
-    {
-        Tab* tab = getTab(i - 1);
-
-        if (alwaysUpdate)
-        {
-            if (CPath(tab->_projectPath.C_str()) == cmd->Db()->GetPath())
-                tab->_dirty = true;
-        }
-        else
-        {
-            if (!(lastProjPath == tab->_projectPath))
-            {
-                lastProjPath = tab->_projectPath;
-
-                if (!(CPath(tab->_projectPath.C_str()) == cmd->Db()->GetPath()))
-                    continue;
-
-                if (tag.Len() <= tab->_projectPath.Len())
-                    continue;
-
-                updatedFile = tag.C_str() + tab->_projectPath.Len();
-
-                size_t j = 0;
-                while ((j = updatedFile.find('\\', j)) != std::string::npos)
-                    updatedFile[j] = '/';
-            }
-
-            const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
-
-            if (parser->isFileInResults(updatedFile))
-                tab->_dirty = true;
-        }
-    }
-
-    if (_activeTab && _activeTab->_dirty)
-        reRunCmd();
-}
-
-
-/**
- *  \brief
- */
-ResultWin::~ResultWin()
-{
-    if (_hWnd)
-    {
-        closeAllTabs();
-
-        SendMessage(_hWnd, WM_CLOSE, 0, 0);
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::setStyle(int style, COLORREF fore, COLORREF back, bool bold, bool italic, int size, const char *font)
-{
-    sendSci(SCI_STYLESETEOLFILLED, style, 1);
-    sendSci(SCI_STYLESETFORE, style, fore);
-    sendSci(SCI_STYLESETBACK, style, back);
-    sendSci(SCI_STYLESETBOLD, style, bold);
-    sendSci(SCI_STYLESETITALIC, style, italic);
-
-    if (size >= 1)
-        sendSci(SCI_STYLESETSIZE, style, size);
-    if (font)
-        sendSci(SCI_STYLESETFONT, style, reinterpret_cast<LPARAM>(font));
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::configScintilla()
-{
-    sendSci(SCI_SETCODEPAGE, SC_CP_UTF8);
-    sendSci(SCI_SETEOLMODE, SC_EOL_CRLF);
-    sendSci(SCI_USEPOPUP, false);
-    sendSci(SCI_SETUNDOCOLLECTION, false);
-    sendSci(SCI_SETCARETSTYLE, CARETSTYLE_LINE);
-    sendSci(SCI_SETCARETLINEVISIBLE, true);
-    sendSci(SCI_SETCARETLINEVISIBLEALWAYS, true);
-    sendSci(SCI_SETHOTSPOTACTIVEUNDERLINE, false);
-
-    sendSci(SCI_SETWRAPMODE, SC_WRAP_WORD);
-    sendSci(SCI_SETWRAPVISUALFLAGS, SC_WRAPVISUALFLAG_START);
-    sendSci(SCI_SETWRAPVISUALFLAGSLOCATION, SC_WRAPVISUALFLAGLOC_DEFAULT);
-    sendSci(SCI_SETWRAPINDENTMODE, SC_WRAPINDENT_FIXED);
-    sendSci(SCI_SETWRAPSTARTINDENT, 24);
-    sendSci(SCI_SETLAYOUTCACHE, SC_CACHE_CARET);
-
-    // Implement lexer in the container
-    sendSci(SCI_SETILEXER, 0, (LPARAM)NULL);
-
-    ApplyStyle();
-
-    sendSci(SCI_SETPROPERTY, reinterpret_cast<WPARAM>("fold"), reinterpret_cast<LPARAM>("1"));
-
-    sendSci(SCI_SETMARGINTYPEN, 1, SC_MARGIN_SYMBOL);
-    sendSci(SCI_SETMARGINMASKN, 1, SC_MASK_FOLDERS);
-    sendSci(SCI_SETMARGINWIDTHN, 1, 20);
-    sendSci(SCI_SETFOLDMARGINCOLOUR, 1, cBlack);
-    sendSci(SCI_SETFOLDMARGINHICOLOUR, 1, cBlack);
-    sendSci(SCI_SETMARGINSENSITIVEN, 1, true);
-    sendSci(SCI_SETFOLDFLAGS, 0);
-
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDER, SC_MARK_BOXPLUS);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEROPEN, SC_MARK_BOXMINUS);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEREND, SC_MARK_BOXPLUSCONNECTED);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERSUB, SC_MARK_VLINE);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERTAIL, SC_MARK_LCORNER);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERMIDTAIL, SC_MARK_TCORNER);
-    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEROPENMID, SC_MARK_BOXMINUSCONNECTED);
-}
-
-
-/**
- *  \brief
- */
-HWND ResultWin::composeWindow()
-{
-    INpp& npp = INpp::Get();
-    HWND hOwner = npp.GetHandle();
-
-    DWORD style = WS_POPUP | WS_CAPTION | WS_SIZEBOX | WS_CLIPCHILDREN;
-
-    _hWnd = CreateWindow(cClassName, cPluginName, style,
-            0, 0, 10, 10, hOwner, NULL, HMod, NULL);
-    if (_hWnd == NULL)
-        return NULL;
-
-    npp.RegisterWinForDarkMode(_hWnd);
-
-    if (!_hSci)
-    {
-        _hSci = npp.CreateSciHandle(_hWnd);
-        if (_hSci)
-        {
-            _sciFunc    = (SciFnDirect)::SendMessage(_hSci, SCI_GETDIRECTFUNCTION, 0, 0);
-            _sciPtr     = (sptr_t)::SendMessage(_hSci, SCI_GETDIRECTPOINTER, 0, 0);
-        }
-    }
-
-    if (_hSci == NULL || _sciFunc == NULL || _sciPtr == 0)
-    {
-        SendMessage(_hWnd, WM_CLOSE, 0, 0);
-        _hWnd = NULL;
-        _hSci = NULL;
-        return NULL;
-    }
-
-    _hTab = CreateWindowEx(0, WC_TABCONTROL, NULL,
-            WS_CHILD | WS_VISIBLE | TCS_BUTTONS | TCS_FOCUSNEVER,
-            0, 0, 10, 10, _hWnd, NULL, HMod, NULL);
-
-    configScintilla();
-
-    ShowWindow(_hSci, SW_SHOWNORMAL);
-
-    return _hWnd;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::createSearchWindow()
-{
-    if (_hSearch)
-    {
-        SetFocus(_hSearchTxt);
-        Edit_SetSel(_hSearchTxt, 0, -1);
-        return;
-    }
-
-    const DWORD styleEx = WS_EX_WINDOWEDGE | WS_EX_TOOLWINDOW;
-    const DWORD style   = WS_POPUP | WS_CAPTION;
-
-    CreateWindowEx(styleEx, cSearchClassName, _T("Search in results"), style, 0, 0, 10, 10, _hWnd, NULL, HMod, NULL);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onSearchWindowCreate(HWND hWnd)
-{
-    _hSearch = hWnd;
-
-    INpp::Get().RegisterWinForDarkMode(_hSearch);
-
-    HDC hdc = GetWindowDC(_hSearch);
-
-    _hSearchFont    = Tools::CreateFromSystemMessageFont(hdc, cSearchFontSize);
-    _hBtnFont       = Tools::CreateFromSystemMenuFont(hdc, cSearchFontSize - 1);
-
-    _searchTxtHeight    = Tools::GetFontHeight(hdc, _hSearchFont) + 1;
-    int btnHeight       = Tools::GetFontHeight(hdc, _hBtnFont) + 2;
-
-    ReleaseDC(_hSearch, hdc);
-
-    const DWORD styleTxtEx  = WS_EX_CLIENTEDGE;
-    const DWORD styleTxt    = WS_CHILD | WS_VISIBLE | WS_HSCROLL | ES_AUTOHSCROLL;
-
-    {
-        RECT win { 0, 0, cSearchWidth, _searchTxtHeight };
-        AdjustWindowRectEx(&win, styleTxt, FALSE, styleTxtEx);
-        _searchTxtHeight = win.bottom - win.top;
-    }
-
-    RECT win = Tools::GetWinRect(_hWnd,
-            (DWORD)GetWindowLongPtr(_hSearch, GWL_EXSTYLE), (DWORD)GetWindowLongPtr(_hSearch, GWL_STYLE),
-            cSearchWidth + 1, _searchTxtHeight + btnHeight + 1);
-    RECT ownerWin;
-    GetWindowRect(_hWnd, &ownerWin);
-
-    MoveWindow(_hSearch,
-            ownerWin.right - (win.right - win.left) -
-            GetSystemMetrics(SM_CXSIZEFRAME) - GetSystemMetrics(SM_CXFIXEDFRAME) - GetSystemMetrics(SM_CXVSCROLL),
-            ownerWin.top +
-            GetSystemMetrics(SM_CYSIZEFRAME) + GetSystemMetrics(SM_CYFIXEDFRAME) + GetSystemMetrics(SM_CYSIZE),
-            win.right - win.left, win.bottom - win.top, TRUE);
-
-    GetClientRect(_hSearch, &win);
-
-    int btnWidth = (win.right - win.left - 120) / 3;
-
-    _hRE = CreateWindowEx(0, _T("BUTTON"), _T("RegExp"),
-            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
-            1, 0, btnWidth, btnHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    _hIC = CreateWindowEx(0, _T("BUTTON"), _T("IgnoreCase"),
-            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
-            btnWidth + 1, 0, btnWidth, btnHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    _hWW = CreateWindowEx(0, _T("BUTTON"), _T("WholeWord"),
-            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
-            2 * btnWidth + 1, 0, btnWidth, btnHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    _hUp = CreateWindowEx(0, _T("BUTTON"), _T("Up"),
-            WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-            3 * btnWidth + 1, 0, 60, btnHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    _hDown = CreateWindowEx(0, _T("BUTTON"), _T("Down"),
-            WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
-            3 * btnWidth + 61, 0, 60, btnHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    if (_hBtnFont)
-    {
-        SendMessage(_hRE, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
-        SendMessage(_hIC, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
-        SendMessage(_hWW, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
-        SendMessage(_hUp, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
-        SendMessage(_hDown, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
-    }
-
-    Button_SetCheck(_hRE, _lastRE ? BST_CHECKED : BST_UNCHECKED);
-    Button_SetCheck(_hIC, _lastIC ? BST_CHECKED : BST_UNCHECKED);
-    Button_SetCheck(_hWW, _lastWW ? BST_CHECKED : BST_UNCHECKED);
-
-    _hSearchTxt = CreateWindowEx(styleTxtEx, RICHEDIT_CLASS, NULL, styleTxt,
-            0, btnHeight + 1, win.right - win.left, _searchTxtHeight,
-            _hSearch, NULL, HMod, NULL);
-
-    SendMessage(_hSearchTxt, EM_SETBKGNDCOLOR, 0, GetSysColor(cSearchBkgndColor));
-
-    if (_hSearchFont)
-        SendMessage(_hSearchTxt, WM_SETFONT, (WPARAM)_hSearchFont, TRUE);
-
-    SendMessage(_hSearchTxt, EM_SETEVENTMASK, 0, ENM_REQUESTRESIZE);
-
-    INpp& npp = INpp::Get();
-
-    HWND nppHSci = npp.ReadSciHandle();
-
-    npp.SetSciHandle(_hSci);
-
-    CTextA selectionA;
-    if (!npp.IsSelectionVertical())
-        npp.GetSelectionText(selectionA);
-
-    npp.SetSciHandle(nppHSci);
-
-    if (!selectionA.IsEmpty())
-    {
-        const CText selection(selectionA.C_str());
-
-        Edit_SetText(_hSearchTxt, selection.C_str());
-        Edit_SetSel(_hSearchTxt, 0, -1);
-    }
-    else if (!_lastSearchTxt.IsEmpty())
-    {
-        Edit_SetText(_hSearchTxt, _lastSearchTxt.C_str());
-        Edit_SetSel(_hSearchTxt, 0, -1);
-    }
-    else
-    {
-        Edit_SetText(_hSearchTxt, _T(""));
-    }
-
-    ShowWindow(_hSearch, SW_SHOWNORMAL);
-    SetFocus(_hSearchTxt);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::showWindow(HWND hFocus)
-{
-    Tools::ReleaseKeys();
-
-    INpp::Get().ShowDockingWin(_hWnd);
-
-    ActivityWin::UpdatePositions();
-
-    if (hFocus)
-        SetFocus(hFocus);
-    else
-        SetFocus(_hSci);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::hideWindow()
-{
-    if (_hSearch)
-        SendMessage(_hSearch, WM_CLOSE, 0, 0);
-
-    if (_hKeyHook)
-    {
-        UnhookWindowsHookEx(_hKeyHook);
-        _hKeyHook = NULL;
-    }
-
-    INpp& npp = INpp::Get();
-    npp.HideDockingWin(_hWnd);
-
-    ActivityWin::UpdatePositions();
-
-    if (GetFocus() != npp.ReadSciHandle())
-        SetFocus(npp.GetSciHandle());
-}
-
-
-/**
- *  \brief
- */
-ResultWin::Tab* ResultWin::getTab(int i)
-{
-    if (i == -1)
-    {
-        i = TabCtrl_GetCurSel(_hTab);
-        if (i == -1)
-            return NULL;
-    }
-
-    TCITEM tci  = {0};
-    tci.mask    = TCIF_PARAM;
-
-    if (!TabCtrl_GetItem(_hTab, i, &tci))
-        return NULL;
-
-    return (Tab*)tci.lParam;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::loadTab(ResultWin::Tab* tab, bool firstTimeLoad)
-{
-    // store current view if there is one
-    if (_activeTab)
-    {
-        _activeTab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
-        _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
-    }
-
-    _activeTab = NULL;
-
-    sendSci(SCI_SETREADONLY, 0);
-    sendSci(SCI_CLEARALL);
-
-    _activeTab = tab;
-
-    sendSci(SCI_SETTEXT, 0, reinterpret_cast<LPARAM>(tab->_parser->GetText().C_str()));
-    sendSci(SCI_SETREADONLY, 1);
-
-    sendSci(SCI_GOTOLINE, tab->_currentLine);
-    sendSci(SCI_SETFIRSTVISIBLELINE, tab->_firstVisibleLine);
-
-    if (tab->_dirty)
-    {
-        reRunCmd();
-    }
-    else if (firstTimeLoad && tab->_cmdId != FIND_FILE)
-    {
-        const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
-
-        if (parser->getFilesCount() == 1)
-            foldAll(SC_FOLDACTION_EXPAND);
-    }
-}
-
-
-/**
- *  \brief
- */
-bool ResultWin::visitSingleResult(ResultWin::Tab* tab)
-{
-    const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
-
-    if (parser->getHitsCount() != 1)
-        return false;
-
-    intptr_t line = -1;
-
-    if (tab->_cmdId != FIND_FILE)
-    {
-        const std::string results(parser->GetText().C_str());
-
-        const size_t pos = results.rfind("\t\tline ");
-        if (pos != std::string::npos)
-        {
-            const std::string lineNum = results.substr(pos + 7);
-            line = (intptr_t)std::stoll(lineNum) - 1;
-        }
-    }
-
-    CPath file;
-
-    // Path is not absolute (does not start with drive letter)
-    if ((parser->getFirstFileResult().c_str()[0] != '/') && (parser->getFirstFileResult().c_str()[1] != ':'))
-        file = tab->_projectPath.C_str();
-
-    file += parser->getFirstFileResult().c_str();
-    file.NormalizePathSlashes();
-
-    INpp& npp = INpp::Get();
-    if (!file.FileExists())
-    {
-        MessageBox(npp.GetHandle(),
-                _T("File not found, database seems outdated.")
-                _T("\nPlease re-create it and redo the search."),
-                cPluginName, MB_OK | MB_ICONEXCLAMATION);
-        return true;
-    }
-
-    CPath currentFile;
-    npp.GetFilePathFromBufID(npp.getCurrentBuffId(), currentFile);
-
-    bool sameLine = false;
-    bool sameLocation = false;
-
-    // if already there just return
-    if (currentFile == file)
-    {
-        if (tab->_cmdId == FIND_FILE)
-            return true;
-
-        sameLine = npp.GetCurrentLine() == line;
-        sameLocation = npp.IsLineVisible(line);
-    }
-
-    if (!sameLocation)
-    {
-        Tools::ReleaseKeys();
-
-        npp.ClearSelectionMulti();
-
-        DocLocation::Get().Push();
-        npp.OpenFile(file.C_str());
-    }
-
-    if (tab->_cmdId == FIND_FILE)
-        return true;
-
-    const bool wholeWord    = (tab->_cmdId != GREP && tab->_cmdId != GREP_TEXT);
-    intptr_t findBegin      = npp.PositionFromLine(line);
-    intptr_t findEnd        = npp.LineEndPosition(line);
-
-    if (!npp.SearchText(tab->_search.C_str(), tab->_ignoreCase, wholeWord, tab->_regExp,
-        &findBegin, &findEnd, sameLocation))
-    {
-        MessageBox(npp.GetHandle(),
-                _T("Look-up mismatch, database seems outdated.")
-                _T("\nSave all modified files, re-create it and redo the search."),
-                cPluginName, MB_OK | MB_ICONEXCLAMATION);
-    }
-    else if (sameLocation && sameLine)
-    {
-        Sleep(50);
-        npp.ClearSelectionMulti();
-    }
-
-    return true;
-}
-
-
-/**
- *  \brief
- */
-bool ResultWin::openItem(intptr_t lineNum, unsigned matchNum)
-{
-    Tools::ReleaseKeys();
-
-    intptr_t lineLen = sendSci(SCI_GETCURRENTPOS, 0, 0);
-    sendSci(SCI_SETSEL, lineLen, lineLen);
-
-    lineLen = sendSci(SCI_LINELENGTH, lineNum);
-    if (lineLen <= 0)
-        return false;
-
-    std::vector<char> lineTxt;
-    lineTxt.resize(lineLen + 1, 0);
-
-    sendSci(SCI_GETLINE, lineNum, reinterpret_cast<LPARAM>(lineTxt.data()));
-
-    intptr_t line = 0;
-    intptr_t i;
-
-    if (_activeTab->_cmdId != FIND_FILE)
-    {
-        for (i = 7; i <= lineLen && lineTxt[i] != ':'; ++i);
-        lineTxt[i] = 0;
-        line = (intptr_t)strtoll(&lineTxt[7], nullptr, 10) - 1;
-
-        lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
-        if (lineNum == -1)
-            return false;
-
-        lineLen = sendSci(SCI_LINELENGTH, lineNum);
-        if (lineLen <= 0)
-            return false;
-
-        lineTxt.resize(lineLen + 1, 0);
-        sendSci(SCI_GETLINE, lineNum, reinterpret_cast<LPARAM>(lineTxt.data()));
-    }
-
-    for (i = 1; (i <= lineLen) && (lineTxt[i] != '\r') && (lineTxt[i] != '\n'); ++i);
-    lineTxt[i] = 0;
-
-    CPath file;
-
-    // Path is not absolute (does not start with drive letter)
-    if ((lineLen < 5) || ((lineTxt[1] != '/') && (lineTxt[2] != ':')))
-        file = _activeTab->_projectPath.C_str();
-
-    file += &lineTxt[1];
-    file.NormalizePathSlashes();
-
-    INpp& npp = INpp::Get();
-    if (!file.FileExists())
-    {
-        MessageBox(npp.GetHandle(),
-                _T("File not found, present results are outdated.")
-                _T("\nPlease re-create database and redo the search."),
-                cPluginName, MB_OK | MB_ICONEXCLAMATION);
-        return false;
-    }
-
-    CPath currentFile;
-    npp.GetFilePathFromBufID(npp.getCurrentBuffId(), currentFile);
-
-    bool sameLocation = false;
-
-    // if already there just return
-    if (currentFile == file)
-    {
-        if (_activeTab->_cmdId == FIND_FILE)
-            return true;
-
-        sameLocation = npp.IsLineVisible(line);
-    }
-
-    if (!sameLocation)
-    {
-        Tools::ReleaseKeys();
-
-        npp.ClearSelectionMulti();
-
-        DocLocation::Get().Push();
-        npp.OpenFile(file.C_str());
-    }
-
-    if (_activeTab->_cmdId == FIND_FILE)
-        return true;
-
-    const intptr_t endPos = npp.LineEndPosition(line);
-
-    const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
-
-    // Highlight the corresponding match number if there are more than one
-    // matches on single result line
-    for (intptr_t findBegin = npp.PositionFromLine(line), findEnd = endPos;
-        matchNum; findBegin = findEnd, findEnd = endPos, --matchNum)
-    {
-        if (!npp.SearchText(_activeTab->_search.C_str(), _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp,
-                &findBegin, &findEnd, sameLocation))
-        {
-            MessageBox(npp.GetHandle(),
-                    _T("Look-up mismatch, present results are outdated.")
-                    _T("\nSave all modified files and redo the search."),
-                    cPluginName, MB_OK | MB_ICONEXCLAMATION);
-            return false;
-        }
-        else if (sameLocation)
-        {
-            SetFocus(npp.GetSciHandle());
-        }
-    }
-
-    return true;
-}
-
-
-/**
- *  \brief
- */
-bool ResultWin::findString(const char* str, intptr_t* startPos, intptr_t* endPos,
-    bool ignoreCase, bool wholeWord, bool regExp)
-{
-    int searchFlags = 0;
-    if (!ignoreCase)
-        searchFlags |= SCFIND_MATCHCASE;
-    if (wholeWord)
-        searchFlags |= SCFIND_WHOLEWORD;
-    if (regExp)
-        searchFlags |= (SCFIND_REGEXP | SCFIND_POSIX);
-
-    sendSci(SCI_SETSEARCHFLAGS, searchFlags);
-    sendSci(SCI_SETTARGETSTART, *startPos);
-    sendSci(SCI_SETTARGETEND, *endPos);
-
-    if (sendSci(SCI_SEARCHINTARGET, strlen(str), reinterpret_cast<LPARAM>(str)) >= 0)
-    {
-        *startPos = sendSci(SCI_GETTARGETSTART);
-        *endPos = sendSci(SCI_GETTARGETEND);
-        return true;
-    }
-
-    return false;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::toggleFolding(intptr_t lineNum)
-{
-    sendSci(SCI_GOTOLINE, lineNum);
-    sendSci(SCI_TOGGLEFOLD, lineNum);
-
-    if (sendSci(SCI_GETFOLDEXPANDED, lineNum))
-        _activeTab->ClearFolded(lineNum);
-    else
-        _activeTab->SetFolded(lineNum);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::foldAll(int foldAction)
-{
-    sendSci(SCI_FOLDALL, foldAction);
-
-    const intptr_t linesCount = sendSci(SCI_GETLINECOUNT);
-
-    intptr_t lineNum = 1;
-    for (; lineNum < linesCount && !(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG); ++lineNum);
-
-    if (lineNum == linesCount)
-        return;
-
-    if (sendSci(SCI_GETFOLDEXPANDED, lineNum))
-    {
-        for (; lineNum < linesCount; ++lineNum)
-        {
-            if (sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG)
-            {
-                _activeTab->ClearFolded(lineNum);
-            }
-        }
-    }
-    else
-    {
-        _activeTab->SetAllFolded();
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onStyleNeeded(SCNotification* notify)
-{
-    if (_activeTab == NULL)
-        return;
-
-    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETENDSTYLED));
-    const intptr_t endStylingPos = notify->position;
-
-    for (intptr_t startPos = sendSci(SCI_POSITIONFROMLINE, lineNum); endStylingPos > startPos;
-            startPos = sendSci(SCI_POSITIONFROMLINE, ++lineNum))
-    {
-        const intptr_t lineLen = sendSci(SCI_LINELENGTH, lineNum);
-        if (lineLen <= 0)
-            continue;
-
-        const intptr_t endPos = startPos + lineLen;
-
-        sendSci(SCI_STARTSTYLING, startPos, 0xFF);
-
-        if ((char)sendSci(SCI_GETCHARAT, startPos) != '\t')
-        {
-            size_t pathLen = _activeTab->_projectPath.Len();
-            const TabParser* parser = dynamic_cast<TabParser*>(_activeTab->_parser.get());
-
-            // 2 * '"' + LF + CR = 4 so length to style is modified with -4 and +1 (as it is length)
-            sendSci(SCI_SETSTYLING, lineLen - pathLen - parser->getHeaderStatusLen() - 3, SCE_GTAGS_HEADER);
-            sendSci(SCI_SETSTYLING, pathLen + 2, SCE_GTAGS_PROJECT_PATH);
-            sendSci(SCI_SETSTYLING, parser->getHeaderStatusLen(), SCE_GTAGS_HEADER);
-        }
-        else
-        {
-            if ((char)sendSci(SCI_GETCHARAT, startPos + 1) != '\t')
-            {
-                if (_activeTab->_cmdId == FIND_FILE)
-                {
-                    intptr_t findBegin = startPos;
-                    intptr_t findEnd = endPos;
-
-                    if (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
-                        _activeTab->_ignoreCase, false, _activeTab->_regExp))
-                    {
-                        // Highlight all matches in a single result line
-                        do
-                        {
-                            if (findBegin - startPos)
-                                sendSci(SCI_SETSTYLING, findBegin - startPos, SCE_GTAGS_FILE);
-
-                            sendSci(SCI_SETSTYLING, findEnd - findBegin, SCE_GTAGS_WORD2SEARCH);
-
-                            findBegin = startPos = findEnd;
-                            findEnd = endPos;
-                        }
-                        while (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
-                                _activeTab->_ignoreCase, false, _activeTab->_regExp));
-
-                        if (endPos - startPos)
-                            sendSci(SCI_SETSTYLING, endPos - startPos, SCE_GTAGS_FILE);
-                    }
-                    else
-                    {
-                        sendSci(SCI_SETSTYLING, lineLen, SCE_GTAGS_FILE);
-                    }
-                }
-                else
-                {
-                    sendSci(SCI_SETSTYLING, lineLen, SCE_GTAGS_FILE);
-                    sendSci(SCI_SETFOLDLEVEL, lineNum, FILE_HEADER_LVL | SC_FOLDLEVELHEADERFLAG);
-
-                    if (_activeTab->IsFolded(lineNum))
-                        sendSci(SCI_FOLDLINE, lineNum, SC_FOLDACTION_CONTRACT);
-                }
-            }
-            else
-            {
-                // "\t\tline: Num" - 'N' is at position 8
-                intptr_t previewPos = startPos + 8;
-                for (; (char)sendSci(SCI_GETCHARAT, previewPos) != '\t'; ++previewPos);
-
-                intptr_t findBegin = previewPos;
-                intptr_t findEnd = endPos;
-
-                const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
-
-                if (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
-                    _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp))
-                {
-                    sendSci(SCI_SETSTYLING, previewPos - startPos, SCE_GTAGS_LINE_NUM);
-
-                    // Highlight all matches in a single result line
-                    do
-                    {
-                        if (findBegin - previewPos)
-                            sendSci(SCI_SETSTYLING, findBegin - previewPos, STYLE_DEFAULT);
-
-                        sendSci(SCI_SETSTYLING, findEnd - findBegin, SCE_GTAGS_WORD2SEARCH);
-
-                        findBegin = previewPos = findEnd;
-                        findEnd = endPos;
-                    }
-                    while (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
-                            _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp));
-
-                    if (endPos - previewPos)
-                        sendSci(SCI_SETSTYLING, endPos - previewPos, STYLE_DEFAULT);
-                }
-                else
-                {
-                    sendSci(SCI_SETSTYLING, lineLen, STYLE_DEFAULT);
-                }
-
-                sendSci(SCI_SETFOLDLEVEL, lineNum, RESULT_LVL);
-            }
-        }
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onNewPosition()
-{
-    const intptr_t pos = sendSci(SCI_GETCURRENTPOS);
-
-    if (pos == sendSci(SCI_POSITIONAFTER, pos)) // end of document
-    {
-        const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, sendSci(SCI_LINEFROMPOSITION, pos));
-        if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
-            sendSci(SCI_GOTOLINE, foldLine);
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onHotspotClick(SCNotification* notify)
-{
-    const intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
-    unsigned matchNum = 1;
-
-    if (_activeTab->_cmdId != FIND_FILE)
-    {
-        const intptr_t endLine = sendSci(SCI_GETLINEENDPOSITION, lineNum);
-
-        // "\t\tline: Num" - 'N' is at position 8
-        intptr_t findBegin = sendSci(SCI_POSITIONFROMLINE, lineNum) + 8;
-        for (; (char)sendSci(SCI_GETCHARAT, findBegin) != '\t'; ++findBegin);
-
-        const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
-
-        // Find which hotspot was clicked in case there are more than one
-        // matches on single result line
-        for (intptr_t findEnd = endLine; findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
-                    _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp);
-                findBegin = findEnd, findEnd = endLine, ++matchNum)
-            if (notify->position >= findBegin && notify->position <= findEnd)
-                break;
-    }
-
-    openItem(lineNum, matchNum);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onDoubleClick(intptr_t pos)
-{
-    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
-
-    if (lineNum == 0)
-    {
-        pos = sendSci(SCI_GETCURRENTPOS);
-        if (pos == sendSci(SCI_POSITIONAFTER, pos)) // end of document
-        {
-            lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
-            const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
-            if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
-            {
-                lineNum = foldLine;
-                pos = sendSci(SCI_POSITIONFROMLINE, lineNum);
-            }
-        }
-        else
-        {
-            lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
-        }
-    }
-
-    if (lineNum == 0)
-    {
-        sendSci(SCI_GOTOLINE, 0); // Clear double click selection
-        foldAll(SC_FOLDACTION_TOGGLE);
-    }
-    else if (lineNum > 0)
-    {
-        if (sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG)
-            toggleFolding(lineNum);
-        else
-            openItem(lineNum);
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onMarginClick(SCNotification* notify)
-{
-    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
-
-    if (lineNum == 0)
-    {
-        foldAll(SC_FOLDACTION_TOGGLE);
-    }
-    else
-    {
-        if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
-            lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
-
-        if (lineNum > 0)
-        {
-            toggleFolding(lineNum);
-        }
-        else
-        {
-            lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
-            sendSci(SCI_GOTOLINE, lineNum);
-        }
-    }
-}
-
-
-/**
- *  \brief
- */
-bool ResultWin::onKeyPress(WORD keyCode, bool alt)
-{
-    const intptr_t currentPos = sendSci(SCI_GETCURRENTPOS);
-    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, currentPos);
-
-    switch (keyCode)
-    {
-        case VK_UP:
-        {
-            intptr_t linePosOffset = currentPos - sendSci(SCI_POSITIONFROMLINE, lineNum);
-
-            if (--lineNum >= 0)
-            {
-                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
-                {
-                    const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
-                    if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
-                        lineNum = foldLine;
-                }
-
-                const intptr_t lineStart = sendSci(SCI_POSITIONFROMLINE, lineNum);
-                const intptr_t lineEnd = sendSci(SCI_GETLINEENDPOSITION, lineNum);
-
-                if (linePosOffset > lineEnd - lineStart)
-                    linePosOffset = lineEnd - lineStart;
-
-                sendSci(SCI_GOTOPOS, lineStart + linePosOffset);
-            }
-        }
-        return true;
-
-        case VK_DOWN:
-        {
-            intptr_t linePosOffset = currentPos - sendSci(SCI_POSITIONFROMLINE, lineNum);
-
-            if (++lineNum < sendSci(SCI_GETLINECOUNT))
-            {
-                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
-                {
-                    const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
-                    if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
-                    {
-                        const intptr_t nextFold =
-                                sendSci(SCI_GETLASTCHILD, foldLine, sendSci(SCI_GETFOLDLEVEL, foldLine)) + 1;
-                        lineNum = (nextFold < sendSci(SCI_GETLINECOUNT)) ? nextFold : foldLine;
-                    }
-                }
-
-                const intptr_t lineStart = sendSci(SCI_POSITIONFROMLINE, lineNum);
-                const intptr_t lineEnd = sendSci(SCI_GETLINEENDPOSITION, lineNum);
-
-                if (linePosOffset > lineEnd - lineStart)
-                    linePosOffset = lineEnd - lineStart;
-
-                sendSci(SCI_GOTOPOS, lineStart + linePosOffset);
-            }
-        }
-        return true;
-
-        case VK_LEFT:
-            if (alt)
-            {
-                int i = TabCtrl_GetCurSel(_hTab);
-
-                if (i > 0)
-                {
-                    Tab* tab = getTab(--i);
-                    if (tab)
-                    {
-                        TabCtrl_SetCurSel(_hTab, i);
-                        loadTab(tab);
-                    }
-                }
-
-                return true;
-            }
-        break;
-
-        case VK_RIGHT:
-            if (alt)
-            {
-                int i = TabCtrl_GetCurSel(_hTab);
-
-                if (i < TabCtrl_GetItemCount(_hTab) - 1)
-                {
-                    Tab* tab = getTab(++i);
-                    if (tab)
-                    {
-                        TabCtrl_SetCurSel(_hTab, i);
-                        loadTab(tab);
-                    }
-                }
-
-                return true;
-            }
-        break;
-
-        case VK_PRIOR:
-        {
-            const intptr_t linesOnScreen = sendSci(SCI_LINESONSCREEN);
-            sendSci(SCI_LINESCROLL, 0, -linesOnScreen);
-            lineNum = sendSci(SCI_DOCLINEFROMVISIBLE, sendSci(SCI_GETFIRSTVISIBLELINE));
-            sendSci(SCI_GOTOLINE, lineNum);
-        }
-        return true;
-
-        case VK_NEXT:
-        {
-            const intptr_t linesOnScreen     = sendSci(SCI_LINESONSCREEN);
-            const intptr_t firstVisibleLine  = sendSci(SCI_GETFIRSTVISIBLELINE);
-            sendSci(SCI_LINESCROLL, 0, linesOnScreen);
-            const intptr_t newFirstVisible   = sendSci(SCI_GETFIRSTVISIBLELINE);
-
-            if (newFirstVisible - firstVisibleLine >= linesOnScreen)
-            {
-                lineNum = sendSci(SCI_DOCLINEFROMVISIBLE, newFirstVisible);
-            }
-            else
-            {
-                lineNum = sendSci(SCI_GETLINECOUNT) - 1;
-                const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
-                if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
-                    lineNum = foldLine;
-            }
-
-            sendSci(SCI_GOTOLINE, lineNum);
-        }
-        return true;
-
-        case VK_ADD:
-            if (alt || lineNum == 0)
-            {
-                foldAll(SC_FOLDACTION_EXPAND);
-            }
-            else
-            {
-                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
-                    lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
-                if (lineNum > 0 && !sendSci(SCI_GETFOLDEXPANDED, lineNum))
-                    toggleFolding(lineNum);
-            }
-        return true;
-
-        case VK_SUBTRACT:
-            if (alt || lineNum == 0)
-            {
-                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG) && lineNum)
-                {
-                    const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
-                    if (foldLine > 0)
-                        sendSci(SCI_GOTOLINE, foldLine);
-                }
-                foldAll(SC_FOLDACTION_CONTRACT);
-            }
-            else
-            {
-                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
-                    lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
-                if (lineNum > 0 && sendSci(SCI_GETFOLDEXPANDED, lineNum))
-                    toggleFolding(lineNum);
-            }
-        return true;
-
-        default:;
-    }
-
-    return false;
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onTabChange()
-{
-    Tab* tab = getTab();
-    if (tab)
-        loadTab(tab);
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onCloseTab()
-{
-    int i = TabCtrl_GetCurSel(_hTab);
-
-    if (_activeTab)
-    {
-        delete _activeTab;
-        _activeTab = NULL;
-    }
-
-    TabCtrl_DeleteItem(_hTab, i);
-
-    if (TabCtrl_GetItemCount(_hTab))
-    {
-        i = i ? i - 1 : 0;
-        Tab* tab = getTab(i);
-        TabCtrl_SetCurSel(_hTab, i);
-        if (tab)
-            loadTab(tab);
-    }
-    else
-    {
-        sendSci(SCI_SETREADONLY, 0);
-        sendSci(SCI_CLEARALL);
-        sendSci(SCI_SETREADONLY, 1);
-
-        hideWindow();
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::closeAllTabs()
-{
-    _activeTab = NULL;
-
-    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
-    {
-        Tab* tab = getTab(i - 1);
-        if (tab)
-            delete tab;
-        TabCtrl_DeleteItem(_hTab, i - 1);
-    }
-
-    sendSci(SCI_SETREADONLY, 0);
-    sendSci(SCI_CLEARALL);
-    sendSci(SCI_SETREADONLY, 1);
-
-    hideWindow();
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onResize(int width, int height)
-{
-    RECT win = {0, 0, width, height};
-
-    MoveWindow(_hTab, 0, 0, width, height, TRUE);
-    TabCtrl_AdjustRect(_hTab, FALSE, &win);
-    MoveWindow(_hSci, win.left, win.top, win.right - win.left, win.bottom - win.top, TRUE);
-
-    onMove();
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onMove()
-{
-    if (_hSearch)
-    {
-        RECT ownerWin;
-        GetWindowRect(_hWnd, &ownerWin);
-
-        RECT win;
-        GetWindowRect(_hSearch, &win);
-
-        RECT txtWin;
-        GetWindowRect(_hSearchTxt, &txtWin);
-
-        const int hScrollSize =
-                (GetWindowLongPtr(_hSearchTxt, GWL_STYLE) & WS_HSCROLL) ? GetSystemMetrics(SM_CYHSCROLL) : 0;
-
-        MoveWindow(_hSearch,
-                ownerWin.right - (win.right - win.left) -
-                GetSystemMetrics(SM_CXSIZEFRAME) - GetSystemMetrics(SM_CXFIXEDFRAME) - GetSystemMetrics(SM_CXVSCROLL),
-                ownerWin.top +
-                GetSystemMetrics(SM_CYSIZEFRAME) + GetSystemMetrics(SM_CYFIXEDFRAME) + GetSystemMetrics(SM_CYSIZE),
-                win.right - win.left,
-                win.bottom - win.top - (txtWin.bottom - txtWin.top) + _searchTxtHeight + hScrollSize, TRUE);
-
-        GetClientRect(_hSearch, &win);
-
-        MoveWindow(_hSearchTxt,
-                0, win.bottom - _searchTxtHeight - hScrollSize,
-                win.right - win.left, _searchTxtHeight + hScrollSize, TRUE);
-    }
-}
-
-
-/**
- *  \brief
- */
-void ResultWin::onSearch(bool reverseDir, bool keepFocus)
-{
-    if (_hSearch)
-    {
-        _lastRE = (Button_GetCheck(_hRE) == BST_CHECKED);
-        _lastIC = (Button_GetCheck(_hIC) == BST_CHECKED);
-        _lastWW = (Button_GetCheck(_hWW) == BST_CHECKED);
-
-        int txtLen = Edit_GetTextLength(_hSearchTxt);
-        if (txtLen == 0)
-        {
-            SendMessage(_hSearch, WM_CLOSE, 0, 0);
-            SetFocus(_hSci);
-            return;
-        }
-
-        _lastSearchTxt.Resize(txtLen);
-        Edit_GetText(_hSearchTxt, _lastSearchTxt.C_str(), (int)_lastSearchTxt.Size());
-    }
-    else if (_lastSearchTxt.IsEmpty())
-    {
-        return;
-    }
-
-    CTextA txt(_lastSearchTxt.C_str());
-
-    const intptr_t docEnd = sendSci(SCI_GETLENGTH);
-
-    intptr_t startPos = sendSci(SCI_GETCURRENTPOS);
-    intptr_t endPos = docEnd;
-
-    if (reverseDir)
-    {
-        if (startPos)
-            startPos -= 1;
-        else
-            startPos = docEnd;
-
-        endPos = 0;
-    }
-
-    bool found = findString(txt.C_str(), &startPos, &endPos, _lastIC, _lastWW, _lastRE);
-
-    if (!found && ((!reverseDir && startPos) || (reverseDir && startPos != docEnd)))
-    {
-        startPos = reverseDir ? docEnd : 0;
-
-        found = findString(txt.C_str(), &startPos, &endPos, _lastIC, _lastWW, _lastRE);
-
-        FLASHWINFO fi {0};
-        fi.cbSize       = sizeof(fi);
-        fi.hwnd         = INpp::Get().GetHandle();
-        fi.dwFlags      = FLASHW_ALL;
-        fi.uCount       = 3;
-        fi.dwTimeout    = 80;
-
-        FlashWindowEx(&fi);
-    }
-
-    if (found)
-    {
-        if (!keepFocus)
-            SetFocus(_hSci);
-
-        sendSci(SCI_SETSEL, startPos, endPos);
-        sendSci(SCI_ENSUREVISIBLEENFORCEPOLICY, sendSci(SCI_LINEFROMPOSITION, startPos));
-    }
-    else
-    {
-        Edit_SetSel(_hSearchTxt, 0, -1);
-    }
-}
-
-
-/**
- *  \brief
- */
-LRESULT CALLBACK ResultWin::keyHookProc(int code, WPARAM wParam, LPARAM lParam)
-{
-    if (code >= 0)
-    {
-        HWND hWnd = GetFocus();
-
-        if (RW->_hWnd == hWnd || IsChild(RW->_hWnd, hWnd))
-        {
-            const unsigned keyDownMask = (1 << (sizeof(SHORT) * 8 - 1));
-
-            const bool ctrl     = ((GetKeyState(VK_CONTROL) & keyDownMask) != 0);
-            const bool alt      = ((GetKeyState(VK_MENU) & keyDownMask) != 0);
-            const bool shift    = ((GetKeyState(VK_SHIFT) & keyDownMask) != 0);
-
-            // Key is pressed
-            if (!(lParam & (1 << 31)))
-            {
-                if (!ctrl)
-                {
-                    if (!alt)
-                    {
-                        if ((wParam == VK_RETURN && RW->_hSearch) || wParam == VK_F3)
-                        {
-                            RW->onSearch(shift);
-                            return 1;
-                        }
-
-                        if (!shift)
-                        {
-                            if (wParam == VK_ESCAPE)
-                            {
-                                if (RW->_hSearch)
-                                {
-                                    SendMessage(RW->_hSearch, WM_CLOSE, 0, 0);
-                                    SetFocus(ResultWin::_hSci);
-                                }
-                                else
-                                {
-                                    RW->onCloseTab();
-                                }
-
-                                return 1;
-                            }
-                            if (wParam == VK_RETURN || wParam == VK_SPACE)
-                            {
-                                RW->onDoubleClick(0);
-                                return 1;
-                            }
-                            if (wParam == VK_F5)
-                            {
-                                RW->reRunCmd();
-                                return 1;
-                            }
-                        }
-                    }
-
-                    if (!shift && RW->onKeyPress(static_cast<WORD>(wParam), alt))
-                    {
-                        return 1;
-                    }
-                }
-                else if (wParam == 0x46 && !alt && !shift) // 'F'
-                {
-                    RW->createSearchWindow();
-                    return 1;
-                }
-            }
-        }
-        else if (RW->_hSearch && (RW->_hSearch == hWnd || IsChild(RW->_hSearch, hWnd)))
-        {
-            const unsigned keyDownMask = (1 << (sizeof(SHORT) * 8 - 1));
-
-            const bool ctrl     = ((GetKeyState(VK_CONTROL) & keyDownMask) != 0);
-            const bool alt      = ((GetKeyState(VK_MENU) & keyDownMask) != 0);
-            const bool shift    = ((GetKeyState(VK_SHIFT) & keyDownMask) != 0);
-
-            // Key is pressed and no CTRL or ALT
-            if (!(lParam & (1 << 31)) && !ctrl && !alt)
-            {
-                if (wParam == VK_RETURN || wParam == VK_F3)
-                {
-                    RW->onSearch(shift);
-                    return 1;
-                }
-                if (wParam == VK_ESCAPE && !shift)
-                {
-                    SendMessage(RW->_hSearch, WM_CLOSE, 0, 0);
-                    SetFocus(ResultWin::_hSci);
-                    return 1;
-                }
-            }
-        }
-    }
-
-    return CallNextHookEx(NULL, code, wParam, lParam);
-}
-
-
-/**
- *  \brief
- */
-LRESULT APIENTRY ResultWin::wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-    switch (uMsg)
-    {
-        case WM_CREATE:
-        return 0;
-
-        case WM_SETFOCUS:
-            RW->hookKeyboard();
-            SetFocus(ResultWin::_hSci);
-        return 0;
-
-        case WM_NOTIFY:
-            switch (((LPNMHDR)lParam)->code)
-            {
-                case SCN_STYLENEEDED:
-                    RW->onStyleNeeded((SCNotification*)lParam);
-                return 0;
-
-                case SCN_UPDATEUI:
-                    if (((SCNotification*)lParam)->updated & SC_UPDATE_SELECTION)
-                        RW->onNewPosition();
-                return 0;
-
-                case SCN_HOTSPOTRELEASECLICK:
-                    RW->onHotspotClick((SCNotification*)lParam);
-                return 0;
-
-                case SCN_DOUBLECLICK:
-                    RW->onDoubleClick(((SCNotification*)lParam)->position);
-                return 0;
-
-                case SCN_MARGINCLICK:
-                    RW->onMarginClick((SCNotification*)lParam);
-                return 0;
-
-                case TCN_SELCHANGE:
-                    RW->onTabChange();
-                return 0;
-
-                case DMN_CLOSE:
-                    RW->closeAllTabs();
-                return 0;
-            }
-        break;
-
-        case WM_CONTEXTMENU:
-            RW->onCloseTab();
-        break;
-
-        case WM_SIZE:
-            RW->onResize(LOWORD(lParam), HIWORD(lParam));
-        return 0;
-
-        case WM_MOVE:
-            RW->onMove();
-        return 0;
-
-        case WM_DESTROY:
-        return 0;
-
-        // Below are WM_USER messages for DLL threads synchronization
-
-        case WM_RUN_CMD_CALLBACK:
-        {
-            CompletionCB    complCB = reinterpret_cast<CompletionCB>(wParam);
-            CmdPtr_t        cmd(*(reinterpret_cast<CmdPtr_t*>(lParam)));
-
-            ReplyMessage(0);
-
-            if (complCB && cmd)
-                complCB(cmd);
-        }
-        return 0;
-
-        case WM_OPEN_ACTIVITY_WIN:
-        {
-            TCHAR* header   = reinterpret_cast<TCHAR*>(wParam);
-            HANDLE hCancel  = reinterpret_cast<HANDLE>(lParam);
-
-            if (hCancel)
-                ActivityWin::Show(header, hCancel);
-        }
-        return 0;
-
-        case WM_CLOSE_ACTIVITY_WIN:
-        {
-            HANDLE hCancel = reinterpret_cast<HANDLE>(lParam);
-
-            if (hCancel)
-            {
-                HWND hActivityWin = ActivityWin::GetHwnd(hCancel);
-
-                if (hActivityWin)
-                    SendMessage(hActivityWin, WM_CLOSE, 0, 0);
-            }
-        }
-        return 0;
-    }
-
-    return DefWindowProc(hWnd, uMsg, wParam, lParam);
-}
-
-
-/**
- *  \brief
- */
-LRESULT APIENTRY ResultWin::searchWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-    switch (uMsg)
-    {
-        case WM_CREATE:
-            RW->onSearchWindowCreate(hWnd);
-        return 0;
-
-        case WM_SETFOCUS:
-            SetFocus(RW->_hSearchTxt);
-        return 0;
-
-        case WM_NOTIFY:
-            if (((LPNMHDR)lParam)->code == EN_REQUESTRESIZE)
-            {
-                RW->onMove();
-                return 0;
-            }
-        break;
-
-        case WM_COMMAND:
-            if (HIWORD(wParam) == BN_CLICKED)
-            {
-                if ((HWND)lParam == RW->_hDown)
-                {
-                    RW->onSearch(false, true);
-                    return 0;
-                }
-                else if ((HWND)lParam == RW->_hUp)
-                {
-                    RW->onSearch(true, true);
-                    return 0;
-                }
-            }
-        break;
-
-        case WM_DESTROY:
-            if (RW->_hSearchFont)
-            {
-                DeleteObject(RW->_hSearchFont);
-                RW->_hSearchFont = NULL;
-            }
-
-            if (RW->_hBtnFont)
-            {
-                DeleteObject(RW->_hBtnFont);
-                RW->_hBtnFont = NULL;
-            }
-
-            RW->_hSearch = NULL;
-        return 0;
-    }
-
-    return DefWindowProc(hWnd, uMsg, wParam, lParam);
-}
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags result Scintilla view window
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma comment (lib, "comctl32")
+
+
+#include "ResultWin.h"
+#include "INpp.h"
+#include "DbManager.h"
+#include "DocLocation.h"
+#include "ActivityWin.h"
+#include "Cmd.h"
+#include "CmdEngine.h"
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <windowsx.h>
+#include <richedit.h>
+#include <commctrl.h>
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include "Common.h"
+#include "GTags.h"
+#include "Blob.h"
+#include "NppAPI/dockingResource.h"
+
+
+// Scintilla user defined styles IDs
+enum SciStyles_t
+{
+    SCE_GTAGS_HEADER = 151,
+    SCE_GTAGS_PROJECT_PATH,
+    SCE_GTAGS_FILE,
+    SCE_GTAGS_LINE_NUM,
+    SCE_GTAGS_WORD2SEARCH
+};
+
+
+// Scintilla fold levels - the directory and file lines are one level deeper than their parent directory,
+// the result lines are one level deeper than their file
+enum SciFoldLevels_t
+{
+    FILE_HEADER_LVL = SC_FOLDLEVELBASE
+};
+
+
+/*
+ *  Session file layout (little endian):
+ *
+ *  SessionHeader
+ *  tabs: u32 command id, u8 regexp, u8 ignore case, u8 merged,
+ *      u64 database generation (GTAGS last write time, 0 if stale), i64 current line, i64 first visible line,
+ *      str project path, str search,
+ *      u64 expanded groups words count, u64 expanded groups bits, u64 results size, results
+ *  results: the TabParser state - counters, search, grouping, str text, the line records, the match columns,
+ *      the files
+ *
+ *  str is u64 length followed by the bytes
+ */
+
+
+namespace
+{
+
+/**
+ *  \brief  Returns the first str in [pSrc, pEnd) or NULL. Ignoring case folds ASCII letters only
+ */
+const char* findLiteral(const char* pSrc, const char* pEnd, const std::string& str, bool ignoreCase)
+{
+    const size_t len = str.size();
+
+    if ((size_t)(pEnd - pSrc) < len)
+        return NULL;
+
+    const char* const pStr = str.c_str();
+
+    const char first = pStr[0];
+    char firstAlt = first;
+
+    if (ignoreCase)
+    {
+        if (first >= 'a' && first <= 'z')
+            firstAlt = first - 'a' + 'A';
+        else if (first >= 'A' && first <= 'Z')
+            firstAlt = first - 'A' + 'a';
+    }
+
+    const char* const pLast = pEnd - len;
+
+    for (; pSrc <= pLast; ++pSrc)
+    {
+        if (first == firstAlt)
+        {
+            pSrc = static_cast<const char*>(memchr(pSrc, first, pLast - pSrc + 1));
+            if (pSrc == NULL)
+                return NULL;
+        }
+        else if (*pSrc != first && *pSrc != firstAlt)
+        {
+            continue;
+        }
+
+        if (ignoreCase ? !_strnicmp(pSrc + 1, pStr + 1, len - 1) : !memcmp(pSrc + 1, pStr + 1, len - 1))
+            return pSrc;
+    }
+
+    return NULL;
+}
+
+
+/**
+ *  \brief  Returns the longest text that every regExp match contains or empty string if there is no such.
+ *          Knows Scintilla regexp syntax only and gives up on anything unclear
+ */
+std::string regExpLiteral(const char* regExp)
+{
+    std::string literal;
+    std::string run;
+    int groupDepth = 0;
+
+    auto endRun = [&literal, &run]()
+    {
+        if (run.size() > literal.size())
+            literal = run;
+        run.clear();
+    };
+
+    for (const char* pSrc = regExp; *pSrc; ++pSrc)
+    {
+        char c = *pSrc;
+
+        switch (c)
+        {
+            case '|':
+            return std::string();
+
+            case '(':
+                ++groupDepth;
+                endRun();
+            continue;
+
+            case ')':
+                if (groupDepth)
+                    --groupDepth;
+                endRun();
+            continue;
+
+            case '[':
+                if (*(++pSrc) == '^')
+                    ++pSrc;
+                if (*pSrc == ']')
+                    ++pSrc;
+                for (; *pSrc && *pSrc != ']'; ++pSrc);
+                if (*pSrc == 0)
+                    return std::string();
+                endRun();
+            continue;
+
+            // The previous character is optional
+            case '*':
+            case '?':
+            case '{':
+                if (!run.empty())
+                    run.pop_back();
+                endRun();
+                if (c == '{')
+                {
+                    for (; *pSrc && *pSrc != '}'; ++pSrc);
+                    if (*pSrc == 0)
+                        return std::string();
+                }
+            continue;
+
+            case '+':
+            case '.':
+            case '^':
+            case '$':
+                endRun();
+            continue;
+
+            case '\\':
+                c = *(++pSrc);
+                if (c == 0)
+                    return std::string();
+
+                // Character classes, word boundaries and escapes like \t - only escaped punctuation is literal
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                        c == '<' || c == '>')
+                {
+                    endRun();
+                    continue;
+                }
+            break;
+        }
+
+        // The group might be optional
+        if (groupDepth == 0)
+            run += c;
+    }
+
+    endRun();
+
+    return literal;
+}
+
+} // anonymous namespace
+
+
+namespace GTags
+{
+
+const TCHAR ResultWin::cClassName[]         = _T("ResultWin");
+const TCHAR ResultWin::cSearchClassName[]   = _T("ResultSearchWin");
+const TCHAR ResultWin::cSearchTitle[]       = _T("Search in results");
+const TCHAR ResultWin::cMergedTabName[]     = _T("Merged");
+const int ResultWin::cSearchBkgndColor      = COLOR_INFOBK;
+const unsigned ResultWin::cSearchFontSize   = 10;
+const int ResultWin::cSearchWidth           = 420;
+const size_t ResultWin::cMaxStaleFiles      = 16;
+const char ResultWin::cSessionMagic[]       = "NGRS";
+const uint32_t ResultWin::cSessionVersion   = 4;
+
+
+std::unique_ptr<ResultWin> ResultWin::RW {nullptr};
+
+HWND        ResultWin::_hSci    = NULL;
+SciFnDirect ResultWin::_sciFunc = NULL;
+sptr_t      ResultWin::_sciPtr  = 0;
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::Activate()
+{
+    if (RW && TabCtrl_GetItemCount(RW->_hTab))
+    {
+        // The tabs restored from the last session are there before the window is shown
+        if (!IsWindowVisible(RW->_hWnd))
+            RW->showWindow();
+        else
+            SetFocus(ResultWin::_hSci);
+
+        return true;
+    }
+
+    return false;
+};
+
+
+/**
+ *  \brief
+ */
+ResultWin::Tab::Tab(const CmdPtr_t& cmd) :
+    _cmdId(cmd->Id()), _regExp(cmd->RegExp()), _ignoreCase(cmd->IgnoreCase()),
+    _projectPath(cmd->Db()->GetPath().C_str()), _search(cmd->Tag().C_str()), _currentLine(1), _firstVisibleLine(0),
+    _parser(cmd->Parser()), _dirty(false), _merged(false), _hSpill(INVALID_HANDLE_VALUE), _lastUse(0),
+    _sessionData(NULL), _sessionSize(0), _refreshing(false)
+{
+}
+
+
+/**
+ *  \brief
+ */
+ResultWin::Tab::Tab(CmdId_t cmdId, bool regExp, bool ignoreCase) :
+    _cmdId(cmdId), _regExp(regExp), _ignoreCase(ignoreCase), _currentLine(1), _firstVisibleLine(0),
+    _parser(std::make_shared<TabParser>()), _dirty(false), _merged(false), _hSpill(INVALID_HANDLE_VALUE), _lastUse(0),
+    _sessionData(NULL), _sessionSize(0), _refreshing(false)
+{
+}
+
+
+/**
+ *  \brief
+ */
+ResultWin::Tab::~Tab()
+{
+    if (_hSpill != INVALID_HANDLE_VALUE)
+        CloseHandle(_hSpill);
+}
+
+
+/**
+ *  \brief
+ */
+inline void ResultWin::Tab::SetFolded(uint32_t group)
+{
+    if (group / 64 < _expandedGroups.size())
+        _expandedGroups[group / 64] &= ~(1ULL << (group % 64));
+}
+
+
+/**
+ *  \brief
+ */
+inline void ResultWin::Tab::SetAllFolded()
+{
+    _expandedGroups.clear();
+}
+
+
+/**
+ *  \brief
+ */
+inline void ResultWin::Tab::ClearFolded(uint32_t group)
+{
+    if (group / 64 >= _expandedGroups.size())
+        _expandedGroups.resize(group / 64 + 1, 0);
+
+    _expandedGroups[group / 64] |= 1ULL << (group % 64);
+}
+
+
+/**
+ *  \brief
+ */
+inline void ResultWin::Tab::ClearAllFolded(uint32_t groupsCount)
+{
+    _expandedGroups.assign((groupsCount + 63) / 64, ~0ULL);
+
+    // File groups added later on file update start folded
+    if (groupsCount % 64)
+        _expandedGroups.back() = (1ULL << (groupsCount % 64)) - 1;
+}
+
+
+/**
+ *  \brief
+ */
+inline bool ResultWin::Tab::IsFolded(uint32_t group) const
+{
+    return (group / 64 >= _expandedGroups.size() || !(_expandedGroups[group / 64] & (1ULL << (group % 64))));
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::Tab::RestoreView(const Tab& oldTab)
+{
+    _currentLine = oldTab._currentLine;
+    _firstVisibleLine = oldTab._firstVisibleLine;
+
+    if (_cmdId == FIND_FILE)
+        return;
+
+    intptr_t currentLineAdjustment = 0;
+    intptr_t firstVisLineAdjustment = 0;
+
+    intptr_t lastCurrent = 0;
+    intptr_t lastFirst = 0;
+
+    const TabParser* newParser = dynamic_cast<const TabParser*>(_parser.get());
+    const TabParser* oldParser = dynamic_cast<const TabParser*>(oldTab._parser.get());
+
+    const std::unordered_map<std::string, intptr_t>& newFileRes = newParser->getFileResults();
+    const std::unordered_map<std::string, intptr_t>& oldFileRes = oldParser->getFileResults();
+
+    for (const auto& oldFile : oldFileRes)
+    {
+        const TabParser::Record* oldRec = oldParser->getRecord(oldFile.second);
+        if (!oldRec || oldTab.IsFolded(oldRec->file))
+            continue;
+
+        const auto newFile = newFileRes.find(oldFile.first);
+        if (newFile == newFileRes.end())
+            continue;
+
+        const TabParser::Record* newRec = newParser->getRecord(newFile->second);
+        if (newRec)
+            ClearFolded(newRec->file);
+
+        if (_currentLine >= newFile->second && lastCurrent < newFile->second)
+        {
+            currentLineAdjustment = newFile->second - oldFile.second;
+            lastCurrent = newFile->second;
+        }
+
+        if (_firstVisibleLine >= newFile->second && lastFirst < newFile->second)
+        {
+            firstVisLineAdjustment = newFile->second - oldFile.second;
+            lastFirst = newFile->second;
+        }
+    }
+
+    _currentLine += currentLineAdjustment;
+    _firstVisibleLine += firstVisLineAdjustment;
+}
+
+
+/**
+ *  \brief  Moves the tab results to a temp file that is deleted when closed - on reload, tab close or exit
+ */
+bool ResultWin::Tab::Spill()
+{
+    if (IsSpilled())
+        return true;
+
+    TCHAR tmpPath[MAX_PATH];
+    TCHAR tmpFile[MAX_PATH];
+
+    if (!GetTempPath(_countof(tmpPath), tmpPath) || !GetTempFileName(tmpPath, _T("ngt"), 0, tmpFile))
+        return false;
+
+    HANDLE hFile = CreateFile(tmpFile, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        DeleteFile(tmpFile);
+        return false;
+    }
+
+    TabParser* parser = dynamic_cast<TabParser*>(_parser.get());
+
+    std::vector<char> data;
+    parser->serialize(data);
+
+    const uint64_t size = data.size();
+
+    if (!writeData(hFile, &size, sizeof(size)) || !writeData(hFile, data.data(), data.size()))
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    parser->release();
+    _hSpill = hFile;
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::Tab::Reload()
+{
+    TabParser* parser = dynamic_cast<TabParser*>(_parser.get());
+
+    if (_sessionData)
+    {
+        const bool success = parser->deserialize(_sessionData, _sessionSize);
+
+        _sessionData = NULL;
+        _sessionSize = 0;
+
+        return success;
+    }
+
+    if (_hSpill == INVALID_HANDLE_VALUE)
+        return true;
+
+    std::vector<char> data;
+    const bool success = readSpill(data) && parser->deserialize(data.data(), data.size());
+
+    CloseHandle(_hSpill);
+    _hSpill = INVALID_HANDLE_VALUE;
+
+    return success;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::Tab::readSpill(std::vector<char>& data) const
+{
+    uint64_t size;
+
+    if (SetFilePointer(_hSpill, 0, NULL, FILE_BEGIN) == INVALID_SET_FILE_POINTER ||
+        !readData(_hSpill, &size, sizeof(size)) || size > SIZE_MAX)
+        return false;
+
+    data.resize((size_t)size);
+
+    return readData(_hSpill, data.data(), data.size());
+}
+
+
+/**
+ *  \brief  Gets the serialized results wherever they are without loading them in the tab
+ */
+bool ResultWin::Tab::getResults(std::vector<char>& buf, const char*& pData, size_t& size) const
+{
+    if (_sessionData)
+    {
+        pData = _sessionData;
+        size = _sessionSize;
+
+        return true;
+    }
+
+    if (_hSpill != INVALID_HANDLE_VALUE)
+    {
+        if (!readSpill(buf))
+            return false;
+    }
+    else
+    {
+        dynamic_cast<const TabParser*>(_parser.get())->serialize(buf);
+    }
+
+    pData = buf.data();
+    size = buf.size();
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::Tab::Save(HANDLE hFile, uint64_t dbGeneration) const
+{
+    std::vector<char> results;
+    const char* pResults;
+    size_t resultsSize;
+
+    if (!getResults(results, pResults, resultsSize))
+        return false;
+
+    std::vector<char> out;
+
+    put(out, (uint32_t)_cmdId);
+    put(out, (uint8_t)_regExp);
+    put(out, (uint8_t)_ignoreCase);
+    put(out, (uint8_t)_merged);
+    put(out, dbGeneration);
+    put(out, (int64_t)_currentLine);
+    put(out, (int64_t)_firstVisibleLine);
+    putStr(out, _projectPath.C_str(), _projectPath.Len());
+    putStr(out, _search.C_str(), _search.Len());
+
+    put(out, (uint64_t)_expandedGroups.size());
+    for (uint64_t bits : _expandedGroups)
+        put(out, bits);
+
+    put(out, (uint64_t)resultsSize);
+
+    return (writeData(hFile, out.data(), out.size()) && writeData(hFile, pResults, resultsSize));
+}
+
+
+/**
+ *  \brief  Creates the tab with the results left in the session data - they are loaded when the tab is shown.
+ *          Returns NULL if the data is not valid
+ */
+ResultWin::Tab* ResultWin::Tab::Restore(const char*& pData, const char* pEnd, uint64_t& dbGeneration)
+{
+    BlobReader in(pData, pEnd - pData);
+
+    const uint32_t cmdId    = in.Get<uint32_t>();
+    const bool regExp       = (in.Get<uint8_t>() != 0);
+    const bool ignoreCase   = (in.Get<uint8_t>() != 0);
+    const bool merged       = (in.Get<uint8_t>() != 0);
+
+    dbGeneration = in.Get<uint64_t>();
+
+    const intptr_t currentLine      = (intptr_t)in.Get<int64_t>();
+    const intptr_t firstVisibleLine = (intptr_t)in.Get<int64_t>();
+
+    std::string projectPath;
+    std::string search;
+
+    in.GetStr(projectPath);
+    in.GetStr(search);
+
+    if (!in.Ok() || cmdId < FIND_FILE || cmdId > GREP_TEXT || projectPath.empty() || search.empty())
+        return NULL;
+
+    Tab* tab = new Tab((CmdId_t)cmdId, regExp, ignoreCase);
+
+    tab->_merged            = merged;
+    tab->_projectPath       = projectPath.c_str();
+    tab->_search            = search.c_str();
+    tab->_currentLine       = currentLine;
+    tab->_firstVisibleLine  = firstVisibleLine;
+
+    for (uint64_t count = in.Get<uint64_t>(); in.Ok() && count; --count)
+        tab->_expandedGroups.push_back(in.Get<uint64_t>());
+
+    tab->_sessionData = in.GetData(tab->_sessionSize);
+
+    if (!in.Ok())
+    {
+        delete tab;
+        return NULL;
+    }
+
+    pData = in.Pos();
+
+    return tab;
+}
+
+
+/**
+ *  \brief  Adjusts the view after the lines of a file group have been replaced. The folding is kept
+ *          per file group so it needs no adjustment
+ */
+void ResultWin::Tab::ShiftLines(intptr_t line, intptr_t oldLines, intptr_t newLines)
+{
+    const intptr_t delta = newLines - oldLines;
+
+    for (intptr_t* viewLine : {&_currentLine, &_firstVisibleLine})
+    {
+        if (*viewLine >= line + oldLines)
+            *viewLine += delta;
+        else if (*viewLine >= line + newLines)
+            *viewLine = newLines ? line : (line ? line - 1 : 0);
+    }
+}
+
+
+/**
+ *  \brief
+ */
+HWND ResultWin::Register()
+{
+    if (RW)
+        return NULL;
+
+    WNDCLASS wc         = {0};
+    wc.style            = CS_PARENTDC | CS_HREDRAW | CS_VREDRAW;
+    wc.lpfnWndProc      = wndProc;
+    wc.hInstance        = HMod;
+    wc.hCursor          = LoadCursor(NULL, IDC_ARROW);
+    wc.hbrBackground    = GetSysColorBrush(COLOR_WINDOW);
+    wc.lpszClassName    = cClassName;
+
+    RegisterClass(&wc);
+
+    wc.lpfnWndProc      = searchWndProc;
+    wc.hbrBackground    = GetSysColorBrush(COLOR_BTNFACE);
+    wc.lpszClassName    = cSearchClassName;
+
+    RegisterClass(&wc);
+
+    INITCOMMONCONTROLSEX icex   = {0};
+    icex.dwSize                 = sizeof(icex);
+    icex.dwICC                  = ICC_STANDARD_CLASSES;
+
+    InitCommonControlsEx(&icex);
+
+    // Scintilla uses that, make sure it is not accidentally unloaded
+    LoadLibrary(_T("Riched20.dll"));
+
+    RW = std::make_unique<ResultWin>();
+
+    if (RW->composeWindow() == NULL)
+    {
+        Unregister();
+        return NULL;
+    }
+
+    tTbData data;
+    data.hClient        = RW->_hWnd;
+    data.pszName        = const_cast<TCHAR*>(cPluginName);
+    data.pszAddInfo     = NULL;
+    data.uMask          = DWS_DF_CONT_BOTTOM | DWS_ICONTAB;
+    data.hIconTab       = ( HICON )::LoadImage(HMod, MAKEINTRESOURCE(IDI_PLUGINPANEL),
+                              IMAGE_ICON, 0, 0, LR_LOADTRANSPARENT);
+    data.pszModuleName  = DllPath.GetFilename();
+    data.dlgID          = 0;
+
+    INpp& npp = INpp::Get();
+    npp.RegisterDockingWin(data);
+    npp.HideDockingWin(RW->_hWnd);
+
+    RW->restoreSession();
+
+    return RW->_hWnd;
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::Unregister()
+{
+    if (RW)
+    {
+        if (RW->_hWnd)
+            RW->saveSession();
+
+        RW = nullptr;
+    }
+
+    UnregisterClass(cClassName, HMod);
+    UnregisterClass(cSearchClassName, HMod);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::show()
+{
+    INpp& npp = INpp::Get();
+
+    if (GetFocus() != npp.ReadSciHandle())
+        SetFocus(npp.GetSciHandle());
+    else if (TabCtrl_GetItemCount(_hTab))
+        showWindow();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::show(const CmdPtr_t& cmd)
+{
+    Tab* tab = new Tab(cmd);
+
+    bool isNewTab = false;
+    HWND hFocus = NULL;
+
+    int i;
+    for (i = TabCtrl_GetItemCount(_hTab); i; --i)
+    {
+        Tab* oldTab = getTab(i - 1);
+
+        if (oldTab && (*tab == *oldTab)) // same search tab already present?
+        {
+            if (_activeTab == oldTab) // is this the currently active tab?
+            {
+                _activeTab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
+                _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
+
+                _activeTab = NULL;
+                hFocus = GetFocus();
+            }
+
+            // Keep the grouping of the previous results
+            const TabParser* oldParser = dynamic_cast<const TabParser*>(oldTab->_parser.get());
+            if (oldParser->isDirTree() || oldParser->isSortedByHits())
+                dynamic_cast<TabParser*>(tab->_parser.get())->regroup(oldParser->isDirTree(),
+                        oldParser->isSortedByHits());
+
+            tab->RestoreView(*oldTab);
+
+            delete oldTab;
+            break;
+        }
+    }
+
+    if (i == 0) // search is completely new - add new tab or visit single result
+    {
+        if (visitSingleResult(tab))
+        {
+            delete tab;
+            return;
+        }
+
+        TCHAR buf[64];
+        _sntprintf_s(buf, _countof(buf), _TRUNCATE, _T("%s \"%s\""), cmd->Name(), cmd->Tag().C_str());
+
+        TCITEM tci  = {0};
+        tci.mask    = TCIF_TEXT | TCIF_PARAM;
+        tci.pszText = buf;
+        tci.lParam  = (LPARAM)tab;
+
+        i = TabCtrl_InsertItem(_hTab, TabCtrl_GetItemCount(_hTab), &tci);
+        if (i == -1)
+        {
+            delete tab;
+            return;
+        }
+
+        isNewTab = true;
+    }
+    else // same search tab exists - reuse it, just update results
+    {
+        TCITEM tci  = {0};
+        tci.mask    = TCIF_PARAM;
+        tci.lParam  = (LPARAM)tab;
+
+        if (!TabCtrl_SetItem(_hTab, --i, &tci))
+        {
+            TabCtrl_DeleteItem(_hTab, i);
+            delete tab;
+            tab = NULL;
+        }
+    }
+
+    if (tab == NULL)
+    {
+        if (_activeTab)
+            return;
+
+        int cnt = TabCtrl_GetItemCount(_hTab);
+        if (cnt == 0)
+        {
+            closeAllTabs();
+            return;
+        }
+
+        if (i > cnt - 1)
+            i = cnt - 1;
+        tab = getTab(i);
+    }
+
+    TabCtrl_SetCurSel(_hTab, i);
+    loadTab(tab, isNewTab);
+
+    const CmdTimingPtr_t& timing = cmd->Timing();
+    if (timing)
+    {
+        timing->Mark(CmdTiming::UI_LOAD);
+
+        // Left to the next results view paint - when the results actually become visible
+        _paintTiming = timing;
+    }
+
+    showWindow(hFocus);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::close(const CmdPtr_t& cmd)
+{
+    int count = TabCtrl_GetItemCount(_hTab);
+    if (count == 0)
+        return;
+
+    CmdId_t cmdId       = cmd->Id();
+    CTextA  projectPath = cmd->Db()->GetPath().C_str();
+    CTextA  search      = cmd->Tag().C_str();
+
+    for (int i = count; i; --i)
+    {
+        Tab* oldTab = getTab(i - 1);
+
+        if (oldTab && !oldTab->_merged && ((cmdId == oldTab->_cmdId) ||
+            ((cmdId == FIND_SYMBOL) && ((oldTab->_cmdId == FIND_DEFINITION) || (oldTab->_cmdId == FIND_REFERENCE)))) &&
+            (projectPath == oldTab->_projectPath) && (search == oldTab->_search)) // same search tab already present?
+        {
+            --i;
+
+            if (_activeTab == oldTab) // is this the currently active tab?
+                _activeTab = NULL;
+            delete oldTab;
+
+            TabCtrl_DeleteItem(_hTab, i);
+
+            if (--count)
+            {
+                i = i ? i - 1 : 0;
+                Tab* tab = getTab(i);
+                TabCtrl_SetCurSel(_hTab, i);
+                if (tab)
+                    loadTab(tab);
+            }
+            else
+            {
+                sendSci(SCI_SETREADONLY, 0);
+                sendSci(SCI_CLEARALL);
+                sendSci(SCI_SETREADONLY, 1);
+
+                hideWindow();
+            }
+
+            return;
+        }
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::reRunCmd()
+{
+    if (!_activeTab || _activeTab->_merged)
+        return;
+
+    DbHandle db = getDatabaseAt(CPath(_activeTab->_projectPath.C_str()));
+    if (!db)
+        return;
+
+    ParserPtr_t parser(new ResultWin::TabParser);
+    CmdPtr_t cmd(new Cmd(_activeTab->_cmdId, db, parser, NULL, _activeTab->_ignoreCase, _activeTab->_regExp));
+
+    cmd->Tag(CText(_activeTab->_search.C_str()));
+    CmdEngine::Run(cmd, showResultCB);
+
+    _activeTab->_dirty = false;
+    _activeTab->_staleFiles.clear();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::loadMoreResults()
+{
+    if (!_activeTab)
+        return;
+
+    if (_activeTab->_dirty)
+    {
+        reRunCmd();
+        return;
+    }
+
+    const TabParser* parser = dynamic_cast<const TabParser*>(_activeTab->_parser.get());
+    if (!parser->isTruncated())
+        return;
+
+    DbHandle db = getDatabaseAt(CPath(_activeTab->_projectPath.C_str()));
+    if (!db)
+        return;
+
+    // The new parser continues from where the current one has stopped
+    ParserPtr_t nextParser(new ResultWin::TabParser(*parser));
+    CmdPtr_t cmd(new Cmd(_activeTab->_cmdId, db, nextParser, NULL, _activeTab->_ignoreCase, _activeTab->_regExp));
+
+    cmd->Tag(CText(_activeTab->_search.C_str()));
+    cmd->LinesOffset(parser->getOutputLines());
+    CmdEngine::Run(cmd, showResultCB);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::applyStyle()
+{
+    INpp& npp = INpp::Get();
+
+    char font[32];
+    npp.GetFontName(STYLE_DEFAULT, font);
+    int size = npp.GetFontSize(STYLE_DEFAULT);
+    COLORREF caretLineBackColor = npp.GetCaretLineBack();
+    COLORREF foreColor = npp.GetForegroundColor(STYLE_DEFAULT);
+    COLORREF backColor = npp.GetBackgroundColor(STYLE_DEFAULT);
+    COLORREF lineNumColor = npp.GetForegroundColor(STYLE_LINENUMBER);
+
+    COLORREF fileForeColor =
+            RGB(GetRValue(backColor) ^ 0xFF, GetGValue(backColor) ^ 0x7F, GetBValue(backColor) ^ 0x7F);
+    COLORREF findForeColor =
+            RGB(GetRValue(backColor) ^ 0x1C, GetGValue(backColor) ^ 0xFF, GetBValue(backColor) ^ 0xFF);
+
+    HFONT hFont = Tools::CreateFromSystemMenuFont();
+    if (hFont)
+        SendMessage(_hTab, WM_SETFONT, (WPARAM)hFont, TRUE);
+
+    sendSci(SCI_STYLERESETDEFAULT);
+    setStyle(STYLE_DEFAULT, foreColor, backColor, false, false, size, font);
+    sendSci(SCI_STYLECLEARALL);
+
+    setStyle(SCE_GTAGS_HEADER, foreColor, backColor, true);
+    setStyle(SCE_GTAGS_PROJECT_PATH, foreColor, backColor, true, true);
+    setStyle(SCE_GTAGS_FILE, fileForeColor, backColor, true);
+    setStyle(SCE_GTAGS_LINE_NUM, lineNumColor, backColor, false, true);
+    setStyle(SCE_GTAGS_WORD2SEARCH, findForeColor, backColor, true);
+
+    sendSci(SCI_SETCARETLINEBACK, caretLineBackColor);
+    sendSci(SCI_STYLESETHOTSPOT, SCE_GTAGS_WORD2SEARCH, true);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::notifyDBUpdate(const CmdPtr_t& cmd)
+{
+    const CPath& dbPath = cmd->Db()->GetPath();
+
+    // Database relative path of the single updated file
+    std::string updatedFile;
+
+    if (cmd->Id() == UPDATE_SINGLE && cmd->Tag().Len() > dbPath.Len())
+    {
+        const CTextA tag(cmd->Tag().C_str());
+        updatedFile = tag.C_str() + dbPath.Len();
+
+        size_t j = 0;
+        while ((j = updatedFile.find('\\', j)) != std::string::npos)
+            updatedFile[j] = '/';
+    }
+
+    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
+    {
+        Tab* tab = getTab(i - 1);
+
+        if (!tab || tab->_dirty || tab->_merged || !(CPath(tab->_projectPath.C_str()) == dbPath))
+            continue;
+
+        const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
+
+        // Re-run in full on database re-creation and for file searches. Truncated results as well - the file
+        // might be among the ones not loaded yet. A file in the database root folder would be re-queried over
+        // the whole database anyway
+        if (updatedFile.empty() || tab->_cmdId == FIND_FILE || parser->isTruncated() ||
+                updatedFile.find('/') == std::string::npos)
+        {
+            tab->_dirty = true;
+            tab->_staleFiles.clear();
+            continue;
+        }
+
+        tab->_staleFiles.insert(updatedFile);
+
+        if (tab->_staleFiles.size() > cMaxStaleFiles)
+        {
+            tab->_dirty = true;
+            tab->_staleFiles.clear();
+        }
+    }
+
+    if (_activeTab)
+    {
+        if (_activeTab->_dirty)
+            reRunCmd();
+        else
+            refreshStaleFiles(_activeTab);
+    }
+}
+
+
+/**
+ *  \brief  Re-queries only the updated files - each in its folder - to splice their results in the tab.
+ *          One file at a time - the next one is started when the previous results are spliced
+ */
+void ResultWin::refreshStaleFiles(Tab* tab)
+{
+    const CPath dbPath(tab->_projectPath.C_str());
+
+    while (!tab->_refreshing && !tab->_staleFiles.empty())
+    {
+        const std::string& file = *tab->_staleFiles.begin();
+
+        bool success;
+        DbHandle db = DbManager::Get().GetDbAt(dbPath, false, &success);
+
+        // Database is busy - its next update will retry
+        if (!db || !success)
+            return;
+
+        // The files in the database root folder are not kept stale - the tab is re-run for them
+        CPath localDir(dbPath);
+        CText dir(file.substr(0, file.rfind('/') + 1).c_str());
+        localDir += dir.C_str();
+        localDir.NormalizePathSlashes();
+
+        ParserPtr_t parser = std::make_shared<TabParser>(file);
+        CmdPtr_t cmd = std::make_shared<Cmd>(tab->_cmdId, db, parser, nullptr, tab->_ignoreCase, tab->_regExp);
+
+        cmd->Tag(CText(tab->_search.C_str()));
+        cmd->LocalDir(localDir);
+
+        if (CmdEngine::Run(cmd, refreshCB))
+            tab->_refreshing = true;
+        else
+            DbManager::Get().PutDb(db);
+
+        tab->_staleFiles.erase(tab->_staleFiles.begin());
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::refreshCB(const CmdPtr_t& cmd)
+{
+    DbManager::Get().PutDb(cmd->Db());
+
+    if (RW)
+        RW->onFileRefresh(cmd);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onFileRefresh(const CmdPtr_t& cmd)
+{
+    const CTextA projectPath(cmd->Db()->GetPath().C_str());
+    const CTextA search(cmd->Tag().C_str());
+
+    Tab* tab = NULL;
+
+    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
+    {
+        Tab* t = getTab(i - 1);
+
+        if (t && !t->_merged && t->_cmdId == cmd->Id() && t->_projectPath == projectPath && t->_search == search &&
+                t->_ignoreCase == cmd->IgnoreCase() && t->_regExp == cmd->RegExp())
+        {
+            tab = t;
+            break;
+        }
+    }
+
+    if (!tab)
+        return;
+
+    tab->_refreshing = false;
+
+    reloadTab(tab);
+
+    // The tab is going to be re-run anyway
+    if (tab->_dirty)
+        return;
+
+    TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
+
+    // A cut refresh output is not the file's complete results
+    if ((cmd->Status() != OK && cmd->Status() != PARSE_EMPTY) || cmd->IsTruncated() || parser->isTruncated())
+    {
+        tab->_dirty = true;
+        tab->_staleFiles.clear();
+
+        if (tab == _activeTab)
+            reRunCmd();
+
+        return;
+    }
+
+    const bool isActive = (tab == _activeTab);
+
+    if (isActive)
+    {
+        tab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
+        tab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
+    }
+
+    // The file groups are spliced in the results as parsed
+    const bool dirTree = parser->isDirTree();
+    const bool sortByHits = parser->isSortedByHits();
+
+    parser->regroup(false, false);
+
+    intptr_t line, oldLines, newLines;
+    parser->spliceFileGroup(*dynamic_cast<const TabParser*>(cmd->Parser().get()), line, oldLines, newLines);
+
+    if (dirTree || sortByHits)
+        parser->regroup(dirTree, sortByHits);
+    else if (oldLines || newLines)
+        tab->ShiftLines(line, oldLines, newLines);
+
+    // loadTab() goes on with the next stale file of the active tab
+    if (isActive && (dirTree || sortByHits || oldLines || newLines))
+    {
+        _activeTab = NULL;
+        loadTab(tab);
+    }
+    else if (isActive)
+    {
+        refreshStaleFiles(tab);
+    }
+}
+
+
+/**
+ *  \brief
+ */
+ResultWin::~ResultWin()
+{
+    if (_hWnd)
+    {
+        closeAllTabs();
+
+        SendMessage(_hWnd, WM_CLOSE, 0, 0);
+    }
+
+    closeSession();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::setStyle(int style, COLORREF fore, COLORREF back, bool bold, bool italic, int size, const char *font)
+{
+    sendSci(SCI_STYLESETEOLFILLED, style, 1);
+    sendSci(SCI_STYLESETFORE, style, fore);
+    sendSci(SCI_STYLESETBACK, style, back);
+    sendSci(SCI_STYLESETBOLD, style, bold);
+    sendSci(SCI_STYLESETITALIC, style, italic);
+
+    if (size >= 1)
+        sendSci(SCI_STYLESETSIZE, style, size);
+    if (font)
+        sendSci(SCI_STYLESETFONT, style, reinterpret_cast<LPARAM>(font));
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::configScintilla()
+{
+    sendSci(SCI_SETCODEPAGE, SC_CP_UTF8);
+    sendSci(SCI_SETEOLMODE, SC_EOL_CRLF);
+    sendSci(SCI_USEPOPUP, false);
+    sendSci(SCI_SETUNDOCOLLECTION, false);
+    sendSci(SCI_SETCARETSTYLE, CARETSTYLE_LINE);
+    sendSci(SCI_SETCARETLINEVISIBLE, true);
+    sendSci(SCI_SETCARETLINEVISIBLEALWAYS, true);
+    sendSci(SCI_SETHOTSPOTACTIVEUNDERLINE, false);
+
+    sendSci(SCI_SETWRAPMODE, SC_WRAP_WORD);
+    sendSci(SCI_SETWRAPVISUALFLAGS, SC_WRAPVISUALFLAG_START);
+    sendSci(SCI_SETWRAPVISUALFLAGSLOCATION, SC_WRAPVISUALFLAGLOC_DEFAULT);
+    sendSci(SCI_SETWRAPINDENTMODE, SC_WRAPINDENT_FIXED);
+    sendSci(SCI_SETWRAPSTARTINDENT, 24);
+    sendSci(SCI_SETLAYOUTCACHE, SC_CACHE_CARET);
+
+    // Implement lexer in the container
+    sendSci(SCI_SETILEXER, 0, (LPARAM)NULL);
+
+    ApplyStyle();
+
+    sendSci(SCI_SETPROPERTY, reinterpret_cast<WPARAM>("fold"), reinterpret_cast<LPARAM>("1"));
+
+    sendSci(SCI_SETMARGINTYPEN, 1, SC_MARGIN_SYMBOL);
+    sendSci(SCI_SETMARGINMASKN, 1, SC_MASK_FOLDERS);
+    sendSci(SCI_SETMARGINWIDTHN, 1, 20);
+    sendSci(SCI_SETFOLDMARGINCOLOUR, 1, cBlack);
+    sendSci(SCI_SETFOLDMARGINHICOLOUR, 1, cBlack);
+    sendSci(SCI_SETMARGINSENSITIVEN, 1, true);
+    sendSci(SCI_SETFOLDFLAGS, 0);
+
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDER, SC_MARK_BOXPLUS);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEROPEN, SC_MARK_BOXMINUS);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEREND, SC_MARK_BOXPLUSCONNECTED);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERSUB, SC_MARK_VLINE);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERTAIL, SC_MARK_LCORNER);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDERMIDTAIL, SC_MARK_TCORNER);
+    sendSci(SCI_MARKERDEFINE, SC_MARKNUM_FOLDEROPENMID, SC_MARK_BOXMINUSCONNECTED);
+}
+
+
+/**
+ *  \brief
+ */
+HWND ResultWin::composeWindow()
+{
+    INpp& npp = INpp::Get();
+    HWND hOwner = npp.GetHandle();
+
+    DWORD style = WS_POPUP | WS_CAPTION | WS_SIZEBOX | WS_CLIPCHILDREN;
+
+    _hWnd = CreateWindow(cClassName, cPluginName, style,
+            0, 0, 10, 10, hOwner, NULL, HMod, NULL);
+    if (_hWnd == NULL)
+        return NULL;
+
+    npp.RegisterWinForDarkMode(_hWnd);
+
+    if (!_hSci)
+    {
+        _hSci = npp.CreateSciHandle(_hWnd);
+        if (_hSci)
+        {
+            _sciFunc    = (SciFnDirect)::SendMessage(_hSci, SCI_GETDIRECTFUNCTION, 0, 0);
+            _sciPtr     = (sptr_t)::SendMessage(_hSci, SCI_GETDIRECTPOINTER, 0, 0);
+        }
+    }
+
+    if (_hSci == NULL || _sciFunc == NULL || _sciPtr == 0)
+    {
+        SendMessage(_hWnd, WM_CLOSE, 0, 0);
+        _hWnd = NULL;
+        _hSci = NULL;
+        return NULL;
+    }
+
+    _hTab = CreateWindowEx(0, WC_TABCONTROL, NULL,
+            WS_CHILD | WS_VISIBLE | TCS_BUTTONS | TCS_FOCUSNEVER,
+            0, 0, 10, 10, _hWnd, NULL, HMod, NULL);
+
+    configScintilla();
+
+    ShowWindow(_hSci, SW_SHOWNORMAL);
+
+    return _hWnd;
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::createSearchWindow()
+{
+    if (_hSearch)
+    {
+        SetFocus(_hSearchTxt);
+        Edit_SetSel(_hSearchTxt, 0, -1);
+        return;
+    }
+
+    const DWORD styleEx = WS_EX_WINDOWEDGE | WS_EX_TOOLWINDOW;
+    const DWORD style   = WS_POPUP | WS_CAPTION;
+
+    CreateWindowEx(styleEx, cSearchClassName, cSearchTitle, style, 0, 0, 10, 10, _hWnd, NULL, HMod, NULL);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onSearchWindowCreate(HWND hWnd)
+{
+    _hSearch = hWnd;
+
+    INpp::Get().RegisterWinForDarkMode(_hSearch);
+
+    HDC hdc = GetWindowDC(_hSearch);
+
+    _hSearchFont    = Tools::CreateFromSystemMessageFont(hdc, cSearchFontSize);
+    _hBtnFont       = Tools::CreateFromSystemMenuFont(hdc, cSearchFontSize - 1);
+
+    _searchTxtHeight    = Tools::GetFontHeight(hdc, _hSearchFont) + 1;
+    int btnHeight       = Tools::GetFontHeight(hdc, _hBtnFont) + 2;
+
+    ReleaseDC(_hSearch, hdc);
+
+    const DWORD styleTxtEx  = WS_EX_CLIENTEDGE;
+    const DWORD styleTxt    = WS_CHILD | WS_VISIBLE | WS_HSCROLL | ES_AUTOHSCROLL;
+
+    {
+        RECT win { 0, 0, cSearchWidth, _searchTxtHeight };
+        AdjustWindowRectEx(&win, styleTxt, FALSE, styleTxtEx);
+        _searchTxtHeight = win.bottom - win.top;
+    }
+
+    RECT win = Tools::GetWinRect(_hWnd,
+            (DWORD)GetWindowLongPtr(_hSearch, GWL_EXSTYLE), (DWORD)GetWindowLongPtr(_hSearch, GWL_STYLE),
+            cSearchWidth + 1, _searchTxtHeight + btnHeight + 1);
+    RECT ownerWin;
+    GetWindowRect(_hWnd, &ownerWin);
+
+    MoveWindow(_hSearch,
+            ownerWin.right - (win.right - win.left) -
+            GetSystemMetrics(SM_CXSIZEFRAME) - GetSystemMetrics(SM_CXFIXEDFRAME) - GetSystemMetrics(SM_CXVSCROLL),
+            ownerWin.top +
+            GetSystemMetrics(SM_CYSIZEFRAME) + GetSystemMetrics(SM_CYFIXEDFRAME) + GetSystemMetrics(SM_CYSIZE),
+            win.right - win.left, win.bottom - win.top, TRUE);
+
+    GetClientRect(_hSearch, &win);
+
+    int btnWidth = (win.right - win.left - 120) / 3;
+
+    _hRE = CreateWindowEx(0, _T("BUTTON"), _T("RegExp"),
+            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+            1, 0, btnWidth, btnHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    _hIC = CreateWindowEx(0, _T("BUTTON"), _T("IgnoreCase"),
+            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+            btnWidth + 1, 0, btnWidth, btnHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    _hWW = CreateWindowEx(0, _T("BUTTON"), _T("WholeWord"),
+            WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX,
+            2 * btnWidth + 1, 0, btnWidth, btnHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    _hUp = CreateWindowEx(0, _T("BUTTON"), _T("Up"),
+            WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+            3 * btnWidth + 1, 0, 60, btnHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    _hDown = CreateWindowEx(0, _T("BUTTON"), _T("Down"),
+            WS_CHILD | WS_VISIBLE | BS_PUSHBUTTON,
+            3 * btnWidth + 61, 0, 60, btnHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    if (_hBtnFont)
+    {
+        SendMessage(_hRE, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
+        SendMessage(_hIC, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
+        SendMessage(_hWW, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
+        SendMessage(_hUp, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
+        SendMessage(_hDown, WM_SETFONT, (WPARAM)_hBtnFont, TRUE);
+    }
+
+    Button_SetCheck(_hRE, _lastRE ? BST_CHECKED : BST_UNCHECKED);
+    Button_SetCheck(_hIC, _lastIC ? BST_CHECKED : BST_UNCHECKED);
+    Button_SetCheck(_hWW, _lastWW ? BST_CHECKED : BST_UNCHECKED);
+
+    _hSearchTxt = CreateWindowEx(styleTxtEx, RICHEDIT_CLASS, NULL, styleTxt,
+            0, btnHeight + 1, win.right - win.left, _searchTxtHeight,
+            _hSearch, NULL, HMod, NULL);
+
+    SendMessage(_hSearchTxt, EM_SETBKGNDCOLOR, 0, GetSysColor(cSearchBkgndColor));
+
+    if (_hSearchFont)
+        SendMessage(_hSearchTxt, WM_SETFONT, (WPARAM)_hSearchFont, TRUE);
+
+    SendMessage(_hSearchTxt, EM_SETEVENTMASK, 0, ENM_REQUESTRESIZE);
+
+    INpp& npp = INpp::Get();
+
+    HWND nppHSci = npp.ReadSciHandle();
+
+    npp.SetSciHandle(_hSci);
+
+    CTextA selectionA;
+    if (!npp.IsSelectionVertical())
+        npp.GetSelectionText(selectionA);
+
+    npp.SetSciHandle(nppHSci);
+
+    if (!selectionA.IsEmpty())
+    {
+        const CText selection(selectionA.C_str());
+
+        Edit_SetText(_hSearchTxt, selection.C_str());
+        Edit_SetSel(_hSearchTxt, 0, -1);
+    }
+    else if (!_lastSearchTxt.IsEmpty())
+    {
+        Edit_SetText(_hSearchTxt, _lastSearchTxt.C_str());
+        Edit_SetSel(_hSearchTxt, 0, -1);
+    }
+    else
+    {
+        Edit_SetText(_hSearchTxt, _T(""));
+    }
+
+    ShowWindow(_hSearch, SW_SHOWNORMAL);
+    SetFocus(_hSearchTxt);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::showWindow(HWND hFocus)
+{
+    Tools::ReleaseKeys();
+
+    INpp::Get().ShowDockingWin(_hWnd);
+
+    // Restored session tab
+    if (!_activeTab)
+        onTabChange();
+
+    ActivityWin::UpdatePositions();
+
+    if (hFocus)
+        SetFocus(hFocus);
+    else
+        SetFocus(_hSci);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::hideWindow()
+{
+    if (_hSearch)
+        SendMessage(_hSearch, WM_CLOSE, 0, 0);
+
+    if (_hKeyHook)
+    {
+        UnhookWindowsHookEx(_hKeyHook);
+        _hKeyHook = NULL;
+    }
+
+    INpp& npp = INpp::Get();
+    npp.HideDockingWin(_hWnd);
+
+    ActivityWin::UpdatePositions();
+
+    if (GetFocus() != npp.ReadSciHandle())
+        SetFocus(npp.GetSciHandle());
+}
+
+
+/**
+ *  \brief
+ */
+ResultWin::Tab* ResultWin::getTab(int i)
+{
+    if (i == -1)
+    {
+        i = TabCtrl_GetCurSel(_hTab);
+        if (i == -1)
+            return NULL;
+    }
+
+    TCITEM tci  = {0};
+    tci.mask    = TCIF_PARAM;
+
+    if (!TabCtrl_GetItem(_hTab, i, &tci))
+        return NULL;
+
+    return (Tab*)tci.lParam;
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::loadTab(ResultWin::Tab* tab, bool firstTimeLoad)
+{
+    // store current view if there is one
+    if (_activeTab)
+    {
+        _activeTab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
+        _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
+    }
+
+    _activeTab = NULL;
+
+    sendSci(SCI_SETREADONLY, 0);
+    sendSci(SCI_CLEARALL);
+
+    _activeTab = tab;
+    _activeTab->_lastUse = ++_tabUseCount;
+
+    _searchMatches.valid = false;
+
+    reloadTab(tab);
+
+    sendSci(SCI_SETTEXT, 0, reinterpret_cast<LPARAM>(tab->_parser->GetText().C_str()));
+    sendSci(SCI_SETREADONLY, 1);
+
+    sendSci(SCI_GOTOLINE, tab->_currentLine);
+    sendSci(SCI_SETFIRSTVISIBLELINE, tab->_firstVisibleLine);
+
+    if (tab->_dirty)
+    {
+        reRunCmd();
+    }
+    else if (!tab->_staleFiles.empty())
+    {
+        refreshStaleFiles(tab);
+    }
+    else if (firstTimeLoad && tab->_cmdId != FIND_FILE)
+    {
+        const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
+
+        if (parser->getFilesCount() == 1)
+            foldAll(SC_FOLDACTION_EXPAND);
+    }
+
+    fitTabsInBudget();
+}
+
+
+/**
+ *  \brief  Reads back the spilled tab results - if that fails the tab is marked to be re-run
+ */
+void ResultWin::reloadTab(Tab* tab)
+{
+    if (!tab->Reload())
+    {
+        tab->_dirty = true;
+        tab->_staleFiles.clear();
+    }
+}
+
+
+/**
+ *  \brief  Spills the least recently shown inactive tabs until the results in memory fit in the budget
+ */
+void ResultWin::fitTabsInBudget()
+{
+    if (GTagsSettings._resultsMemBudget <= 0)
+        return;
+
+    const uint64_t budget = (uint64_t)GTagsSettings._resultsMemBudget << 20;
+    uint64_t used = 0;
+
+    std::vector<std::pair<unsigned, Tab*>> inactive;
+
+    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
+    {
+        Tab* tab = getTab(i - 1);
+
+        if (!tab || tab->IsSpilled())
+            continue;
+
+        used += dynamic_cast<const TabParser*>(tab->_parser.get())->getMemSize();
+
+        if (tab != _activeTab)
+            inactive.emplace_back(tab->_lastUse, tab);
+    }
+
+    if (used <= budget)
+        return;
+
+    std::sort(inactive.begin(), inactive.end());
+
+    for (const auto& lru : inactive)
+    {
+        const size_t size = dynamic_cast<const TabParser*>(lru.second->_parser.get())->getMemSize();
+
+        // Out of temp space probably - no point to try the rest
+        if (!lru.second->Spill())
+            break;
+
+        used -= size;
+        if (used <= budget)
+            break;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::writeData(HANDLE hFile, const void* data, size_t size)
+{
+    const char* pData = static_cast<const char*>(data);
+
+    while (size)
+    {
+        const DWORD chunk = (size > 0x40000000) ? 0x40000000 : (DWORD)size;
+        DWORD written;
+
+        if (!WriteFile(hFile, pData, chunk, &written, NULL) || written != chunk)
+            return false;
+
+        pData += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::readData(HANDLE hFile, void* data, size_t size)
+{
+    char* pData = static_cast<char*>(data);
+
+    while (size)
+    {
+        const DWORD chunk = (size > 0x40000000) ? 0x40000000 : (DWORD)size;
+        DWORD read;
+
+        if (!ReadFile(hFile, pData, chunk, &read, NULL) || read != chunk)
+            return false;
+
+        pData += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief  The database GTAGS file last write time - changes on every update. 0 if there is no database
+ */
+uint64_t ResultWin::dbGeneration(const CTextA& projectPath)
+{
+    CPath gtags(projectPath.C_str());
+    gtags += _T("GTAGS");
+
+    WIN32_FILE_ATTRIBUTE_DATA attr;
+
+    if (!GetFileAttributesEx(gtags.C_str(), GetFileExInfoStandard, &attr))
+        return 0;
+
+    return (((uint64_t)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime);
+}
+
+
+/**
+ *  \brief  Writes all tabs to the session file. The restored tabs not shown yet are copied from its mapped view
+ *          so the new file is written aside and replaces the old one at the end
+ */
+void ResultWin::saveSession()
+{
+    if (!_sessionEnabled)
+        return;
+
+    CPath sessionFile;
+    INpp::Get().GetPluginsConfDir(sessionFile);
+    sessionFile += cResultsFileName;
+
+    const int tabsCount = TabCtrl_GetItemCount(_hTab);
+
+    if (tabsCount == 0)
+    {
+        closeSession();
+        DeleteFile(sessionFile.C_str());
+        return;
+    }
+
+    if (_activeTab)
+    {
+        _activeTab->_currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
+        _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
+    }
+
+    CPath tmpFile(sessionFile);
+    tmpFile += _T(".tmp");
+
+    HANDLE hFile = CreateFile(tmpFile.C_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return;
+
+    SessionHeader hdr;
+    memcpy(hdr.magic, cSessionMagic, sizeof(hdr.magic));
+    hdr.version     = cSessionVersion;
+    hdr.recordSize  = sizeof(TabParser::Record);
+    hdr.tabsCount   = 0;
+    hdr.activeTab   = TabCtrl_GetCurSel(_hTab);
+
+    bool success = writeData(hFile, &hdr, sizeof(hdr));
+
+    for (int i = 0; success && i < tabsCount; ++i)
+    {
+        const Tab* tab = getTab(i);
+        if (!tab)
+            continue;
+
+        // Results that are already known to be outdated are restored as stale
+        const uint64_t generation =
+                (tab->_dirty || !tab->_staleFiles.empty()) ? 0 : dbGeneration(tab->_projectPath);
+
+        success = tab->Save(hFile, generation);
+        ++hdr.tabsCount;
+    }
+
+    success = success && SetFilePointer(hFile, 0, NULL, FILE_BEGIN) != INVALID_SET_FILE_POINTER &&
+            writeData(hFile, &hdr, sizeof(hdr));
+
+    CloseHandle(hFile);
+    closeSession();
+
+    if (!success || !MoveFileEx(tmpFile.C_str(), sessionFile.C_str(), MOVEFILE_REPLACE_EXISTING))
+        DeleteFile(tmpFile.C_str());
+}
+
+
+/**
+ *  \brief  Only the tabs list is read - each tab results stay in the mapped file until the tab is shown
+ */
+void ResultWin::restoreSession()
+{
+    _sessionEnabled = true;
+
+    CPath sessionFile;
+    INpp::Get().GetPluginsConfDir(sessionFile);
+    sessionFile += cResultsFileName;
+
+    if (!sessionFile.FileExists())
+        return;
+
+    _hSessionFile = CreateFile(sessionFile.C_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, NULL);
+    if (_hSessionFile == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(_hSessionFile, &size) || size.QuadPart < (LONGLONG)sizeof(SessionHeader) ||
+        (uint64_t)size.QuadPart > SIZE_MAX)
+    {
+        closeSession();
+        return;
+    }
+
+    _hSessionMap = CreateFileMapping(_hSessionFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (_hSessionMap)
+        _sessionView = static_cast<const char*>(MapViewOfFile(_hSessionMap, FILE_MAP_READ, 0, 0, 0));
+
+    if (!_sessionView)
+    {
+        closeSession();
+        return;
+    }
+
+    SessionHeader hdr;
+    memcpy(&hdr, _sessionView, sizeof(hdr));
+
+    if (memcmp(hdr.magic, cSessionMagic, sizeof(hdr.magic)) || hdr.version != cSessionVersion ||
+            hdr.recordSize != sizeof(TabParser::Record))
+    {
+        closeSession();
+        return;
+    }
+
+    const char* pData = _sessionView + sizeof(hdr);
+    const char* const pEnd = _sessionView + (size_t)size.QuadPart;
+
+    int restored = 0;
+
+    for (uint32_t i = 0; i < hdr.tabsCount; ++i)
+    {
+        uint64_t generation;
+
+        Tab* tab = Tab::Restore(pData, pEnd, generation);
+        if (!tab)
+            break;
+
+        // The database has changed since - show the old results and re-run
+        if (!tab->_merged && (generation == 0 || generation != dbGeneration(tab->_projectPath)))
+            tab->_dirty = true;
+
+        TCHAR buf[64];
+        _sntprintf_s(buf, _countof(buf), _TRUNCATE, _T("%s \"%s\""),
+                tab->_merged ? cMergedTabName : Cmd::CmdName[tab->_cmdId], CText(tab->_search.C_str()).C_str());
+
+        TCITEM tci  = {0};
+        tci.mask    = TCIF_TEXT | TCIF_PARAM;
+        tci.pszText = buf;
+        tci.lParam  = (LPARAM)tab;
+
+        if (TabCtrl_InsertItem(_hTab, restored, &tci) == -1)
+        {
+            delete tab;
+            break;
+        }
+
+        ++restored;
+    }
+
+    if (restored == 0)
+    {
+        closeSession();
+        return;
+    }
+
+    // The active tab is loaded when the window is shown
+    TabCtrl_SetCurSel(_hTab, (hdr.activeTab >= 0 && hdr.activeTab < restored) ? hdr.activeTab : 0);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::closeSession()
+{
+    if (_sessionView)
+    {
+        UnmapViewOfFile(_sessionView);
+        _sessionView = NULL;
+    }
+
+    if (_hSessionMap)
+    {
+        CloseHandle(_hSessionMap);
+        _hSessionMap = NULL;
+    }
+
+    if (_hSessionFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_hSessionFile);
+        _hSessionFile = INVALID_HANDLE_VALUE;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::visitSingleResult(ResultWin::Tab* tab)
+{
+    const TabParser* parser = dynamic_cast<TabParser*>(tab->_parser.get());
+
+    if (parser->getHitsCount() != 1 || parser->isTruncated())
+        return false;
+
+    intptr_t line = -1;
+
+    if (tab->_cmdId != FIND_FILE)
+    {
+        const std::string results(parser->GetText().C_str());
+
+        const size_t pos = results.rfind("\t\tline ");
+        if (pos != std::string::npos)
+        {
+            const std::string lineNum = results.substr(pos + 7);
+            line = (intptr_t)std::stoll(lineNum) - 1;
+        }
+    }
+
+    CPath file;
+
+    // Path is not absolute (does not start with drive letter)
+    if ((parser->getFirstFileResult().c_str()[0] != '/') && (parser->getFirstFileResult().c_str()[1] != ':'))
+        file = tab->_projectPath.C_str();
+
+    file += parser->getFirstFileResult().c_str();
+    file.NormalizePathSlashes();
+
+    INpp& npp = INpp::Get();
+    if (!file.FileExists())
+    {
+        MessageBox(npp.GetHandle(),
+                _T("File not found, database seems outdated.")
+                _T("\nPlease re-create it and redo the search."),
+                cPluginName, MB_OK | MB_ICONEXCLAMATION);
+        return true;
+    }
+
+    CPath currentFile;
+    npp.GetFilePathFromBufID(npp.getCurrentBuffId(), currentFile);
+
+    bool sameLine = false;
+    bool sameLocation = false;
+
+    // if already there just return
+    if (currentFile == file)
+    {
+        if (tab->_cmdId == FIND_FILE)
+            return true;
+
+        sameLine = npp.GetCurrentLine() == line;
+        sameLocation = npp.IsLineVisible(line);
+    }
+
+    if (!sameLocation)
+    {
+        Tools::ReleaseKeys();
+
+        npp.ClearSelectionMulti();
+
+        DocLocation::Get().Push();
+        npp.OpenFile(file.C_str());
+    }
+
+    if (tab->_cmdId == FIND_FILE)
+        return true;
+
+    const bool wholeWord    = (tab->_cmdId != GREP && tab->_cmdId != GREP_TEXT);
+    intptr_t findBegin      = npp.PositionFromLine(line);
+    intptr_t findEnd        = npp.LineEndPosition(line);
+
+    if (!npp.SearchText(tab->_search.C_str(), tab->_ignoreCase, wholeWord, tab->_regExp,
+        &findBegin, &findEnd, sameLocation))
+    {
+        MessageBox(npp.GetHandle(),
+                _T("Look-up mismatch, database seems outdated.")
+                _T("\nSave all modified files, re-create it and redo the search."),
+                cPluginName, MB_OK | MB_ICONEXCLAMATION);
+    }
+    else if (sameLocation && sameLine)
+    {
+        Sleep(50);
+        npp.ClearSelectionMulti();
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::openItem(intptr_t lineNum, unsigned matchNum)
+{
+    Tools::ReleaseKeys();
+
+    const intptr_t pos = sendSci(SCI_GETCURRENTPOS, 0, 0);
+    sendSci(SCI_SETSEL, pos, pos);
+
+    const TabParser* parser = dynamic_cast<const TabParser*>(_activeTab->_parser.get());
+
+    const TabParser::Record* rec = parser->getRecord(lineNum);
+    if (rec == NULL || (_activeTab->_cmdId != FIND_FILE && rec->line < 0))
+        return false;
+
+    const intptr_t line = rec->line;
+    const std::string& resultFile = parser->getRecordFile(*rec);
+
+    CPath file;
+
+    // Path is not absolute (does not start with drive letter)
+    if ((resultFile.size() < 3) || ((resultFile[0] != '/') && (resultFile[1] != ':')))
+        file = _activeTab->_projectPath.C_str();
+
+    file += resultFile.c_str();
+    file.NormalizePathSlashes();
+
+    INpp& npp = INpp::Get();
+    if (!file.FileExists())
+    {
+        MessageBox(npp.GetHandle(),
+                _T("File not found, present results are outdated.")
+                _T("\nPlease re-create database and redo the search."),
+                cPluginName, MB_OK | MB_ICONEXCLAMATION);
+        return false;
+    }
+
+    if (_activeTab->_cmdId == FIND_DEFINITION && !_activeTab->_regExp)
+    {
+        DbHandle db = DbManager::Get().FindDb(CPath(_activeTab->_projectPath.C_str()));
+        if (db)
+            db->Usage().RecordVisit(CText(_activeTab->_search.C_str()).C_str());
+    }
+
+    CPath currentFile;
+    npp.GetFilePathFromBufID(npp.getCurrentBuffId(), currentFile);
+
+    bool sameLocation = false;
+
+    // if already there just return
+    if (currentFile == file)
+    {
+        if (_activeTab->_cmdId == FIND_FILE)
+            return true;
+
+        sameLocation = npp.IsLineVisible(line);
+    }
+
+    if (!sameLocation)
+    {
+        Tools::ReleaseKeys();
+
+        npp.ClearSelectionMulti();
+
+        DocLocation::Get().Push();
+        npp.OpenFile(file.C_str());
+    }
+
+    if (_activeTab->_cmdId == FIND_FILE)
+        return true;
+
+    const intptr_t endPos = npp.LineEndPosition(line);
+
+    // The match columns are known unless it is a regexp search - select the match directly if the text there
+    // is still the same
+    const intptr_t col = parser->getMatchColumn(*rec, matchNum);
+
+    if (col >= 0)
+    {
+        const intptr_t findBegin    = npp.PositionFromLine(line) + col;
+        const intptr_t findEnd      = findBegin + (intptr_t)_activeTab->_search.Len();
+
+        if (findEnd <= endPos &&
+            npp.IsTextAt(findBegin, _activeTab->_search.C_str(), _activeTab->_search.Len(), _activeTab->_ignoreCase))
+        {
+            if (sameLocation)
+            {
+                npp.SetSelection(findBegin, findEnd);
+                SetFocus(npp.GetSciHandle());
+            }
+            else
+            {
+                npp.SetView(findBegin, findEnd);
+            }
+
+            return true;
+        }
+    }
+
+    const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
+
+    // Highlight the corresponding match number if there are more than one
+    // matches on single result line
+    for (intptr_t findBegin = npp.PositionFromLine(line), findEnd = endPos;
+        matchNum; findBegin = findEnd, findEnd = endPos, --matchNum)
+    {
+        if (!npp.SearchText(_activeTab->_search.C_str(), _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp,
+                &findBegin, &findEnd, sameLocation))
+        {
+            MessageBox(npp.GetHandle(),
+                    _T("Look-up mismatch, present results are outdated.")
+                    _T("\nSave all modified files and redo the search."),
+                    cPluginName, MB_OK | MB_ICONEXCLAMATION);
+            return false;
+        }
+        else if (sameLocation)
+        {
+            SetFocus(npp.GetSciHandle());
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::isLoadMoreLine(intptr_t lineNum)
+{
+    const TabParser* parser = dynamic_cast<const TabParser*>(_activeTab->_parser.get());
+
+    return (parser->isTruncated() && lineNum > 0 && lineNum == sendSci(SCI_GETLINECOUNT) - 1);
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::findString(const char* str, intptr_t* startPos, intptr_t* endPos,
+    bool ignoreCase, bool wholeWord, bool regExp)
+{
+    int searchFlags = 0;
+    if (!ignoreCase)
+        searchFlags |= SCFIND_MATCHCASE;
+    if (wholeWord)
+        searchFlags |= SCFIND_WHOLEWORD;
+    if (regExp)
+        searchFlags |= (SCFIND_REGEXP | SCFIND_POSIX);
+
+    sendSci(SCI_SETSEARCHFLAGS, searchFlags);
+    sendSci(SCI_SETTARGETSTART, *startPos);
+    sendSci(SCI_SETTARGETEND, *endPos);
+
+    if (sendSci(SCI_SEARCHINTARGET, strlen(str), reinterpret_cast<LPARAM>(str)) >= 0)
+    {
+        *startPos = sendSci(SCI_GETTARGETSTART);
+        *endPos = sendSci(SCI_GETTARGETEND);
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ *  \brief  Finds all str matches in the shown tab at once. Scintilla still does the matching, as before,
+ *          but only in the lines that contain a text every match must have
+ */
+void ResultWin::findAllMatches(const char* str, bool ignoreCase, bool wholeWord, bool regExp)
+{
+    _searchMatches.txt          = str;
+    _searchMatches.ignoreCase   = ignoreCase;
+    _searchMatches.wholeWord    = wholeWord;
+    _searchMatches.regExp       = regExp;
+    _searchMatches.valid        = true;
+
+    _searchMatches.pos.clear();
+
+    const CTextA& text = _activeTab->_parser->GetText();
+    const char* const pBuf = text.C_str();
+    const char* const pEnd = pBuf + text.Len();
+
+    std::string literal = regExp ? regExpLiteral(str) : std::string(str);
+
+    // Scintilla folds the case of the non-ASCII letters as well
+    if (ignoreCase && std::any_of(literal.begin(), literal.end(), [](char c) { return ((c & 0x80) != 0); }))
+        literal.clear();
+
+    if (literal.empty())
+    {
+        findMatches(str, 0, pEnd - pBuf);
+        return;
+    }
+
+    const size_t len = literal.size();
+
+    for (const char* pSrc = pBuf; (pSrc = findLiteral(pSrc, pEnd, literal, ignoreCase)) != NULL;)
+    {
+        // The literal search matches are found already
+        if (!regExp)
+        {
+            if (wholeWord && ((pSrc > pBuf && isWordChar(*(pSrc - 1))) ||
+                    (pSrc + len < pEnd && isWordChar(pSrc[len]))))
+            {
+                ++pSrc;
+                continue;
+            }
+
+            _searchMatches.pos.emplace_back(pSrc - pBuf, pSrc + len - pBuf);
+            pSrc += len;
+            continue;
+        }
+
+        // Scintilla regexps match within a line
+        const char* pLine = pSrc;
+        for (; pLine > pBuf && *(pLine - 1) != '\n'; --pLine);
+
+        const char* pEol = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc));
+        if (pEol == NULL)
+            pEol = pEnd;
+
+        findMatches(str, pLine - pBuf, pEol - pBuf);
+        pSrc = pEol;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::findMatches(const char* str, intptr_t startPos, intptr_t endPos)
+{
+    while (startPos < endPos)
+    {
+        intptr_t findBegin = startPos;
+        intptr_t findEnd = endPos;
+
+        if (!findString(str, &findBegin, &findEnd,
+                _searchMatches.ignoreCase, _searchMatches.wholeWord, _searchMatches.regExp))
+            break;
+
+        _searchMatches.pos.emplace_back(findBegin, findEnd);
+
+        // Don't get stuck on empty regexp matches
+        startPos = (findEnd > findBegin) ? findEnd : findEnd + 1;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::showMatchesCount(size_t matchIdx)
+{
+    if (!_hSearch)
+        return;
+
+    TCHAR title[64];
+
+    if (_searchMatches.pos.empty())
+        _sntprintf_s(title, _countof(title), _TRUNCATE, _T("%s - no matches"), cSearchTitle);
+    else
+        _sntprintf_s(title, _countof(title), _TRUNCATE, _T("%s (%u of %u)"), cSearchTitle,
+                (unsigned)(matchIdx + 1), (unsigned)_searchMatches.pos.size());
+
+    SetWindowText(_hSearch, title);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::toggleFolding(intptr_t lineNum)
+{
+    sendSci(SCI_GOTOLINE, lineNum);
+    sendSci(SCI_TOGGLEFOLD, lineNum);
+
+    const TabParser::Record* rec = dynamic_cast<TabParser*>(_activeTab->_parser.get())->getRecord(lineNum);
+    if (!rec)
+        return;
+
+    if (sendSci(SCI_GETFOLDEXPANDED, lineNum))
+        _activeTab->ClearFolded(rec->file);
+    else
+        _activeTab->SetFolded(rec->file);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::foldAll(int foldAction)
+{
+    sendSci(SCI_FOLDALL, foldAction);
+
+    const intptr_t linesCount = sendSci(SCI_GETLINECOUNT);
+
+    intptr_t lineNum = 1;
+    for (; lineNum < linesCount && !(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG); ++lineNum);
+
+    if (lineNum == linesCount)
+        return;
+
+    // SCI_FOLDALL sets all headers the same way so the first one tells what has been done
+    if (sendSci(SCI_GETFOLDEXPANDED, lineNum))
+        _activeTab->ClearAllFolded(dynamic_cast<TabParser*>(_activeTab->_parser.get())->getRecordFilesCount());
+    else
+        _activeTab->SetAllFolded();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onStyleNeeded(SCNotification* notify)
+{
+    if (_activeTab == NULL)
+        return;
+
+    const TabParser* parser = dynamic_cast<TabParser*>(_activeTab->_parser.get());
+
+    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETENDSTYLED));
+    const intptr_t endStylingPos = notify->position;
+
+    for (intptr_t startPos = sendSci(SCI_POSITIONFROMLINE, lineNum); endStylingPos > startPos;
+            startPos = sendSci(SCI_POSITIONFROMLINE, ++lineNum))
+    {
+        const intptr_t lineLen = sendSci(SCI_LINELENGTH, lineNum);
+        if (lineLen <= 0)
+            continue;
+
+        const intptr_t endPos = startPos + lineLen;
+
+        sendSci(SCI_STARTSTYLING, startPos, 0xFF);
+
+        if (isLoadMoreLine(lineNum))
+        {
+            sendSci(SCI_SETSTYLING, lineLen, SCE_GTAGS_LINE_NUM);
+            sendSci(SCI_SETFOLDLEVEL, lineNum, FILE_HEADER_LVL);
+        }
+        else if ((char)sendSci(SCI_GETCHARAT, startPos) != '\t')
+        {
+            size_t pathLen = _activeTab->_projectPath.Len();
+
+            // 2 * '"' + LF + CR = 4 so length to style is modified with -4 and +1 (as it is length)
+            sendSci(SCI_SETSTYLING, lineLen - pathLen - parser->getHeaderStatusLen() - 3, SCE_GTAGS_HEADER);
+            sendSci(SCI_SETSTYLING, pathLen + 2, SCE_GTAGS_PROJECT_PATH);
+            sendSci(SCI_SETSTYLING, parser->getHeaderStatusLen(), SCE_GTAGS_HEADER);
+        }
+        else
+        {
+            const TabParser::Record* rec = _activeTab->_regExp ? NULL : parser->getRecord(lineNum);
+
+            if ((char)sendSci(SCI_GETCHARAT, startPos + 1) != '\t')
+            {
+                if (_activeTab->_cmdId == FIND_FILE && rec)
+                {
+                    sendSci(SCI_SETSTYLING, 1, SCE_GTAGS_FILE);
+                    styleMatches(parser, *rec, startPos + 1, endPos, SCE_GTAGS_FILE);
+                }
+                else if (_activeTab->_cmdId == FIND_FILE)
+                {
+                    intptr_t findBegin = startPos;
+                    intptr_t findEnd = endPos;
+
+                    if (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
+                        _activeTab->_ignoreCase, false, _activeTab->_regExp))
+                    {
+                        // Highlight all matches in a single result line
+                        do
+                        {
+                            if (findBegin - startPos)
+                                sendSci(SCI_SETSTYLING, findBegin - startPos, SCE_GTAGS_FILE);
+
+                            sendSci(SCI_SETSTYLING, findEnd - findBegin, SCE_GTAGS_WORD2SEARCH);
+
+                            findBegin = startPos = findEnd;
+                            findEnd = endPos;
+                        }
+                        while (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
+                                _activeTab->_ignoreCase, false, _activeTab->_regExp));
+
+                        if (endPos - startPos)
+                            sendSci(SCI_SETSTYLING, endPos - startPos, SCE_GTAGS_FILE);
+                    }
+                    else
+                    {
+                        sendSci(SCI_SETSTYLING, lineLen, SCE_GTAGS_FILE);
+                    }
+                }
+                else
+                {
+                    const TabParser::Record* fileRec = parser->getRecord(lineNum);
+                    const int depth = fileRec ? (int)fileRec->indent : 0;
+
+                    sendSci(SCI_SETSTYLING, lineLen, SCE_GTAGS_FILE);
+                    sendSci(SCI_SETFOLDLEVEL, lineNum, (FILE_HEADER_LVL + depth) | SC_FOLDLEVELHEADERFLAG);
+
+                    if (!fileRec || _activeTab->IsFolded(fileRec->file))
+                        sendSci(SCI_FOLDLINE, lineNum, SC_FOLDACTION_CONTRACT);
+                }
+            }
+            else
+            {
+                // "\t\tline: Num" - 'N' is at position 8
+                intptr_t previewPos = startPos + 8;
+                for (; (char)sendSci(SCI_GETCHARAT, previewPos) != '\t'; ++previewPos);
+
+                intptr_t findBegin = previewPos;
+                intptr_t findEnd = endPos;
+
+                const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
+
+                if (rec)
+                {
+                    sendSci(SCI_SETSTYLING, previewPos + 1 - startPos, SCE_GTAGS_LINE_NUM);
+                    styleMatches(parser, *rec, previewPos + 1, endPos, STYLE_DEFAULT);
+                }
+                else if (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
+                    _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp))
+                {
+                    sendSci(SCI_SETSTYLING, previewPos - startPos, SCE_GTAGS_LINE_NUM);
+
+                    // Highlight all matches in a single result line
+                    do
+                    {
+                        if (findBegin - previewPos)
+                            sendSci(SCI_SETSTYLING, findBegin - previewPos, STYLE_DEFAULT);
+
+                        sendSci(SCI_SETSTYLING, findEnd - findBegin, SCE_GTAGS_WORD2SEARCH);
+
+                        findBegin = previewPos = findEnd;
+                        findEnd = endPos;
+                    }
+                    while (findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
+                            _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp));
+
+                    if (endPos - previewPos)
+                        sendSci(SCI_SETSTYLING, endPos - previewPos, STYLE_DEFAULT);
+                }
+                else
+                {
+                    sendSci(SCI_SETSTYLING, lineLen, STYLE_DEFAULT);
+                }
+
+                // The lines before are styled already - the file line or a result line of the same file
+                const int prevLevel = (int)sendSci(SCI_GETFOLDLEVEL, lineNum - 1);
+
+                sendSci(SCI_SETFOLDLEVEL, lineNum,
+                        (prevLevel & SC_FOLDLEVELNUMBERMASK) + ((prevLevel & SC_FOLDLEVELHEADERFLAG) ? 1 : 0));
+            }
+        }
+    }
+}
+
+
+/**
+ *  \brief  Styles the result line text starting at textPos highlighting the matches found on parse
+ */
+void ResultWin::styleMatches(const TabParser* parser, const TabParser::Record& rec, intptr_t textPos,
+        intptr_t endPos, int textStyle)
+{
+    const intptr_t matchLen = (intptr_t)_activeTab->_search.Len();
+
+    for (unsigned i = 1; i <= rec.colsCount; ++i)
+    {
+        const intptr_t matchPos = textPos + parser->getMatchColumn(rec, i) - (intptr_t)rec.indent;
+        if (matchPos + matchLen > endPos)
+            break;
+
+        if (matchPos > textPos)
+            sendSci(SCI_SETSTYLING, matchPos - textPos, textStyle);
+
+        sendSci(SCI_SETSTYLING, matchLen, SCE_GTAGS_WORD2SEARCH);
+
+        textPos = matchPos + matchLen;
+    }
+
+    if (endPos > textPos)
+        sendSci(SCI_SETSTYLING, endPos - textPos, textStyle);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onNewPosition()
+{
+    const intptr_t pos = sendSci(SCI_GETCURRENTPOS);
+
+    if (pos == sendSci(SCI_POSITIONAFTER, pos)) // end of document
+    {
+        const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, sendSci(SCI_LINEFROMPOSITION, pos));
+        if (!sendSci(SCI_GETFOLDEXPANDED, foldLine))
+            sendSci(SCI_GOTOLINE, foldLine);
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onHotspotClick(SCNotification* notify)
+{
+    const intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
+    unsigned matchNum = 1;
+
+    if (_activeTab->_cmdId != FIND_FILE)
+    {
+        const intptr_t endLine = sendSci(SCI_GETLINEENDPOSITION, lineNum);
+
+        // "\t\tline: Num" - 'N' is at position 8
+        intptr_t findBegin = sendSci(SCI_POSITIONFROMLINE, lineNum) + 8;
+        for (; (char)sendSci(SCI_GETCHARAT, findBegin) != '\t'; ++findBegin);
+
+        const TabParser* parser = dynamic_cast<const TabParser*>(_activeTab->_parser.get());
+        const TabParser::Record* rec = _activeTab->_regExp ? NULL : parser->getRecord(lineNum);
+
+        if (rec)
+        {
+            // Match positions are known - the clicked one is the last starting before the click
+            const intptr_t textPos = findBegin + 1 - (intptr_t)rec->indent;
+
+            for (unsigned i = 2; i <= rec->colsCount; ++i)
+            {
+                if (textPos + parser->getMatchColumn(*rec, i) > notify->position)
+                    break;
+
+                matchNum = i;
+            }
+
+            openItem(lineNum, matchNum);
+            return;
+        }
+
+        const bool wholeWord = (_activeTab->_cmdId != GREP && _activeTab->_cmdId != GREP_TEXT);
+
+        // Find which hotspot was clicked in case there are more than one
+        // matches on single result line
+        for (intptr_t findEnd = endLine; findString(_activeTab->_search.C_str(), &findBegin, &findEnd,
+                    _activeTab->_ignoreCase, wholeWord, _activeTab->_regExp);
+                findBegin = findEnd, findEnd = endLine, ++matchNum)
+            if (notify->position >= findBegin && notify->position <= findEnd)
+                break;
+    }
+
+    openItem(lineNum, matchNum);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onDoubleClick(intptr_t pos)
+{
+    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
+
+    if (lineNum == 0)
+    {
+        pos = sendSci(SCI_GETCURRENTPOS);
+        if (pos == sendSci(SCI_POSITIONAFTER, pos)) // end of document
+        {
+            lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
+            const intptr_t foldLine = visibleLine(lineNum);
+            if (foldLine != lineNum)
+            {
+                lineNum = foldLine;
+                pos = sendSci(SCI_POSITIONFROMLINE, lineNum);
+            }
+        }
+        else
+        {
+            lineNum = sendSci(SCI_LINEFROMPOSITION, pos);
+        }
+    }
+
+    if (lineNum == 0)
+    {
+        sendSci(SCI_GOTOLINE, 0); // Clear double click selection
+        foldAll(SC_FOLDACTION_TOGGLE);
+    }
+    else if (lineNum > 0)
+    {
+        if (isLoadMoreLine(lineNum))
+        {
+            sendSci(SCI_GOTOLINE, lineNum); // Clear double click selection
+            loadMoreResults();
+        }
+        else if (sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG)
+        {
+            toggleFolding(lineNum);
+        }
+        else
+        {
+            openItem(lineNum);
+        }
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onMarginClick(SCNotification* notify)
+{
+    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
+
+    if (lineNum == 0)
+    {
+        foldAll(SC_FOLDACTION_TOGGLE);
+    }
+    else
+    {
+        if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
+            lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
+
+        if (lineNum > 0)
+        {
+            toggleFolding(lineNum);
+        }
+        else
+        {
+            lineNum = sendSci(SCI_LINEFROMPOSITION, notify->position);
+            sendSci(SCI_GOTOLINE, lineNum);
+        }
+    }
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::onKeyPress(WORD keyCode, bool alt)
+{
+    const intptr_t currentPos = sendSci(SCI_GETCURRENTPOS);
+    intptr_t lineNum = sendSci(SCI_LINEFROMPOSITION, currentPos);
+
+    switch (keyCode)
+    {
+        case VK_UP:
+        {
+            intptr_t linePosOffset = currentPos - sendSci(SCI_POSITIONFROMLINE, lineNum);
+
+            if (--lineNum >= 0)
+            {
+                lineNum = visibleLine(lineNum);
+
+                const intptr_t lineStart = sendSci(SCI_POSITIONFROMLINE, lineNum);
+                const intptr_t lineEnd = sendSci(SCI_GETLINEENDPOSITION, lineNum);
+
+                if (linePosOffset > lineEnd - lineStart)
+                    linePosOffset = lineEnd - lineStart;
+
+                sendSci(SCI_GOTOPOS, lineStart + linePosOffset);
+            }
+        }
+        return true;
+
+        case VK_DOWN:
+        {
+            intptr_t linePosOffset = currentPos - sendSci(SCI_POSITIONFROMLINE, lineNum);
+
+            if (++lineNum < sendSci(SCI_GETLINECOUNT))
+            {
+                const intptr_t foldLine = visibleLine(lineNum);
+                if (foldLine != lineNum)
+                {
+                    const intptr_t nextFold =
+                            sendSci(SCI_GETLASTCHILD, foldLine, sendSci(SCI_GETFOLDLEVEL, foldLine)) + 1;
+                    lineNum = (nextFold < sendSci(SCI_GETLINECOUNT)) ? nextFold : foldLine;
+                }
+
+                const intptr_t lineStart = sendSci(SCI_POSITIONFROMLINE, lineNum);
+                const intptr_t lineEnd = sendSci(SCI_GETLINEENDPOSITION, lineNum);
+
+                if (linePosOffset > lineEnd - lineStart)
+                    linePosOffset = lineEnd - lineStart;
+
+                sendSci(SCI_GOTOPOS, lineStart + linePosOffset);
+            }
+        }
+        return true;
+
+        case VK_LEFT:
+            if (alt)
+            {
+                int i = TabCtrl_GetCurSel(_hTab);
+
+                if (i > 0)
+                {
+                    Tab* tab = getTab(--i);
+                    if (tab)
+                    {
+                        TabCtrl_SetCurSel(_hTab, i);
+                        loadTab(tab);
+                    }
+                }
+
+                return true;
+            }
+        break;
+
+        case VK_RIGHT:
+            if (alt)
+            {
+                int i = TabCtrl_GetCurSel(_hTab);
+
+                if (i < TabCtrl_GetItemCount(_hTab) - 1)
+                {
+                    Tab* tab = getTab(++i);
+                    if (tab)
+                    {
+                        TabCtrl_SetCurSel(_hTab, i);
+                        loadTab(tab);
+                    }
+                }
+
+                return true;
+            }
+        break;
+
+        case VK_PRIOR:
+        {
+            const intptr_t linesOnScreen = sendSci(SCI_LINESONSCREEN);
+            sendSci(SCI_LINESCROLL, 0, -linesOnScreen);
+            lineNum = sendSci(SCI_DOCLINEFROMVISIBLE, sendSci(SCI_GETFIRSTVISIBLELINE));
+            sendSci(SCI_GOTOLINE, lineNum);
+        }
+        return true;
+
+        case VK_NEXT:
+        {
+            const intptr_t linesOnScreen     = sendSci(SCI_LINESONSCREEN);
+            const intptr_t firstVisibleLine  = sendSci(SCI_GETFIRSTVISIBLELINE);
+            sendSci(SCI_LINESCROLL, 0, linesOnScreen);
+            const intptr_t newFirstVisible   = sendSci(SCI_GETFIRSTVISIBLELINE);
+
+            if (newFirstVisible - firstVisibleLine >= linesOnScreen)
+            {
+                lineNum = sendSci(SCI_DOCLINEFROMVISIBLE, newFirstVisible);
+            }
+            else
+            {
+                lineNum = visibleLine(sendSci(SCI_GETLINECOUNT) - 1);
+            }
+
+            sendSci(SCI_GOTOLINE, lineNum);
+        }
+        return true;
+
+        case VK_ADD:
+            if (alt || lineNum == 0)
+            {
+                foldAll(SC_FOLDACTION_EXPAND);
+            }
+            else
+            {
+                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
+                    lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
+                if (lineNum > 0 && !sendSci(SCI_GETFOLDEXPANDED, lineNum))
+                    toggleFolding(lineNum);
+            }
+        return true;
+
+        case VK_SUBTRACT:
+            if (alt || lineNum == 0)
+            {
+                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG) && lineNum)
+                {
+                    const intptr_t foldLine = sendSci(SCI_GETFOLDPARENT, lineNum);
+                    if (foldLine > 0)
+                        sendSci(SCI_GOTOLINE, foldLine);
+                }
+                foldAll(SC_FOLDACTION_CONTRACT);
+            }
+            else
+            {
+                if (!(sendSci(SCI_GETFOLDLEVEL, lineNum) & SC_FOLDLEVELHEADERFLAG))
+                    lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
+                if (lineNum > 0 && sendSci(SCI_GETFOLDEXPANDED, lineNum))
+                    toggleFolding(lineNum);
+            }
+        return true;
+
+        default:;
+    }
+
+    return false;
+}
+
+
+/**
+ *  \brief  Returns lineNum or its closest visible fold parent if it is folded - directories can be nested
+ */
+intptr_t ResultWin::visibleLine(intptr_t lineNum)
+{
+    while (lineNum > 0 && !sendSci(SCI_GETLINEVISIBLE, lineNum))
+        lineNum = sendSci(SCI_GETFOLDPARENT, lineNum);
+
+    return lineNum;
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onTabChange()
+{
+    Tab* tab = getTab();
+    if (tab)
+        loadTab(tab);
+}
+
+
+/**
+ *  \brief  Merges the results of all tabs searching for the same as the active one (any command, any database)
+ *          in a new tab. Each result line is tagged with the number of its source search listed in the header
+ */
+void ResultWin::mergeTabs()
+{
+    if (!_activeTab || _activeTab->_merged || _activeTab->_cmdId == FIND_FILE)
+        return;
+
+    std::vector<Tab*> sources;
+    int mergedIdx = -1;
+
+    for (int i = 0; i < TabCtrl_GetItemCount(_hTab); ++i)
+    {
+        Tab* tab = getTab(i);
+
+        if (!tab || tab->_cmdId == FIND_FILE || tab->_search != _activeTab->_search ||
+                tab->_ignoreCase != _activeTab->_ignoreCase || tab->_regExp != _activeTab->_regExp)
+            continue;
+
+        if (tab->_merged)
+            mergedIdx = i;
+        else
+            sources.push_back(tab);
+    }
+
+    if (sources.size() < 2)
+        return;
+
+    // The merged results paths are relative to the sources common project folder
+    std::string root(sources[0]->_projectPath.C_str());
+
+    for (const Tab* tab : sources)
+    {
+        const char* path = tab->_projectPath.C_str();
+
+        size_t len = 0;
+        for (; len < root.size() && path[len] &&
+                tolower((unsigned char)path[len]) == tolower((unsigned char)root[len]); ++len);
+        for (; len && root[len - 1] != '\\' && root[len - 1] != '/'; --len);
+
+        root.resize(len);
+    }
+
+    // Databases on different drives
+    if (root.empty())
+        return;
+
+    std::string header = "Merged \"";
+    header += _activeTab->_search.C_str();
+    header += "\" (";
+
+    std::vector<TabParser::MergeSource> mergeSources;
+
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        Tab* tab = sources[i];
+
+        reloadTab(tab);
+
+        TabParser::MergeSource src;
+        src.parser = dynamic_cast<const TabParser*>(tab->_parser.get());
+        src.pathPrefix = tab->_projectPath.C_str() + root.size();
+        std::replace(src.pathPrefix.begin(), src.pathPrefix.end(), '\\', '/');
+        src.tag = " [" + std::to_string(i + 1) + "]";
+
+        if (i)
+            header += ", ";
+        header += src.tag.c_str() + 1;
+        header += " ";
+        header += CTextA(Cmd::CmdName[tab->_cmdId]).C_str();
+
+        if (!src.pathPrefix.empty())
+        {
+            header += " in ";
+            header += src.pathPrefix;
+        }
+
+        mergeSources.push_back(std::move(src));
+    }
+
+    header += ") in \"";
+    header += root;
+    header += "\"";
+
+    Tab* tab = new Tab(_activeTab->_cmdId, _activeTab->_regExp, _activeTab->_ignoreCase);
+
+    tab->_merged        = true;
+    tab->_projectPath   = root.c_str();
+    tab->_search        = _activeTab->_search;
+
+    dynamic_cast<TabParser*>(tab->_parser.get())->merge(mergeSources, header);
+
+    TCHAR buf[64];
+    _sntprintf_s(buf, _countof(buf), _TRUNCATE, _T("%s \"%s\""), cMergedTabName, CText(tab->_search.C_str()).C_str());
+
+    TCITEM tci  = {0};
+    tci.mask    = TCIF_TEXT | TCIF_PARAM;
+    tci.pszText = buf;
+    tci.lParam  = (LPARAM)tab;
+
+    // Replace the previous merge of the same search
+    if (mergedIdx >= 0)
+    {
+        Tab* oldTab = getTab(mergedIdx);
+
+        if (!TabCtrl_SetItem(_hTab, mergedIdx, &tci))
+        {
+            delete tab;
+            return;
+        }
+
+        delete oldTab;
+    }
+    else
+    {
+        mergedIdx = TabCtrl_InsertItem(_hTab, TabCtrl_GetCurSel(_hTab) + 1, &tci);
+        if (mergedIdx == -1)
+        {
+            delete tab;
+            return;
+        }
+    }
+
+    TabCtrl_SetCurSel(_hTab, mergedIdx);
+    loadTab(tab, true);
+}
+
+
+/**
+ *  \brief  Toggles the active tab results grouping under their directories or their sorting by hits.
+ *          The kept results are only laid out again - nothing is searched or parsed
+ */
+void ResultWin::toggleGrouping(bool dirTree)
+{
+    if (!_activeTab || _activeTab->_cmdId == FIND_FILE)
+        return;
+
+    TabParser* parser = dynamic_cast<TabParser*>(_activeTab->_parser.get());
+
+    // Continuing truncated results appends to the file groups as parsed
+    if (parser->isTruncated())
+        return;
+
+    const intptr_t currentLine = sendSci(SCI_LINEFROMPOSITION, sendSci(SCI_GETCURRENTPOS));
+
+    // Stay on the same line of the current file group or directory
+    std::string file;
+    intptr_t offset = 0;
+
+    const TabParser::Record* rec = parser->getRecord(currentLine);
+    if (rec)
+    {
+        file = parser->getRecordFile(*rec);
+
+        const auto iFile = parser->getFileResults().find(file);
+        if (iFile != parser->getFileResults().end() && currentLine >= iFile->second)
+            offset = currentLine - iFile->second;
+    }
+
+    if (dirTree)
+        parser->regroup(!parser->isDirTree(), parser->isSortedByHits());
+    else
+        parser->regroup(parser->isDirTree(), !parser->isSortedByHits());
+
+    const auto iFile = parser->getFileResults().find(file);
+
+    _activeTab->_currentLine = (iFile != parser->getFileResults().end()) ? iFile->second + offset : 0;
+    _activeTab->_firstVisibleLine = sendSci(SCI_GETFIRSTVISIBLELINE);
+
+    Tab* tab = _activeTab;
+    _activeTab = NULL;
+
+    loadTab(tab);
+
+    sendSci(SCI_SCROLLCARET);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onCloseTab()
+{
+    int i = TabCtrl_GetCurSel(_hTab);
+
+    if (_activeTab)
+    {
+        delete _activeTab;
+        _activeTab = NULL;
+    }
+
+    TabCtrl_DeleteItem(_hTab, i);
+
+    if (TabCtrl_GetItemCount(_hTab))
+    {
+        i = i ? i - 1 : 0;
+        Tab* tab = getTab(i);
+        TabCtrl_SetCurSel(_hTab, i);
+        if (tab)
+            loadTab(tab);
+    }
+    else
+    {
+        sendSci(SCI_SETREADONLY, 0);
+        sendSci(SCI_CLEARALL);
+        sendSci(SCI_SETREADONLY, 1);
+
+        hideWindow();
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::closeAllTabs()
+{
+    _activeTab = NULL;
+
+    for (int i = TabCtrl_GetItemCount(_hTab); i; --i)
+    {
+        Tab* tab = getTab(i - 1);
+        if (tab)
+            delete tab;
+        TabCtrl_DeleteItem(_hTab, i - 1);
+    }
+
+    sendSci(SCI_SETREADONLY, 0);
+    sendSci(SCI_CLEARALL);
+    sendSci(SCI_SETREADONLY, 1);
+
+    hideWindow();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onResize(int width, int height)
+{
+    RECT win = {0, 0, width, height};
+
+    MoveWindow(_hTab, 0, 0, width, height, TRUE);
+    TabCtrl_AdjustRect(_hTab, FALSE, &win);
+    MoveWindow(_hSci, win.left, win.top, win.right - win.left, win.bottom - win.top, TRUE);
+
+    onMove();
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onMove()
+{
+    if (_hSearch)
+    {
+        RECT ownerWin;
+        GetWindowRect(_hWnd, &ownerWin);
+
+        RECT win;
+        GetWindowRect(_hSearch, &win);
+
+        RECT txtWin;
+        GetWindowRect(_hSearchTxt, &txtWin);
+
+        const int hScrollSize =
+                (GetWindowLongPtr(_hSearchTxt, GWL_STYLE) & WS_HSCROLL) ? GetSystemMetrics(SM_CYHSCROLL) : 0;
+
+        MoveWindow(_hSearch,
+                ownerWin.right - (win.right - win.left) -
+                GetSystemMetrics(SM_CXSIZEFRAME) - GetSystemMetrics(SM_CXFIXEDFRAME) - GetSystemMetrics(SM_CXVSCROLL),
+                ownerWin.top +
+                GetSystemMetrics(SM_CYSIZEFRAME) + GetSystemMetrics(SM_CYFIXEDFRAME) + GetSystemMetrics(SM_CYSIZE),
+                win.right - win.left,
+                win.bottom - win.top - (txtWin.bottom - txtWin.top) + _searchTxtHeight + hScrollSize, TRUE);
+
+        GetClientRect(_hSearch, &win);
+
+        MoveWindow(_hSearchTxt,
+                0, win.bottom - _searchTxtHeight - hScrollSize,
+                win.right - win.left, _searchTxtHeight + hScrollSize, TRUE);
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::onSearch(bool reverseDir, bool keepFocus)
+{
+    if (_hSearch)
+    {
+        _lastRE = (Button_GetCheck(_hRE) == BST_CHECKED);
+        _lastIC = (Button_GetCheck(_hIC) == BST_CHECKED);
+        _lastWW = (Button_GetCheck(_hWW) == BST_CHECKED);
+
+        int txtLen = Edit_GetTextLength(_hSearchTxt);
+        if (txtLen == 0)
+        {
+            SendMessage(_hSearch, WM_CLOSE, 0, 0);
+            SetFocus(_hSci);
+            return;
+        }
+
+        _lastSearchTxt.Resize(txtLen);
+        Edit_GetText(_hSearchTxt, _lastSearchTxt.C_str(), (int)_lastSearchTxt.Size());
+    }
+    else if (_lastSearchTxt.IsEmpty())
+    {
+        return;
+    }
+
+    if (_activeTab == NULL)
+        return;
+
+    CTextA txt(_lastSearchTxt.C_str());
+
+    if (!_searchMatches.valid || _searchMatches.txt != txt || _searchMatches.ignoreCase != _lastIC ||
+            _searchMatches.wholeWord != _lastWW || _searchMatches.regExp != _lastRE)
+        findAllMatches(txt.C_str(), _lastIC, _lastWW, _lastRE);
+
+    const std::vector<std::pair<intptr_t, intptr_t>>& matches = _searchMatches.pos;
+
+    if (matches.empty())
+    {
+        showMatchesCount(0);
+
+        if (_hSearch)
+            Edit_SetSel(_hSearchTxt, 0, -1);
+
+        return;
+    }
+
+    // The first match starting at or after the search position
+    auto iMatch = std::lower_bound(matches.begin(), matches.end(),
+            sendSci(reverseDir ? SCI_GETSELECTIONSTART : SCI_GETCURRENTPOS),
+            [](const std::pair<intptr_t, intptr_t>& match, intptr_t pos) { return (match.first < pos); });
+
+    bool wrapped;
+
+    if (reverseDir)
+    {
+        wrapped = (iMatch == matches.begin());
+        if (wrapped)
+            iMatch = matches.end();
+        --iMatch;
+    }
+    else
+    {
+        wrapped = (iMatch == matches.end());
+        if (wrapped)
+            iMatch = matches.begin();
+    }
+
+    if (wrapped)
+    {
+        FLASHWINFO fi {0};
+        fi.cbSize       = sizeof(fi);
+        fi.hwnd         = INpp::Get().GetHandle();
+        fi.dwFlags      = FLASHW_ALL;
+        fi.uCount       = 3;
+        fi.dwTimeout    = 80;
+
+        FlashWindowEx(&fi);
+    }
+
+    if (!keepFocus)
+        SetFocus(_hSci);
+
+    sendSci(SCI_SETSEL, iMatch->first, iMatch->second);
+    sendSci(SCI_ENSUREVISIBLEENFORCEPOLICY, sendSci(SCI_LINEFROMPOSITION, iMatch->first));
+
+    showMatchesCount(iMatch - matches.begin());
+}
+
+
+/**
+ *  \brief
+ */
+LRESULT CALLBACK ResultWin::keyHookProc(int code, WPARAM wParam, LPARAM lParam)
+{
+    if (code >= 0)
+    {
+        HWND hWnd = GetFocus();
+
+        if (RW->_hWnd == hWnd || IsChild(RW->_hWnd, hWnd))
+        {
+            const unsigned keyDownMask = (1 << (sizeof(SHORT) * 8 - 1));
+
+            const bool ctrl     = ((GetKeyState(VK_CONTROL) & keyDownMask) != 0);
+            const bool alt      = ((GetKeyState(VK_MENU) & keyDownMask) != 0);
+            const bool shift    = ((GetKeyState(VK_SHIFT) & keyDownMask) != 0);
+
+            // Key is pressed
+            if (!(lParam & (1 << 31)))
+            {
+                if (!ctrl)
+                {
+                    if (!alt)
+                    {
+                        if ((wParam == VK_RETURN && RW->_hSearch) || wParam == VK_F3)
+                        {
+                            RW->onSearch(shift);
+                            return 1;
+                        }
+
+                        if (!shift)
+                        {
+                            if (wParam == VK_ESCAPE)
+                            {
+                                if (RW->_hSearch)
+                                {
+                                    SendMessage(RW->_hSearch, WM_CLOSE, 0, 0);
+                                    SetFocus(ResultWin::_hSci);
+                                }
+                                else
+                                {
+                                    RW->onCloseTab();
+                                }
+
+                                return 1;
+                            }
+                            if (wParam == VK_RETURN || wParam == VK_SPACE)
+                            {
+                                RW->onDoubleClick(0);
+                                return 1;
+                            }
+                            if (wParam == VK_F5)
+                            {
+                                RW->reRunCmd();
+                                return 1;
+                            }
+                        }
+                    }
+
+                    if (!shift && RW->onKeyPress(static_cast<WORD>(wParam), alt))
+                    {
+                        return 1;
+                    }
+                }
+                else if (wParam == 0x46 && !alt && !shift) // 'F'
+                {
+                    RW->createSearchWindow();
+                    return 1;
+                }
+                else if (wParam == 0x4D && !alt && !shift) // 'M'
+                {
+                    RW->mergeTabs();
+                    return 1;
+                }
+                else if (wParam == 0x44 && !alt && !shift) // 'D'
+                {
+                    RW->toggleGrouping(true);
+                    return 1;
+                }
+                else if (wParam == 0x48 && !alt && !shift) // 'H'
+                {
+                    RW->toggleGrouping(false);
+                    return 1;
+                }
+            }
+        }
+        else if (RW->_hSearch && (RW->_hSearch == hWnd || IsChild(RW->_hSearch, hWnd)))
+        {
+            const unsigned keyDownMask = (1 << (sizeof(SHORT) * 8 - 1));
+
+            const bool ctrl     = ((GetKeyState(VK_CONTROL) & keyDownMask) != 0);
+            const bool alt      = ((GetKeyState(VK_MENU) & keyDownMask) != 0);
+            const bool shift    = ((GetKeyState(VK_SHIFT) & keyDownMask) != 0);
+
+            // Key is pressed and no CTRL or ALT
+            if (!(lParam & (1 << 31)) && !ctrl && !alt)
+            {
+                if (wParam == VK_RETURN || wParam == VK_F3)
+                {
+                    RW->onSearch(shift);
+                    return 1;
+                }
+                if (wParam == VK_ESCAPE && !shift)
+                {
+                    SendMessage(RW->_hSearch, WM_CLOSE, 0, 0);
+                    SetFocus(ResultWin::_hSci);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
+
+
+/**
+ *  \brief
+ */
+LRESULT APIENTRY ResultWin::wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    switch (uMsg)
+    {
+        case WM_CREATE:
+        return 0;
+
+        case WM_SETFOCUS:
+            RW->hookKeyboard();
+            SetFocus(ResultWin::_hSci);
+        return 0;
+
+        case WM_NOTIFY:
+            switch (((LPNMHDR)lParam)->code)
+            {
+                case SCN_STYLENEEDED:
+                    RW->onStyleNeeded((SCNotification*)lParam);
+                return 0;
+
+                case SCN_UPDATEUI:
+                    if (((SCNotification*)lParam)->updated & SC_UPDATE_SELECTION)
+                        RW->onNewPosition();
+                return 0;
+
+                case SCN_HOTSPOTRELEASECLICK:
+                    RW->onHotspotClick((SCNotification*)lParam);
+                return 0;
+
+                case SCN_DOUBLECLICK:
+                    RW->onDoubleClick(((SCNotification*)lParam)->position);
+                return 0;
+
+                case SCN_MARGINCLICK:
+                    RW->onMarginClick((SCNotification*)lParam);
+                return 0;
+
+                case SCN_PAINTED:
+                    if (RW->_paintTiming)
+                    {
+                        RW->_paintTiming->Mark(CmdTiming::FIRST_PAINT);
+                        RW->_paintTiming = nullptr;
+                    }
+                return 0;
+
+                case TCN_SELCHANGE:
+                    RW->onTabChange();
+                return 0;
+
+                case DMN_CLOSE:
+                    RW->closeAllTabs();
+                return 0;
+            }
+        break;
+
+        case WM_CONTEXTMENU:
+            RW->onCloseTab();
+        break;
+
+        case WM_SIZE:
+            RW->onResize(LOWORD(lParam), HIWORD(lParam));
+        return 0;
+
+        case WM_MOVE:
+            RW->onMove();
+        return 0;
+
+        case WM_SHOWWINDOW:
+            // Shown by Notepad++ on startup if it was left open - load the restored session tab
+            if (wParam && !RW->_activeTab)
+                RW->onTabChange();
+        break;
+
+        case WM_DESTROY:
+        return 0;
+
+        // Below are WM_USER messages for DLL threads synchronization
+
+        case WM_CMD_ENGINE_EVENTS:
+            CmdEngine::ProcessEvents();
+        return 0;
+    }
+
+    return DefWindowProc(hWnd, uMsg, wParam, lParam);
+}
+
+
+/**
+ *  \brief
+ */
+LRESULT APIENTRY ResultWin::searchWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    switch (uMsg)
+    {
+        case WM_CREATE:
+            RW->onSearchWindowCreate(hWnd);
+        return 0;
+
+        case WM_SETFOCUS:
+            SetFocus(RW->_hSearchTxt);
+        return 0;
+
+        case WM_NOTIFY:
+            if (((LPNMHDR)lParam)->code == EN_REQUESTRESIZE)
+            {
+                RW->onMove();
+                return 0;
+            }
+        break;
+
+        case WM_COMMAND:
+            if (HIWORD(wParam) == BN_CLICKED)
+            {
+                if ((HWND)lParam == RW->_hDown)
+                {
+                    RW->onSearch(false, true);
+                    return 0;
+                }
+                else if ((HWND)lParam == RW->_hUp)
+                {
+                    RW->onSearch(true, true);
+                    return 0;
+                }
+            }
+        break;
+
+        case WM_DESTROY:
+            if (RW->_hSearchFont)
+            {
+                DeleteObject(RW->_hSearchFont);
+                RW->_hSearchFont = NULL;
+            }
+
+            if (RW->_hBtnFont)
+            {
+                DeleteObject(RW->_hBtnFont);
+                RW->_hBtnFont = NULL;
+            }
+
+            RW->_hSearch = NULL;
+        return 0;
+    }
+
+    return DefWindowProc(hWnd, uMsg, wParam, lParam);
+}
+
+} // namespace GTags
@@ -1,292 +1,515 @@
-/**
- *  \file
- *  \brief  GTags result Scintilla view window
- *
- *  \author  Pavel Nedev <pg.nedev@gmail.com>
- *
- *  \section COPYRIGHT
- *  Copyright(C) 2014-2024 Pavel Nedev
- *
- *  \section LICENSE
- *  This program is free software; you can redistribute it and/or modify it
- *  under the terms of the GNU General Public License version 2 as published
- *  by the Free Software Foundation.
- *
- *  This program is distributed in the hope that it will be useful, but
- *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
- *  for more details.
- *
- *  You should have received a copy of the GNU General Public License along
- *  with this program.  If not, see <http://www.gnu.org/licenses/>.
- */
-
-
-#pragma once
-
-
-#include <windows.h>
-#include <tchar.h>
-#include <cstdint>
-#include <unordered_set>
-#include <unordered_map>
-#include <memory>
-#include <string>
-#include "NppAPI/Scintilla.h"
-#include "Common.h"
-#include "Cmd.h"
-
-
-namespace GTags
-{
-
-/**
- *  \class  ResultWin
- *  \brief
- */
-class ResultWin
-{
-public:
-    /**
-     *  \class  TabParser
-     *  \brief
-     */
-    class TabParser : public ResultParser
-    {
-    public:
-        TabParser() : _filesCount(0), _hits(0), _headerStatusLen(0) {}
-        virtual ~TabParser() {}
-
-        virtual intptr_t Parse(const CmdPtr_t&);
-
-        inline intptr_t getFilesCount() const { return _filesCount; }
-        inline intptr_t getHitsCount() const { return _hits ? _hits : _filesCount; }
-        inline int getHeaderStatusLen() const { return _headerStatusLen; }
-
-        inline void addResultFile(const char* pFile, size_t len, intptr_t line)
-        {
-            _fileResults.emplace(std::string(pFile, len), line);
-        }
-
-        inline bool isFileInResults(const std::string& file) const
-        {
-            return (_fileResults.find(file) != _fileResults.end());
-        }
-
-        inline const std::string& getFirstFileResult() const { return _fileResults.begin()->first; }
-        inline const std::unordered_map<std::string, intptr_t>& getFileResults() const { return _fileResults; }
-
-    private:
-        static bool filterEntry(const DbConfig& cfg, const char* pEntry, size_t len);
-
-        intptr_t parseCmd(const CmdPtr_t&);
-        intptr_t parseFindFile(const CmdPtr_t&);
-
-        intptr_t    _filesCount;
-        intptr_t    _hits;
-        int         _headerStatusLen;
-
-        std::unordered_map<std::string, intptr_t> _fileResults;
-    };
-
-
-    static HWND Register();
-    static void Unregister();
-
-    static void Show()
-    {
-        if (RW)
-            RW->show();
-    }
-
-    static void Show(const CmdPtr_t& cmd)
-    {
-        if (RW)
-            RW->show(cmd);
-    }
-
-    static void Close(const CmdPtr_t& cmd)
-    {
-        if (RW)
-            RW->close(cmd);
-    }
-
-    static void ApplyStyle()
-    {
-        if (RW)
-            RW->applyStyle();
-    }
-
-    static void NotifyDBUpdate(const CmdPtr_t& cmd)
-    {
-        if (RW)
-            RW->notifyDBUpdate(cmd);
-    }
-
-    static HWND GetSciHandleIfFocused()
-    {
-        if (RW && GetFocus() == ResultWin::_hSci)
-            return ResultWin::_hSci;
-
-        return NULL;
-    }
-
-    static CPath GetDbPath()
-    {
-        if (RW && RW->_activeTab)
-            return CPath(RW->_activeTab->_projectPath.C_str());
-
-        return CPath();
-    }
-
-    static bool IsFocused(HWND hWnd = NULL)
-    {
-        if (hWnd == NULL)
-            hWnd = GetFocus();
-
-        return (RW && (RW->_hWnd == hWnd || IsChild(RW->_hWnd, hWnd)));
-    };
-
-    static bool Activate();
-
-    ResultWin() : _hWnd(NULL), _hKeyHook(NULL), _activeTab(NULL),
-            _hSearch(NULL), _hSearchFont(NULL), _hBtnFont(NULL),
-            _lastRE(false), _lastIC(false), _lastWW(true) {}
-    ~ResultWin();
-
-private:
-    /**
-     *  \struct  Tab
-     *  \brief
-     */
-    struct Tab
-    {
-        Tab(const CmdPtr_t& cmd);
-        ~Tab() {}
-        Tab& operator=(const Tab&) = delete;
-
-        inline bool operator==(const Tab& tab) const
-        {
-            return (_cmdId == tab._cmdId && _projectPath == tab._projectPath && _search == tab._search &&
-                    _ignoreCase == tab._ignoreCase && _regExp == tab._regExp);
-        }
-
-        const CmdId_t   _cmdId;
-        const bool      _regExp;
-        const bool      _ignoreCase;
-        CTextA          _projectPath;
-        CTextA          _search;
-        intptr_t        _currentLine;
-        intptr_t        _firstVisibleLine;
-        ParserPtr_t     _parser;
-
-        bool            _dirty;
-
-        inline void SetFolded(intptr_t lineNum);
-        inline void SetAllFolded();
-        inline void ClearFolded(intptr_t lineNum);
-        inline bool IsFolded(intptr_t lineNum);
-
-        void RestoreView(const Tab& oldTab);
-
-    private:
-        std::unordered_set<intptr_t> _expandedLines;
-    };
-
-
-    static const COLORREF   cBlack = RGB(0,0,0);
-    static const COLORREF   cWhite = RGB(255,255,255);
-
-    static const TCHAR      cClassName[];
-    static const TCHAR      cSearchClassName[];
-
-    static const int        cSearchBkgndColor;
-    static const unsigned   cSearchFontSize;
-    static const int        cSearchWidth;
-
-    static LRESULT CALLBACK keyHookProc(int code, WPARAM wParam, LPARAM lParam);
-    static LRESULT APIENTRY wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-    static LRESULT APIENTRY searchWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-
-    ResultWin(const ResultWin&);
-
-    void show();
-    void show(const CmdPtr_t& cmd);
-    void close(const CmdPtr_t& cmd);
-    void reRunCmd();
-    void applyStyle();
-    void notifyDBUpdate(const CmdPtr_t& cmd);
-
-    inline LRESULT sendSci(UINT Msg, WPARAM wParam = 0, LPARAM lParam = 0)
-    {
-        return _sciFunc(_sciPtr, static_cast<unsigned int>(Msg),
-                static_cast<uptr_t>(wParam), static_cast<sptr_t>(lParam));
-    }
-
-    void setStyle(int style, COLORREF fore = cBlack, COLORREF back = cWhite, bool bold = false, bool italic = false,
-            int size = 0, const char *font = NULL);
-
-    void configScintilla();
-    HWND composeWindow();
-    void createSearchWindow();
-    void onSearchWindowCreate(HWND hWnd);
-    void showWindow(HWND hFocus = NULL);
-    void hideWindow();
-
-    void hookKeyboard()
-    {
-        _hKeyHook = SetWindowsHookEx(WH_KEYBOARD, keyHookProc, NULL, GetCurrentThreadId());
-    }
-
-    Tab* getTab(int i = -1);
-    void loadTab(Tab* tab, bool firstTimeLoad = false);
-    bool visitSingleResult(Tab* tab);
-    bool openItem(intptr_t lineNum, unsigned matchNum = 1);
-
-    bool findString(const char* str, intptr_t* startPos, intptr_t* endPos,
-            bool ignoreCase, bool wholeWord, bool regExp);
-    void toggleFolding(intptr_t lineNum);
-    void foldAll(int foldAction);
-    void onStyleNeeded(SCNotification* notify);
-    void onNewPosition();
-    void onHotspotClick(SCNotification* notify);
-    void onDoubleClick(intptr_t pos);
-    void onMarginClick(SCNotification* notify);
-    bool onKeyPress(WORD keyCode, bool alt);
-    void onTabChange();
-    void onCloseTab();
-    void closeAllTabs();
-    void onResize(int width, int height);
-    void onMove();
-    void onSearch(bool reverseDir = false, bool keepFocus = false);
-
-    static std::unique_ptr<ResultWin> RW;
-
-    static HWND         _hSci;
-    static SciFnDirect  _sciFunc;
-    static sptr_t       _sciPtr;
-
-    HWND        _hWnd;
-    HWND        _hTab;
-    HHOOK       _hKeyHook;
-    Tab*        _activeTab;
-
-    HWND        _hSearch;
-    HWND        _hSearchTxt;
-    HWND        _hRE;
-    HWND        _hIC;
-    HWND        _hWW;
-    HWND        _hUp;
-    HWND        _hDown;
-    HFONT       _hSearchFont;
-    HFONT       _hBtnFont;
-
-    int         _searchTxtHeight;
-
-    bool        _lastRE;
-    bool        _lastIC;
-    bool        _lastWW;
-    CText       _lastSearchTxt;
-};
-
-} // namespace GTags
+/**
+ *  \file
+ *  \brief  GTags result Scintilla view window
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <cstdint>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include "NppAPI/Scintilla.h"
+#include "Common.h"
+#include "Cmd.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  ResultWin
+ *  \brief
+ */
+class ResultWin
+{
+public:
+    /**
+     *  \class  TabParser
+     *  \brief
+     */
+    class TabParser : public ResultParser
+    {
+    public:
+        /**
+         *  \struct  Record
+         *  \brief  What a result line points to - captured at parse time so opening it doesn't read the text back
+         */
+        struct Record
+        {
+            uint32_t    file;       // Index of the result file
+            uint32_t    cols;       // Index of the first match column
+            uint32_t    colsCount;  // Always zero for regexp searches - the matches are not looked up then
+            uint32_t    indent;     // Source line leading whitespace trimmed from the shown text.
+                                    // The tree depth for the file and directory lines
+            intptr_t    line;       // Zero based, -1 for the file lines and -2 for the directory lines
+        };
+
+        /**
+         *  \struct  MergeSource
+         *  \brief
+         */
+        struct MergeSource
+        {
+            const TabParser*    parser;
+            std::string         pathPrefix; // From the merged results project folder to the source one
+            std::string         tag;        // Added after the source results line numbers
+        };
+
+        TabParser() : _filesCount(0), _hits(0), _headerStatusLen(0), _countsPos(0),
+                _lastLine(0), _lastFileFiltered(false), _truncated(false), _outputLines(0), _footerPos(0),
+                _searchIC(false), _searchWW(false), _searchRE(false), _dirTree(false), _sortByHits(false) {}
+
+        // Parses only the results in file - the group to splice in the tab results on file update
+        TabParser(const std::string& file) : _filesCount(0), _hits(0), _headerStatusLen(0), _countsPos(0),
+                _lastLine(0), _lastFileFiltered(false), _truncated(false), _outputLines(0), _footerPos(0),
+                _searchIC(false), _searchWW(false), _searchRE(false), _dirTree(false), _sortByHits(false),
+                _onlyFile(file) {}
+
+        virtual ~TabParser() {}
+
+        virtual intptr_t Parse(const CmdPtr_t&);
+
+        inline intptr_t getFilesCount() const { return _filesCount; }
+        inline intptr_t getHitsCount() const { return _hits ? _hits : _filesCount; }
+        inline int getHeaderStatusLen() const { return _headerStatusLen; }
+
+        inline bool isTruncated() const { return _truncated; }
+        inline bool isDirTree() const { return _dirTree; }
+        inline bool isSortedByHits() const { return _sortByHits; }
+        inline unsigned getOutputLines() const { return _outputLines; }
+
+        inline void addResultFile(const char* pFile, size_t len, intptr_t line)
+        {
+            _fileResults.emplace(std::string(pFile, len), line);
+        }
+
+        inline bool isFileInResults(const std::string& file) const
+        {
+            return (_fileResults.find(file) != _fileResults.end());
+        }
+
+        inline const std::string& getFirstFileResult() const { return _fileResults.begin()->first; }
+        inline const std::unordered_map<std::string, intptr_t>& getFileResults() const { return _fileResults; }
+
+        void spliceFileGroup(const TabParser& group, intptr_t& line, intptr_t& oldLines, intptr_t& newLines);
+
+        // Replaces the results with the sources ones ordered by file then line. header is without the counts
+        void merge(const std::vector<MergeSource>& sources, const std::string& header);
+
+        // Re-lays the file groups out - under their directories or not, by path or by hits. The results must
+        // not be truncated as continuing them appends to the file groups as parsed
+        void regroup(bool dirTree, bool sortByHits);
+
+        size_t getMemSize() const;
+
+        // The results as kept in the spill and the session files
+        void serialize(std::vector<char>& out) const;
+        bool deserialize(const char* data, size_t size);
+
+        // Frees the text and the line records - the tab must not be shown
+        void release();
+
+        // Returns NULL for the header and the 'load more' lines
+        inline const Record* getRecord(intptr_t lineNum) const
+        {
+            if (lineNum <= 0 || lineNum >= (intptr_t)_records.size())
+                return NULL;
+
+            return &_records[lineNum];
+        }
+
+        inline const std::string& getRecordFile(const Record& rec) const { return _files[rec.file]; }
+        inline uint32_t getRecordFilesCount() const { return (uint32_t)_files.size(); }
+
+        // Returns the byte offset in the source line (or in the file path for the file lines)
+        // of the matchNum (one based) match or -1 if unknown
+        inline intptr_t getMatchColumn(const Record& rec, unsigned matchNum) const
+        {
+            if (matchNum == 0 || matchNum > rec.colsCount)
+                return -1;
+
+            return _cols[rec.cols + matchNum - 1];
+        }
+
+    private:
+        static const char cLoadMoreTxt[];
+
+        bool filterEntry(const DbConfig& cfg, const char* pEntry, size_t len);
+
+        void setSearch(const CmdPtr_t&);
+        void addFileRecord(const char* pFile, size_t len, bool findMatches = false);
+        void addLineRecord(intptr_t line, const char* pTxt, size_t len, size_t indent);
+        void addMatchCols(Record& rec, const char* pTxt, size_t len, bool wholeWord);
+
+        intptr_t parseResults(const CmdPtr_t&);
+        intptr_t parseCmd(const CmdPtr_t&);
+        intptr_t parseFindFile(const CmdPtr_t&);
+        intptr_t parseFileGroup(const CmdPtr_t&);
+
+        std::string statusText(bool filesOnly) const;
+        size_t linePos(intptr_t line) const;
+
+        intptr_t    _filesCount;
+        intptr_t    _hits;
+        int         _headerStatusLen;
+        size_t      _countsPos;
+
+        // Parsing state kept to be able to continue truncated results
+        intptr_t    _lastLine;
+        std::string _lastFile;
+        bool        _lastFileFiltered;
+        bool        _truncated;
+        unsigned    _outputLines;
+        size_t      _footerPos;
+
+        std::unordered_map<std::string, intptr_t> _fileResults;
+
+        CPath       _entryPath; // Reused for path filtering to avoid allocation per result file
+
+        // Searched text as the match columns are looked up
+        std::string _search;
+        bool        _searchIC;
+        bool        _searchWW;
+        bool        _searchRE;
+
+        bool        _dirTree;
+        bool        _sortByHits;
+
+        std::vector<Record>         _records;   // One per result line, the first one is the header
+        std::vector<std::string>    _files;
+        std::vector<uint32_t>       _cols;
+
+        const std::string _onlyFile;
+    };
+
+
+    static HWND Register();
+    static void Unregister();
+
+    static void Show()
+    {
+        if (RW)
+            RW->show();
+    }
+
+    static void Show(const CmdPtr_t& cmd)
+    {
+        if (RW)
+            RW->show(cmd);
+    }
+
+    static void Close(const CmdPtr_t& cmd)
+    {
+        if (RW)
+            RW->close(cmd);
+    }
+
+    static void ApplyStyle()
+    {
+        if (RW)
+            RW->applyStyle();
+    }
+
+    static void NotifyDBUpdate(const CmdPtr_t& cmd)
+    {
+        if (RW)
+            RW->notifyDBUpdate(cmd);
+    }
+
+    static HWND GetSciHandleIfFocused()
+    {
+        if (RW && GetFocus() == ResultWin::_hSci)
+            return ResultWin::_hSci;
+
+        return NULL;
+    }
+
+    static CPath GetDbPath()
+    {
+        if (RW && RW->_activeTab)
+            return CPath(RW->_activeTab->_projectPath.C_str());
+
+        return CPath();
+    }
+
+    static bool IsFocused(HWND hWnd = NULL)
+    {
+        if (hWnd == NULL)
+            hWnd = GetFocus();
+
+        return (RW && (RW->_hWnd == hWnd || IsChild(RW->_hWnd, hWnd)));
+    };
+
+    static bool Activate();
+
+    ResultWin() : _hWnd(NULL), _hKeyHook(NULL), _activeTab(NULL),
+            _hSearch(NULL), _hSearchFont(NULL), _hBtnFont(NULL),
+            _lastRE(false), _lastIC(false), _lastWW(true), _tabUseCount(0),
+            _hSessionFile(INVALID_HANDLE_VALUE), _hSessionMap(NULL), _sessionView(NULL), _sessionEnabled(false) {}
+    ~ResultWin();
+
+private:
+    /**
+     *  \struct  Tab
+     *  \brief
+     */
+    struct Tab
+    {
+        Tab(const CmdPtr_t& cmd);
+        Tab(CmdId_t cmdId, bool regExp, bool ignoreCase);
+        ~Tab();
+        Tab& operator=(const Tab&) = delete;
+
+        inline bool operator==(const Tab& tab) const
+        {
+            return (_cmdId == tab._cmdId && _projectPath == tab._projectPath && _search == tab._search &&
+                    _ignoreCase == tab._ignoreCase && _regExp == tab._regExp && _merged == tab._merged);
+        }
+
+        const CmdId_t   _cmdId;
+        const bool      _regExp;
+        const bool      _ignoreCase;
+        CTextA          _projectPath;
+        CTextA          _search;
+        intptr_t        _currentLine;
+        intptr_t        _firstVisibleLine;
+        ParserPtr_t     _parser;
+
+        bool            _dirty;
+        bool            _merged;    // Results of several searches - can't be re-run or updated
+
+        HANDLE          _hSpill;    // Temp file holding the results while the tab is inactive
+        unsigned        _lastUse;   // Tabs load order to spill the least recently used first
+
+        // Results of a tab restored from the session file - in its mapped view until the tab is shown
+        const char*     _sessionData;
+        size_t          _sessionSize;
+
+        // Updated files to re-query and splice in the results when the tab is shown
+        std::unordered_set<std::string> _staleFiles;
+        bool            _refreshing; // A stale file re-query is running - they are run one after another
+
+        // The file groups are identified by their result file index - it doesn't change on file update
+        inline void SetFolded(uint32_t group);
+        inline void SetAllFolded();
+        inline void ClearFolded(uint32_t group);
+        inline void ClearAllFolded(uint32_t groupsCount);
+        inline bool IsFolded(uint32_t group) const;
+
+        void RestoreView(const Tab& oldTab);
+        void ShiftLines(intptr_t line, intptr_t oldLines, intptr_t newLines);
+
+        inline bool IsSpilled() const { return (_hSpill != INVALID_HANDLE_VALUE || _sessionData != NULL); }
+        bool Spill();
+        bool Reload();
+
+        bool Save(HANDLE hFile, uint64_t dbGeneration) const;
+        static Tab* Restore(const char*& pData, const char* pEnd, uint64_t& dbGeneration);
+
+    private:
+        bool readSpill(std::vector<char>& data) const;
+        bool getResults(std::vector<char>& buf, const char*& pData, size_t& size) const;
+
+        std::vector<uint64_t> _expandedGroups; // Bit per file group set if it is expanded
+    };
+
+
+    /**
+     *  \struct  SessionHeader
+     *  \brief
+     */
+    struct SessionHeader
+    {
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    recordSize; // The results line records are stored as they are in memory
+        uint32_t    tabsCount;
+        int32_t     activeTab;
+    };
+
+
+    /**
+     *  \struct  SearchMatches
+     *  \brief  All matches of the last search in the shown tab - found once and then stepped through
+     */
+    struct SearchMatches
+    {
+        SearchMatches() : ignoreCase(false), wholeWord(false), regExp(false), valid(false) {}
+
+        CTextA      txt;
+        bool        ignoreCase;
+        bool        wholeWord;
+        bool        regExp;
+        bool        valid;      // Cleared when another text is shown
+
+        std::vector<std::pair<intptr_t, intptr_t>> pos; // Start and end positions sorted
+    };
+
+
+    static const COLORREF   cBlack = RGB(0,0,0);
+    static const COLORREF   cWhite = RGB(255,255,255);
+
+    static const TCHAR      cClassName[];
+    static const TCHAR      cSearchClassName[];
+    static const TCHAR      cSearchTitle[];
+    static const TCHAR      cMergedTabName[];
+
+    static const int        cSearchBkgndColor;
+    static const unsigned   cSearchFontSize;
+    static const int        cSearchWidth;
+    static const size_t     cMaxStaleFiles;
+    static const char       cSessionMagic[];
+    static const uint32_t   cSessionVersion;
+
+    static LRESULT CALLBACK keyHookProc(int code, WPARAM wParam, LPARAM lParam);
+    static LRESULT APIENTRY wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    static LRESULT APIENTRY searchWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+    static void refreshCB(const CmdPtr_t& cmd);
+
+    // Same as Scintilla default word characters
+    static inline bool isWordChar(char c)
+    {
+        return ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+                (c & 0x80));
+    }
+
+    static bool writeData(HANDLE hFile, const void* data, size_t size);
+    static bool readData(HANDLE hFile, void* data, size_t size);
+    static uint64_t dbGeneration(const CTextA& projectPath);
+
+    ResultWin(const ResultWin&);
+
+    void show();
+    void show(const CmdPtr_t& cmd);
+    void close(const CmdPtr_t& cmd);
+    void reRunCmd();
+    void loadMoreResults();
+    void applyStyle();
+    void notifyDBUpdate(const CmdPtr_t& cmd);
+    void refreshStaleFiles(Tab* tab);
+    void onFileRefresh(const CmdPtr_t& cmd);
+    void reloadTab(Tab* tab);
+    void fitTabsInBudget();
+    void saveSession();
+    void restoreSession();
+    void closeSession();
+
+    inline LRESULT sendSci(UINT Msg, WPARAM wParam = 0, LPARAM lParam = 0)
+    {
+        return _sciFunc(_sciPtr, static_cast<unsigned int>(Msg),
+                static_cast<uptr_t>(wParam), static_cast<sptr_t>(lParam));
+    }
+
+    void setStyle(int style, COLORREF fore = cBlack, COLORREF back = cWhite, bool bold = false, bool italic = false,
+            int size = 0, const char *font = NULL);
+
+    void configScintilla();
+    HWND composeWindow();
+    void createSearchWindow();
+    void onSearchWindowCreate(HWND hWnd);
+    void showWindow(HWND hFocus = NULL);
+    void hideWindow();
+
+    void hookKeyboard()
+    {
+        _hKeyHook = SetWindowsHookEx(WH_KEYBOARD, keyHookProc, NULL, GetCurrentThreadId());
+    }
+
+    Tab* getTab(int i = -1);
+    void loadTab(Tab* tab, bool firstTimeLoad = false);
+    bool visitSingleResult(Tab* tab);
+    bool openItem(intptr_t lineNum, unsigned matchNum = 1);
+    void styleMatches(const TabParser* parser, const TabParser::Record& rec, intptr_t textPos, intptr_t endPos,
+            int textStyle);
+    bool isLoadMoreLine(intptr_t lineNum);
+
+    bool findString(const char* str, intptr_t* startPos, intptr_t* endPos,
+            bool ignoreCase, bool wholeWord, bool regExp);
+    void toggleFolding(intptr_t lineNum);
+    void foldAll(int foldAction);
+    void onStyleNeeded(SCNotification* notify);
+    void onNewPosition();
+    void onHotspotClick(SCNotification* notify);
+    void onDoubleClick(intptr_t pos);
+    void onMarginClick(SCNotification* notify);
+    bool onKeyPress(WORD keyCode, bool alt);
+    intptr_t visibleLine(intptr_t lineNum);
+    void onTabChange();
+    void onCloseTab();
+    void closeAllTabs();
+    void onResize(int width, int height);
+    void onMove();
+    void findAllMatches(const char* str, bool ignoreCase, bool wholeWord, bool regExp);
+    void findMatches(const char* str, intptr_t startPos, intptr_t endPos);
+    void showMatchesCount(size_t matchIdx);
+    void onSearch(bool reverseDir = false, bool keepFocus = false);
+    void mergeTabs();
+    void toggleGrouping(bool dirTree);
+
+    static std::unique_ptr<ResultWin> RW;
+
+    static HWND         _hSci;
+    static SciFnDirect  _sciFunc;
+    static sptr_t       _sciPtr;
+
+    HWND        _hWnd;
+    HWND        _hTab;
+    HHOOK       _hKeyHook;
+    Tab*        _activeTab;
+
+    HWND        _hSearch;
+    HWND        _hSearchTxt;
+    HWND        _hRE;
+    HWND        _hIC;
+    HWND        _hWW;
+    HWND        _hUp;
+    HWND        _hDown;
+    HFONT       _hSearchFont;
+    HFONT       _hBtnFont;
+
+    int         _searchTxtHeight;
+
+    bool        _lastRE;
+    bool        _lastIC;
+    bool        _lastWW;
+    CText       _lastSearchTxt;
+
+    SearchMatches   _searchMatches;
+
+    unsigned    _tabUseCount;
+
+    HANDLE      _hSessionFile;
+    HANDLE      _hSessionMap;
+    const char* _sessionView;
+    bool        _sessionEnabled; // The session is restored - save it on exit
+
+    CmdTimingPtr_t  _paintTiming; // Stamped on the next results view paint
+};
+
+} // namespace GTags
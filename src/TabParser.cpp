@@ -0,0 +1,1340 @@
+/**
+ *  \file
+ *  \brief  GTags result tab parser - the results text and line records
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "ResultWin.h"
+#include "Blob.h"
+#include "StrUniquenessChecker.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "Common.h"
+
+
+namespace GTags
+{
+
+const char ResultWin::TabParser::cLoadMoreTxt[] = "\t...more results available (double-click here to load them)";
+
+
+/**
+ *  \brief
+ */
+intptr_t ResultWin::TabParser::Parse(const CmdPtr_t& cmd)
+{
+    setSearch(cmd);
+
+    if (!_onlyFile.empty())
+        return parseFileGroup(cmd);
+
+    // Continue truncated results - parser state is copied from the previous one,
+    // remove its results sumary and 'load more' line and append the new results
+    if (cmd->LinesOffset())
+    {
+        if (_truncated)
+            _buf.Resize(_footerPos);
+
+        _buf.Erase(_countsPos, _headerStatusLen);
+
+        return parseResults(cmd);
+    }
+
+    _filesCount = 0;
+    _hits = 0;
+    _headerStatusLen = 0;
+
+    _lastLine = 0;
+    _lastFile.clear();
+    _lastFileFiltered = false;
+    _outputLines = 0;
+
+    _dirTree = false;
+    _sortByHits = false;
+
+    _fileResults.clear();
+
+    _records.clear();
+    _files.clear();
+    _cols.clear();
+
+    _records.emplace_back(); // The header
+
+    // Add the search header - cmd name + search word + project path
+    _buf = cmd->Name();
+    _buf += " \"";
+    _buf += cmd->Tag().C_str();
+    _buf += "\"";
+
+    if (cmd->RegExp() || cmd->IgnoreCase())
+    {
+        _buf += " (";
+
+        if (cmd->RegExp())
+        {
+            _buf += "regexp";
+
+            if (cmd->IgnoreCase())
+                _buf += ", ";
+        }
+
+        if (cmd->IgnoreCase())
+            _buf += "ignore case";
+
+        _buf += ")";
+    }
+
+    _buf += " in \"";
+    _buf += cmd->Db()->GetPath().C_str();
+    _buf += "\"";
+
+    _countsPos = _buf.Len();
+
+    return parseResults(cmd);
+}
+
+
+/**
+ *  \brief
+ */
+intptr_t ResultWin::TabParser::parseResults(const CmdPtr_t& cmd)
+{
+    _truncated = cmd->IsTruncated();
+
+    // Count the output lines - needed to skip them when continuing
+    if (_truncated)
+    {
+        _outputLines = cmd->LinesOffset();
+
+        cmd->ForEachResultPart([this](const char* pData, size_t len)
+        {
+            const char* const pEnd = pData + len;
+
+            for (const char* pSrc = pData;
+                    (pSrc = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc))) != NULL; ++pSrc)
+                ++_outputLines;
+        });
+    }
+
+    // The UI text is about the size of the raw output - reserve it upfront instead of growing it on the go
+    _buf.Reserve(_buf.Len() + cmd->ResultLen() + cmd->ResultLen() / 8);
+
+    intptr_t res;
+
+    // parsing command result
+    if (cmd->Id() == FIND_FILE)
+        res = parseFindFile(cmd);
+    else
+        res = parseCmd(cmd);
+
+    // Add results sumary in header
+    if (res > 0)
+    {
+        const std::string str = statusText(cmd->Id() == FIND_FILE);
+
+        _headerStatusLen = (int)str.size();
+
+        _buf.Insert(_countsPos, str.c_str(), str.size());
+    }
+
+    if (res > 0 && _truncated)
+    {
+        _footerPos = _buf.Len();
+        _buf += "\n";
+        _buf += cLoadMoreTxt;
+    }
+
+    return res;
+}
+
+
+/**
+ *  \brief
+ */
+std::string ResultWin::TabParser::statusText(bool filesOnly) const
+{
+    std::string str;
+
+    if (filesOnly)
+    {
+        if (_filesCount == 0)
+            return str;
+
+        str = " (";
+
+        if (_filesCount == 1)
+        {
+            str += "1 hit)";
+        }
+        else
+        {
+            str += std::to_string(_filesCount);
+            str += " hits)";
+        }
+    }
+    else
+    {
+        if (_hits == 0)
+            return str;
+
+        str = " (";
+
+        if (_hits == 1)
+        {
+            str += "1 hit in 1 file)";
+        }
+        else
+        {
+            str += std::to_string(_hits);
+            str += " hits in ";
+
+            if (_filesCount == 1)
+            {
+                str += "1 file)";
+            }
+            else
+            {
+                str += std::to_string(_filesCount);
+                str += " files)";
+            }
+        }
+    }
+
+    if (_truncated)
+        str.insert(str.size() - 1, ", more available");
+
+    return str;
+}
+
+
+/**
+ *  \brief  Returns the position of the new line char that starts line - or the text end for the line after the last
+ */
+size_t ResultWin::TabParser::linePos(intptr_t line) const
+{
+    const char* pSrc = _buf.C_str();
+    const char* const pEnd = pSrc + _buf.Len();
+
+    for (; line > 0; --line)
+    {
+        pSrc = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc));
+        if (pSrc == NULL)
+            return _buf.Len();
+
+        if (line > 1)
+            ++pSrc;
+    }
+
+    return pSrc - _buf.C_str();
+}
+
+
+/**
+ *  \brief  Replaces the results of the group file with the group ones keeping the files order.
+ *          Returns the group first line and its old and new lines count
+ */
+void ResultWin::TabParser::spliceFileGroup(const TabParser& group, intptr_t& line, intptr_t& oldLines,
+        intptr_t& newLines)
+{
+    const std::string& file = group._onlyFile;
+
+    intptr_t linesCount = 1;
+    for (const char* pSrc = _buf.C_str(); (pSrc = strchr(pSrc, '\n')) != NULL; ++pSrc)
+        ++linesCount;
+
+    newLines = group._hits ? group._hits + 1 : 0;
+    oldLines = 0;
+    line = linesCount;
+
+    const auto iFile = _fileResults.find(file);
+
+    if (iFile != _fileResults.end())
+    {
+        line = iFile->second;
+
+        intptr_t nextLine = linesCount;
+        for (const auto& fileRes : _fileResults)
+            if (fileRes.second > line && fileRes.second < nextLine)
+                nextLine = fileRes.second;
+
+        oldLines = nextLine - line;
+    }
+    else
+    {
+        for (const auto& fileRes : _fileResults)
+            if (fileRes.first > file && fileRes.second < line)
+                line = fileRes.second;
+    }
+
+    if (!oldLines && !newLines)
+        return;
+
+    const size_t from = linePos(line);
+    const size_t to = linePos(line + oldLines);
+
+    if (to > from)
+        _buf.Erase(from, to - from);
+    if (newLines)
+        _buf.Insert(from, group._buf.C_str(), group._buf.Len());
+
+    // The records of the group lines follow the same order - all after line move by the same offsets
+    const size_t colsFrom = (line < (intptr_t)_records.size()) ? _records[line].cols : _cols.size();
+    const size_t colsTo = (line + oldLines < (intptr_t)_records.size()) ?
+            _records[line + oldLines].cols : _cols.size();
+
+    const size_t newCols = newLines ? group._cols.size() : 0;
+
+    const uint32_t fileIdx = oldLines ? _records[line].file : (uint32_t)_files.size();
+    if (newLines && !oldLines)
+        _files.push_back(file);
+
+    _cols.erase(_cols.begin() + colsFrom, _cols.begin() + colsTo);
+    _records.erase(_records.begin() + line, _records.begin() + line + oldLines);
+
+    if (newLines)
+    {
+        _cols.insert(_cols.begin() + colsFrom, group._cols.begin(), group._cols.end());
+
+        std::vector<Record> groupRecords(group._records.begin() + 1, group._records.end());
+        for (auto& rec : groupRecords)
+        {
+            rec.file = fileIdx;
+            rec.cols += (uint32_t)colsFrom;
+        }
+
+        _records.insert(_records.begin() + line, groupRecords.begin(), groupRecords.end());
+    }
+
+    for (size_t i = line + newLines; i < _records.size(); ++i)
+        _records[i].cols = (uint32_t)(_records[i].cols + newCols - (colsTo - colsFrom));
+
+    if (oldLines)
+    {
+        _fileResults.erase(iFile);
+        --_filesCount;
+        _hits -= oldLines - 1;
+    }
+
+    for (auto& fileRes : _fileResults)
+        if (fileRes.second >= line)
+            fileRes.second += newLines - oldLines;
+
+    if (newLines)
+    {
+        addResultFile(file.c_str(), file.size(), line);
+        ++_filesCount;
+        _hits += group._hits;
+    }
+
+    const std::string str = statusText(false);
+
+    _buf.Erase(_countsPos, _headerStatusLen);
+    _buf.Insert(_countsPos, str.c_str(), str.size());
+
+    _headerStatusLen = (int)str.size();
+}
+
+
+/**
+ *  \brief  Each source file group is already sorted by line so it is a run to merge with the others
+ *          through a heap - the results are not sorted as a whole
+ */
+void ResultWin::TabParser::merge(const std::vector<MergeSource>& sources, const std::string& header)
+{
+    /**
+     *  \struct  Run
+     *  \brief
+     */
+    struct Run
+    {
+        uint32_t    src;
+        intptr_t    next;   // Source line
+        intptr_t    end;
+        std::string path;
+    };
+
+    std::vector<Run> runs;
+    std::vector<std::vector<size_t>> linesPos(sources.size());
+
+    for (uint32_t src = 0; src < (uint32_t)sources.size(); ++src)
+    {
+        const TabParser& parser = *sources[src].parser;
+        const intptr_t recordsCount = (intptr_t)parser._records.size();
+
+        const char* const pBuf = parser._buf.C_str();
+        const char* const pEnd = pBuf + parser._buf.Len();
+
+        // Start of each line with a record and of the one after (the 'load more' line or the text end)
+        std::vector<size_t>& pos = linesPos[src];
+        pos.reserve(recordsCount + 1);
+        pos.push_back(0);
+
+        for (const char* pSrc = pBuf; (intptr_t)pos.size() <= recordsCount &&
+                (pSrc = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc))) != NULL;)
+            pos.push_back(++pSrc - pBuf);
+
+        for (intptr_t line = 1; line < recordsCount && line < (intptr_t)pos.size(); ++line)
+        {
+            const Record& rec = parser._records[line];
+
+            // The source might be grouped by directory - its file groups are still contiguous
+            if (rec.line == -1)
+            {
+                const std::string& file = parser._files[rec.file];
+
+                Run run;
+                run.src     = src;
+                run.next    = line + 1;
+                run.end     = line + 1;
+
+                // Absolute paths are left as they are
+                if (file.size() < 3 || (file[0] != '/' && file[1] != ':'))
+                    run.path = sources[src].pathPrefix;
+                run.path += file;
+
+                runs.push_back(std::move(run));
+            }
+            else if (rec.line >= 0 && !runs.empty() && runs.back().src == src)
+            {
+                runs.back().end = line + 1;
+            }
+        }
+    }
+
+    _buf = header.c_str();
+    _countsPos = _buf.Len();
+    _headerStatusLen = 0;
+
+    _filesCount = 0;
+    _hits = 0;
+    _truncated = false;
+    _dirTree = false;
+    _sortByHits = false;
+    _fileResults.clear();
+    _records.clear();
+    _files.clear();
+    _cols.clear();
+
+    _records.emplace_back(); // The header
+
+    if (!sources.empty())
+    {
+        const TabParser& first = *sources[0].parser;
+
+        _search     = first._search;
+        _searchIC   = first._searchIC;
+        _searchWW   = first._searchWW;
+        _searchRE   = first._searchRE;
+    }
+
+    // Min-heap on file, line then source order
+    auto runGreater = [&runs, &sources](size_t a, size_t b)
+    {
+        const Run& ra = runs[a];
+        const Run& rb = runs[b];
+
+        const int cmp = ra.path.compare(rb.path);
+        if (cmp)
+            return (cmp > 0);
+
+        const intptr_t lineA = sources[ra.src].parser->_records[ra.next].line;
+        const intptr_t lineB = sources[rb.src].parser->_records[rb.next].line;
+
+        if (lineA != lineB)
+            return (lineA > lineB);
+
+        return (a > b);
+    };
+
+    std::vector<size_t> heap;
+    heap.reserve(runs.size());
+
+    for (size_t i = 0; i < runs.size(); ++i)
+        if (runs[i].next < runs[i].end)
+            heap.push_back(i);
+
+    std::make_heap(heap.begin(), heap.end(), runGreater);
+
+    const std::string* pLastPath = NULL;
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), runGreater);
+
+        Run& run = runs[heap.back()];
+        const TabParser& parser = *sources[run.src].parser;
+
+        if (pLastPath == NULL || *pLastPath != run.path)
+        {
+            _buf += "\n\t";
+            _buf.Append(run.path.c_str(), run.path.size());
+
+            addResultFile(run.path.c_str(), run.path.size(), (intptr_t)_records.size());
+            addFileRecord(run.path.c_str(), run.path.size());
+
+            ++_filesCount;
+            pLastPath = &run.path;
+        }
+
+        // "\t\tline N:\ttext" - the tag goes before the ':'
+        const char* pLine = parser._buf.C_str() + linesPos[run.src][run.next];
+        const char* pEol = (run.next + 1 < (intptr_t)linesPos[run.src].size()) ?
+                parser._buf.C_str() + linesPos[run.src][run.next + 1] - 1 : parser._buf.C_str() + parser._buf.Len();
+        const char* pColon = static_cast<const char*>(memchr(pLine, ':', pEol - pLine));
+        if (pColon == NULL)
+            pColon = pLine;
+
+        _buf += "\n";
+        _buf.Append(pLine, pColon - pLine);
+        _buf += sources[run.src].tag.c_str();
+        _buf.Append(pColon, pEol - pColon);
+
+        Record rec      = parser._records[run.next];
+        rec.file        = (uint32_t)_files.size() - 1;
+        rec.cols        = (uint32_t)_cols.size();
+
+        _cols.insert(_cols.end(), parser._cols.begin() + parser._records[run.next].cols,
+                parser._cols.begin() + parser._records[run.next].cols + rec.colsCount);
+        _records.push_back(rec);
+
+        ++_hits;
+
+        if (++run.next < run.end)
+            std::push_heap(heap.begin(), heap.end(), runGreater);
+        else
+            heap.pop_back();
+    }
+
+    const std::string str = statusText(false);
+
+    _headerStatusLen = (int)str.size();
+    _buf += str.c_str();
+}
+
+
+/**
+ *  \brief  The directories hits are summed up in a single pass over the file groups, then each level is sorted
+ *          and the lines are written out once in the new order - the result lines are copied as they are.
+ *          Single child directory chains are shown as one line
+ */
+void ResultWin::TabParser::regroup(bool dirTree, bool sortByHits)
+{
+    if (_truncated || (dirTree == _dirTree && sortByHits == _sortByHits))
+        return;
+
+    /**
+     *  \struct  Group
+     *  \brief
+     */
+    struct Group
+    {
+        intptr_t    rec;    // The file line
+        intptr_t    hits;
+    };
+
+    /**
+     *  \struct  Node
+     *  \brief
+     */
+    struct Node
+    {
+        std::string             name;
+        std::string             path;   // With trailing '/'
+        intptr_t                hits;
+        std::vector<uint32_t>   dirs;
+        std::vector<uint32_t>   groups;
+    };
+
+    const intptr_t recordsCount = (intptr_t)_records.size();
+
+    const char* const pBuf = _buf.C_str();
+    const char* const pEnd = pBuf + _buf.Len();
+
+    // Start of each line and of the one after the last (one past the text end)
+    std::vector<size_t> pos;
+    pos.reserve(recordsCount + 1);
+    pos.push_back(0);
+
+    for (const char* pSrc = pBuf; (intptr_t)pos.size() < recordsCount &&
+            (pSrc = static_cast<const char*>(memchr(pSrc, '\n', pEnd - pSrc))) != NULL;)
+        pos.push_back(++pSrc - pBuf);
+
+    if ((intptr_t)pos.size() < recordsCount)
+        return;
+
+    pos.push_back(_buf.Len() + 1);
+
+    // Directory lines from a previous grouping are dropped
+    std::vector<Group> groups;
+
+    for (intptr_t line = 1; line < recordsCount; ++line)
+    {
+        if (_records[line].line == -1)
+            groups.push_back({line, 0});
+        else if (_records[line].line >= 0 && !groups.empty())
+            ++groups.back().hits;
+    }
+
+    std::vector<Node> nodes(1); // The root
+    nodes[0].hits = 0;
+
+    std::unordered_map<std::string, uint32_t> dirNodes;
+
+    for (uint32_t g = 0; g < (uint32_t)groups.size(); ++g)
+    {
+        const std::string& file = _files[_records[groups[g].rec].file];
+        uint32_t node = 0;
+
+        nodes[0].hits += groups[g].hits;
+
+        for (size_t start = 0, end; dirTree && (end = file.find('/', start)) != std::string::npos; start = end + 1)
+        {
+            // Skip empty components - the root of absolute paths is shown with the first directory
+            if (end == start)
+                continue;
+
+            const size_t nameStart = (start == 1) ? 0 : start;
+
+            auto iDir = dirNodes.find(file.substr(0, end + 1));
+
+            if (iDir == dirNodes.end())
+            {
+                Node dir;
+                dir.name.assign(file, nameStart, end - nameStart);
+                dir.path.assign(file, 0, end + 1);
+                dir.hits = 0;
+
+                iDir = dirNodes.emplace(dir.path, (uint32_t)nodes.size()).first;
+                nodes[node].dirs.push_back(iDir->second);
+                nodes.push_back(std::move(dir));
+            }
+
+            node = iDir->second;
+            nodes[node].hits += groups[g].hits;
+        }
+
+        nodes[node].groups.push_back(g);
+    }
+
+    auto groupLess = [this, &groups, sortByHits](uint32_t a, uint32_t b)
+    {
+        if (sortByHits && groups[a].hits != groups[b].hits)
+            return (groups[a].hits > groups[b].hits);
+
+        const int cmp = _files[_records[groups[a].rec].file].compare(_files[_records[groups[b].rec].file]);
+
+        return (cmp ? (cmp < 0) : (a < b));
+    };
+
+    auto dirLess = [&nodes, sortByHits](uint32_t a, uint32_t b)
+    {
+        if (sortByHits && nodes[a].hits != nodes[b].hits)
+            return (nodes[a].hits > nodes[b].hits);
+
+        return (nodes[a].name < nodes[b].name);
+    };
+
+    for (auto& node : nodes)
+    {
+        std::sort(node.dirs.begin(), node.dirs.end(), dirLess);
+        std::sort(node.groups.begin(), node.groups.end(), groupLess);
+    }
+
+    // The directory lines get _files entries as well so they are folded the same way as the file groups
+    std::unordered_map<std::string, uint32_t> dirFiles;
+
+    for (uint32_t i = 0; i < (uint32_t)_files.size(); ++i)
+        if (!_files[i].empty() && _files[i].back() == '/')
+            dirFiles.emplace(_files[i], i);
+
+    CTextA buf;
+    buf.Reserve(_buf.Len() + (nodes.size() - 1) * 32);
+    buf.Append(pBuf, pos[1] - 1);
+
+    std::vector<Record> records;
+    records.reserve(recordsCount - 1 + nodes.size());
+    records.push_back(_records[0]);
+
+    std::vector<uint32_t> cols;
+    cols.reserve(_cols.size());
+
+    _fileResults.clear();
+
+    auto addLine = [this, &buf, &records, &cols, &pos, pBuf](intptr_t line, uint32_t indent, bool copyText)
+    {
+        if (copyText)
+        {
+            buf += '\n';
+            buf.Append(pBuf + pos[line], pos[line + 1] - 1 - pos[line]);
+        }
+
+        Record rec  = _records[line];
+        rec.cols    = (uint32_t)cols.size();
+
+        if (rec.line < 0)
+            rec.indent = indent;
+
+        cols.insert(cols.end(), _cols.begin() + _records[line].cols,
+                _cols.begin() + _records[line].cols + rec.colsCount);
+        records.push_back(rec);
+    };
+
+    /**
+     *  \struct  Item
+     *  \brief
+     */
+    struct Item
+    {
+        uint32_t    node;
+        uint32_t    depth;
+        bool        files;  // The node file groups - they follow its subdirectories
+    };
+
+    std::vector<Item> stack;
+    stack.push_back({0, 0, true});
+
+    for (auto iDir = nodes[0].dirs.rbegin(); iDir != nodes[0].dirs.rend(); ++iDir)
+        stack.push_back({*iDir, 0, false});
+
+    while (!stack.empty())
+    {
+        const Item item = stack.back();
+        stack.pop_back();
+
+        uint32_t node = item.node;
+
+        if (item.files)
+        {
+            for (uint32_t g : nodes[node].groups)
+            {
+                const std::string& file = _files[_records[groups[g].rec].file];
+                _fileResults.emplace(file, (intptr_t)records.size());
+
+                // Results flat and by path show the file lines as parsed
+                const size_t nameStart = dirTree ? file.rfind('/') + 1 : 0;
+
+                buf += "\n\t";
+                buf += std::string(2 * item.depth, ' ').c_str();
+                buf.Append(file.c_str() + nameStart, file.size() - nameStart);
+
+                if (dirTree || sortByHits)
+                {
+                    buf += " (";
+                    buf += std::to_string(groups[g].hits).c_str();
+                    buf += ")";
+                }
+
+                addLine(groups[g].rec, item.depth, false);
+
+                for (intptr_t line = groups[g].rec + 1; line <= groups[g].rec + groups[g].hits; ++line)
+                    addLine(line, 0, true);
+            }
+
+            continue;
+        }
+
+        std::string name = nodes[node].name;
+
+        while (nodes[node].dirs.size() == 1 && nodes[node].groups.empty())
+        {
+            node = nodes[node].dirs[0];
+            name += '/';
+            name += nodes[node].name;
+        }
+
+        const std::string& path = nodes[node].path;
+
+        auto iFile = dirFiles.find(path);
+        if (iFile == dirFiles.end())
+        {
+            iFile = dirFiles.emplace(path, (uint32_t)_files.size()).first;
+            _files.push_back(path);
+        }
+
+        _fileResults.emplace(path, (intptr_t)records.size());
+
+        buf += "\n\t";
+        buf += std::string(2 * item.depth, ' ').c_str();
+        buf += name.c_str();
+        buf += "/ (";
+        buf += std::to_string(nodes[node].hits).c_str();
+        buf += ")";
+
+        Record rec;
+        rec.file        = iFile->second;
+        rec.cols        = (uint32_t)cols.size();
+        rec.colsCount   = 0;
+        rec.indent      = item.depth;
+        rec.line        = -2;
+
+        records.push_back(rec);
+
+        stack.push_back({node, item.depth + 1, true});
+
+        for (auto iDir = nodes[node].dirs.rbegin(); iDir != nodes[node].dirs.rend(); ++iDir)
+            stack.push_back({*iDir, item.depth + 1, false});
+    }
+
+    _buf = buf;
+    _records.swap(records);
+    _cols.swap(cols);
+
+    _dirTree = dirTree;
+    _sortByHits = sortByHits;
+}
+
+
+/**
+ *  \brief
+ */
+size_t ResultWin::TabParser::getMemSize() const
+{
+    size_t size = _buf.Size() + _records.capacity() * sizeof(Record) + _cols.capacity() * sizeof(uint32_t);
+
+    for (const auto& file : _files)
+        size += file.capacity();
+
+    return size;
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::TabParser::serialize(std::vector<char>& out) const
+{
+    out.reserve(out.size() + _buf.Len() + _records.size() * sizeof(Record) + _cols.size() * sizeof(uint32_t) +
+            _files.size() * 64 + _fileResults.size() * 72 + 256);
+
+    put(out, (int64_t)_filesCount);
+    put(out, (int64_t)_hits);
+    put(out, (int32_t)_headerStatusLen);
+    put(out, (uint64_t)_countsPos);
+    put(out, (int64_t)_lastLine);
+    putStr(out, _lastFile.c_str(), _lastFile.size());
+    put(out, (uint8_t)_lastFileFiltered);
+    put(out, (uint8_t)_truncated);
+    put(out, (uint32_t)_outputLines);
+    put(out, (uint64_t)_footerPos);
+
+    putStr(out, _search.c_str(), _search.size());
+    put(out, (uint8_t)_searchIC);
+    put(out, (uint8_t)_searchWW);
+    put(out, (uint8_t)_searchRE);
+
+    put(out, (uint8_t)_dirTree);
+    put(out, (uint8_t)_sortByHits);
+
+    putStr(out, _buf.C_str(), _buf.Len());
+    putArray(out, _records);
+    putArray(out, _cols);
+
+    put(out, (uint64_t)_files.size());
+    for (const auto& file : _files)
+        putStr(out, file.c_str(), file.size());
+
+    put(out, (uint64_t)_fileResults.size());
+    for (const auto& fileRes : _fileResults)
+    {
+        putStr(out, fileRes.first.c_str(), fileRes.first.size());
+        put(out, (int64_t)fileRes.second);
+    }
+}
+
+
+/**
+ *  \brief  On failure the results are left empty and the tab needs to be re-run
+ */
+bool ResultWin::TabParser::deserialize(const char* data, size_t size)
+{
+    BlobReader in(data, size);
+
+    _filesCount         = (intptr_t)in.Get<int64_t>();
+    _hits               = (intptr_t)in.Get<int64_t>();
+    _headerStatusLen    = in.Get<int32_t>();
+    _countsPos          = (size_t)in.Get<uint64_t>();
+    _lastLine           = (intptr_t)in.Get<int64_t>();
+    in.GetStr(_lastFile);
+    _lastFileFiltered   = (in.Get<uint8_t>() != 0);
+    _truncated          = (in.Get<uint8_t>() != 0);
+    _outputLines        = in.Get<uint32_t>();
+    _footerPos          = (size_t)in.Get<uint64_t>();
+
+    in.GetStr(_search);
+    _searchIC           = (in.Get<uint8_t>() != 0);
+    _searchWW           = (in.Get<uint8_t>() != 0);
+    _searchRE           = (in.Get<uint8_t>() != 0);
+
+    _dirTree            = (in.Get<uint8_t>() != 0);
+    _sortByHits         = (in.Get<uint8_t>() != 0);
+
+    size_t len;
+    const char* pText = in.GetData(len);
+
+    _buf.Clear();
+    if (pText)
+    {
+        _buf.Reserve(len);
+        _buf.Append(pText, len);
+    }
+
+    in.GetArray(_records);
+    in.GetArray(_cols);
+
+    _files.clear();
+    for (uint64_t count = in.Get<uint64_t>(); in.Ok() && count; --count)
+    {
+        _files.emplace_back();
+        in.GetStr(_files.back());
+    }
+
+    _fileResults.clear();
+    for (uint64_t count = in.Get<uint64_t>(); in.Ok() && count; --count)
+    {
+        std::string file;
+        in.GetStr(file);
+        _fileResults.emplace(file, (intptr_t)in.Get<int64_t>());
+    }
+
+    // A bad record would index out of the files or the match columns later - the header record has no file
+    bool valid = in.Ok() && !_records.empty();
+
+    for (size_t i = 0; valid && i < _records.size(); ++i)
+    {
+        const Record& rec = _records[i];
+
+        valid = (i == 0 || rec.file < _files.size()) &&
+                rec.colsCount <= _cols.size() && rec.cols <= _cols.size() - rec.colsCount;
+    }
+
+    // The file results lines are jumped to on the database updates
+    for (auto iFile = _fileResults.cbegin(); valid && iFile != _fileResults.cend(); ++iFile)
+        valid = (iFile->second >= 0 && iFile->second < (intptr_t)_records.size());
+
+    // The header counts are erased and the 'load more' footer is cut off the text when continuing the results
+    if (valid)
+    {
+        valid = _headerStatusLen >= 0 && _countsPos <= _buf.Len() &&
+                (size_t)_headerStatusLen <= _buf.Len() - _countsPos;
+
+        if (valid && _truncated)
+            valid = _countsPos + _headerStatusLen <= _footerPos && _footerPos <= _buf.Len();
+    }
+
+    if (valid)
+        return true;
+
+    release();
+    _fileResults.clear();
+    _filesCount = 0;
+    _hits = 0;
+    _truncated = false;
+    _dirTree = false;
+    _sortByHits = false;
+
+    return false;
+}
+
+
+/**
+ *  \brief  The file results map and the counts stay - they are needed for the database update notifications
+ */
+void ResultWin::TabParser::release()
+{
+    _buf.Free();
+    std::vector<Record>().swap(_records);
+    std::vector<uint32_t>().swap(_cols);
+    std::vector<std::string>().swap(_files);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::TabParser::setSearch(const CmdPtr_t& cmd)
+{
+    _search     = CTextA(cmd->Tag().C_str()).C_str();
+    _searchIC   = cmd->IgnoreCase();
+    _searchRE   = cmd->RegExp();
+    _searchWW   = (cmd->Id() != GREP && cmd->Id() != GREP_TEXT);
+}
+
+
+/**
+ *  \brief
+ */
+void ResultWin::TabParser::addFileRecord(const char* pFile, size_t len, bool findMatches)
+{
+    Record rec;
+    rec.file        = (uint32_t)_files.size();
+    rec.cols        = (uint32_t)_cols.size();
+    rec.colsCount   = 0;
+    rec.indent      = 0;
+    rec.line        = -1;
+
+    if (findMatches)
+        addMatchCols(rec, pFile, len, false);
+
+    _files.emplace_back(pFile, len);
+    _records.push_back(rec);
+}
+
+
+/**
+ *  \brief  Records the result line of the last added file. pTxt is the line text after the indent
+ */
+void ResultWin::TabParser::addLineRecord(intptr_t line, const char* pTxt, size_t len, size_t indent)
+{
+    Record rec;
+    rec.file        = (uint32_t)_files.size() - 1;
+    rec.cols        = (uint32_t)_cols.size();
+    rec.colsCount   = 0;
+    rec.indent      = (uint32_t)indent;
+    rec.line        = line;
+
+    addMatchCols(rec, pTxt, len, _searchWW);
+
+    _records.push_back(rec);
+}
+
+
+/**
+ *  \brief  Finds the search matches the same way Scintilla finds them for highlighting and on open.
+ *          Global has no output format with match columns so they are found here once instead
+ */
+void ResultWin::TabParser::addMatchCols(Record& rec, const char* pTxt, size_t len, bool wholeWord)
+{
+    const size_t searchLen = _search.size();
+
+    if (_searchRE || !searchLen)
+        return;
+
+    const char* pSearch = _search.c_str();
+
+    for (size_t i = 0; i + searchLen <= len; ++i)
+    {
+        if (_searchIC ? _strnicmp(pTxt + i, pSearch, searchLen) : strncmp(pTxt + i, pSearch, searchLen))
+            continue;
+
+        if (wholeWord && ((i > 0 && isWordChar(pTxt[i - 1])) ||
+                (i + searchLen < len && isWordChar(pTxt[i + searchLen]))))
+            continue;
+
+        _cols.push_back((uint32_t)(rec.indent + i));
+        ++rec.colsCount;
+
+        i += searchLen - 1;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+bool ResultWin::TabParser::filterEntry(const DbConfig& cfg, const char* pEntry, size_t len)
+{
+    if (cfg._usePathFilter && !cfg._pathFilters.empty())
+    {
+        _entryPath.Clear();
+        _entryPath.Append(pEntry, len);
+
+        for (const auto& filter : cfg._pathFilters)
+        {
+            if (filter.IsParentOf(_entryPath))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ *  \brief
+ */
+intptr_t ResultWin::TabParser::parseFindFile(const CmdPtr_t& cmd)
+{
+    const DbConfig& cfg = cmd->Db()->GetConfig();
+
+    cmd->ForEachResultLine([this, &cfg](const char* pLine, size_t len)
+    {
+        while (len && (*pLine == ' ' || *pLine == '\t'))
+        {
+            ++pLine;
+            --len;
+        }
+
+        if (len && !filterEntry(cfg, pLine, len))
+        {
+            _buf += "\n\t";
+            _buf.Append(pLine, len);
+
+            addResultFile(pLine, len, 0);
+            addFileRecord(pLine, len, true);
+
+            ++_filesCount;
+        }
+
+        return true;
+    });
+
+    return _filesCount;
+}
+
+
+/**
+ *  \brief
+ */
+intptr_t ResultWin::TabParser::parseCmd(const CmdPtr_t& cmd)
+{
+    bool filterReoccurring = false;
+
+    const DbConfig& cfg = cmd->Db()->GetConfig();
+    if (cmd->Id() == FIND_DEFINITION && cfg._useLibDb)
+    {
+        for (const auto& libPath : cfg._libDbPaths)
+        {
+            if (libPath.IsParentOf(cmd->Db()->GetPath()))
+            {
+                filterReoccurring = true;
+                break;
+            }
+        }
+    }
+
+    StrUniquenessChecker<char> strChecker;
+
+    // The lines are read straight from the output chunks so the previous file is kept as a copy
+    std::string previousFile = _lastFile;
+    bool        previousFileFiltered = _lastFileFiltered;
+    std::string entryFile;
+    bool        entryFileFiltered = false;
+
+    intptr_t    line = _lastLine;
+
+    const bool parsed = cmd->ForEachResultLine([&](const char* pLine, size_t len)
+    {
+        if (len == 0)
+            return true;
+
+        const char* const pEnd = pLine + len;
+
+        const char* pIdx = static_cast<const char*>(memchr(pLine, ':', len));
+        if (pIdx == NULL)
+            return false;
+
+        // Path is absolute (starts with drive letter)
+        if ((pIdx - pLine == 1) && (pIdx + 1 < pEnd) && ((*(pIdx + 1) == '\\') || (*(pIdx + 1) == '/')))
+        {
+            pIdx = static_cast<const char*>(memchr(pIdx + 1, ':', pEnd - pIdx - 1));
+            if (pIdx == NULL)
+                return false;
+        }
+
+        const size_t previousBufLen = _buf.Len();
+        const size_t previousRecords = _records.size();
+        const size_t fileLen = pIdx - pLine;
+        bool fileAdded = false;
+        bool newFile = false;
+
+        // add new file name to the UI buffer only if it is different
+        // than the previous one
+        if (previousFile.empty() || fileLen != previousFile.size() || memcmp(pLine, previousFile.data(), fileLen))
+        {
+            entryFile.swap(previousFile);
+            entryFileFiltered = previousFileFiltered;
+            previousFile.assign(pLine, fileLen);
+
+            if (filterEntry(cfg, pLine, fileLen))
+            {
+                previousFileFiltered = true;
+            }
+            else
+            {
+                ++line;
+                _buf += "\n\t";
+                _buf.Append(pLine, fileLen);
+
+                newFile = !isFileInResults(previousFile);
+                if (newFile)
+                    addResultFile(pLine, fileLen, line);
+
+                addFileRecord(pLine, fileLen);
+
+                ++_filesCount;
+                fileAdded = true;
+
+                previousFileFiltered = false;
+            }
+        }
+
+        if (previousFileFiltered)
+            return true;
+
+        const char* const pNum = pIdx + 1;
+
+        pIdx = static_cast<const char*>(memchr(pNum, ':', pEnd - pNum));
+        if (pIdx == NULL)
+            return false;
+
+        ++line;
+        _buf += "\n\t\tline ";
+        _buf.Append(pNum, pIdx - pNum);
+        _buf += ":\t";
+
+        const intptr_t srcLine = (intptr_t)strtoll(pNum, NULL, 10) - 1;
+        const char* const pTxt = ++pIdx;
+
+        while (pIdx < pEnd && (*pIdx == ' ' || *pIdx == '\t'))
+            ++pIdx;
+
+        if (pIdx == pEnd)
+            return false;
+
+        _buf.Append(pIdx, pEnd - pIdx);
+
+        addLineRecord(srcLine, pIdx, pEnd - pIdx, pIdx - pTxt);
+
+        if (filterReoccurring && !strChecker.IsUnique(pLine, len))
+        {
+            // Drop the whole entry including the file line if it was added for it
+            _buf.Resize(previousBufLen);
+            _cols.resize(_records[previousRecords].cols);
+            _records.resize(previousRecords);
+            line = (intptr_t)previousRecords - 1;
+
+            if (fileAdded)
+            {
+                if (newFile)
+                    _fileResults.erase(_files.back());
+
+                _files.pop_back();
+                --_filesCount;
+
+                previousFile.swap(entryFile);
+                previousFileFiltered = entryFileFiltered;
+            }
+        }
+        else
+        {
+            ++_hits;
+        }
+
+        return true;
+    });
+
+    if (!parsed)
+        return -1;
+
+    if (_truncated)
+    {
+        _lastLine = line;
+        _lastFileFiltered = previousFileFiltered;
+        _lastFile = previousFile;
+    }
+
+    return _hits;
+}
+
+
+/**
+ *  \brief  Parses the results of a single file re-queried with global -l in its folder
+ */
+intptr_t ResultWin::TabParser::parseFileGroup(const CmdPtr_t& cmd)
+{
+    _buf.Clear();
+    _fileResults.clear();
+    _filesCount = 0;
+    _hits = 0;
+
+    _records.clear();
+    _files.clear();
+    _cols.clear();
+
+    _records.emplace_back(); // The empty first line
+
+    if (filterEntry(cmd->Db()->GetConfig(), _onlyFile.c_str(), _onlyFile.size()))
+        return 0;
+
+    const size_t fileLen = _onlyFile.size();
+
+    const bool parsed = cmd->ForEachResultLine([this, fileLen](const char* pFile, size_t len)
+    {
+        const char* const pEol = pFile + len;
+
+        if (len > 2 && pFile[0] == '.' && pFile[1] == '/')
+            pFile += 2;
+
+        // Other files in the same folder
+        if ((size_t)(pEol - pFile) <= fileLen || strncmp(pFile, _onlyFile.c_str(), fileLen) || pFile[fileLen] != ':')
+            return true;
+
+        const char* pLine = pFile + fileLen + 1;
+        const char* pTxt = pLine;
+        while (pTxt < pEol && *pTxt != ':')
+            ++pTxt;
+
+        if (pTxt == pEol)
+            return false;
+
+        if (_hits == 0)
+        {
+            _buf += "\n\t";
+            _buf.Append(_onlyFile.c_str(), fileLen);
+
+            addFileRecord(_onlyFile.c_str(), fileLen);
+        }
+
+        _buf += "\n\t\tline ";
+        _buf.Append(pLine, pTxt - pLine);
+        _buf += ":\t";
+
+        const char* pIndent = ++pTxt;
+        while (pTxt < pEol && (*pTxt == ' ' || *pTxt == '\t'))
+            ++pTxt;
+
+        _buf.Append(pTxt, pEol - pTxt);
+
+        addLineRecord((intptr_t)strtoll(pLine, NULL, 10) - 1, pTxt, pEol - pTxt, pTxt - pIndent);
+
+        ++_hits;
+
+        return true;
+    });
+
+    if (!parsed)
+        return -1;
+
+    if (_hits)
+    {
+        addResultFile(_onlyFile.c_str(), fileLen, 1);
+        _filesCount = 1;
+    }
+
+    return _hits;
+}
+
+} // namespace GTags
@@ -0,0 +1,307 @@
+/**
+ *  \file
+ *  \brief  Chrome trace event format recorder
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Tracer.h"
+#include <tchar.h>
+#include <cstdio>
+#include "INpp.h"
+#include "GTags.h"
+#include "CmdTiming.h"
+
+
+namespace GTags
+{
+
+std::atomic<bool>           Tracer::On {false};
+std::atomic<unsigned>       Tracer::FlowIds {0};
+
+Mutex                       Tracer::Lock;
+std::vector<std::string>    Tracer::Events;
+LONGLONG                    Tracer::Origin = 0;
+LONGLONG                    Tracer::Freq = 1;
+
+
+/**
+ *  \brief
+ */
+bool Tracer::Start()
+{
+    if (IsOn())
+        return true;
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+
+    {
+        AUTOLOCK(Lock);
+
+        Events.clear();
+        Freq = freq.QuadPart;
+        Origin = CmdTiming::Now();
+    }
+
+    On = true;
+
+    ThreadName("Notepad++ UI");
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+bool Tracer::Stop(CPath* traceFile)
+{
+    if (!IsOn())
+        return false;
+
+    On = false;
+
+    SYSTEMTIME time;
+    GetLocalTime(&time);
+
+    TCHAR fileName[64];
+    _sntprintf_s(fileName, _countof(fileName), _TRUNCATE, _T("%s_trace_%04u%02u%02u_%02u%02u%02u.json"),
+            cPluginName, time.wYear, time.wMonth, time.wDay, time.wHour, time.wMinute, time.wSecond);
+
+    CPath file;
+    INpp::Get().GetPluginsConfDir(file);
+    file += fileName;
+
+    FILE* fp;
+    _tfopen_s(&fp, file.C_str(), _T("wb"));
+
+    AUTOLOCK(Lock);
+
+    if (fp == NULL)
+    {
+        Events.clear();
+        return false;
+    }
+
+    fputs("{\"traceEvents\":[\n", fp);
+
+    for (size_t i = 0; i < Events.size(); ++i)
+    {
+        if (i)
+            fputs(",\n", fp);
+        fwrite(Events[i].data(), 1, Events[i].size(), fp);
+    }
+
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", fp);
+    fclose(fp);
+
+    Events.clear();
+
+    if (traceFile)
+        *traceFile = file;
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+unsigned Tracer::NewFlowId()
+{
+    return ++FlowIds;
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::Complete(const char* name, const char* cat, LONGLONG start, LONGLONG end, const std::string& args)
+{
+    if (!IsOn() || !start || end < start)
+        return;
+
+    char dur[48];
+    _snprintf_s(dur, _countof(dur), _TRUNCATE, ",\"dur\":%.3f", (double)(end - start) * 1000000.0 / (double)Freq);
+
+    addEvent("X", name, cat, start, dur, args);
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::Instant(const char* name, const char* cat, const std::string& args)
+{
+    if (!IsOn())
+        return;
+
+    addEvent("i", name, cat, CmdTiming::Now(), ",\"s\":\"t\"", args);
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::Counter(const char* name, const std::string& args)
+{
+    if (!IsOn())
+        return;
+
+    addEvent("C", name, "db", CmdTiming::Now(), "", args);
+}
+
+
+/**
+ *  \brief  Starts a flow arrow from the current slice of the calling thread
+ */
+void Tracer::FlowStart(const char* cat, unsigned id)
+{
+    if (!IsOn() || !id)
+        return;
+
+    char extra[32];
+    _snprintf_s(extra, _countof(extra), _TRUNCATE, ",\"id\":%u", id);
+
+    addEvent("s", cat, cat, CmdTiming::Now(), extra, std::string());
+}
+
+
+/**
+ *  \brief  Ends a flow arrow in the slice of the calling thread that encloses time
+ */
+void Tracer::FlowEnd(const char* cat, unsigned id, LONGLONG time)
+{
+    if (!IsOn() || !id)
+        return;
+
+    char extra[48];
+    _snprintf_s(extra, _countof(extra), _TRUNCATE, ",\"id\":%u,\"bp\":\"e\"", id);
+
+    addEvent("f", cat, cat, time, extra, std::string());
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::ThreadName(const char* name)
+{
+    if (!IsOn())
+        return;
+
+    addEvent("M", "thread_name", "__metadata", Origin, "", Arg("name", name));
+}
+
+
+/**
+ *  \brief
+ */
+std::string Tracer::Arg(const char* name, const char* val)
+{
+    std::string arg("\"");
+    arg += name;
+    arg += "\":\"";
+    appendEscaped(arg, val);
+    arg += "\"";
+
+    return arg;
+}
+
+
+/**
+ *  \brief
+ */
+std::string Tracer::Arg(const char* name, const wchar_t* val)
+{
+    CTextA valA(val);
+
+    return Arg(name, valA.C_str());
+}
+
+
+/**
+ *  \brief
+ */
+std::string Tracer::Arg(const char* name, long long val)
+{
+    std::string arg("\"");
+    arg += name;
+    arg += "\":";
+    arg += std::to_string(val);
+
+    return arg;
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::addEvent(const char* ph, const char* name, const char* cat, LONGLONG time,
+        const char* extra, const std::string& args)
+{
+    std::string ev("{\"name\":\"");
+    appendEscaped(ev, name);
+    ev += "\",\"cat\":\"";
+    ev += cat;
+    ev += "\",\"ph\":\"";
+    ev += ph;
+
+    char buf[96];
+    _snprintf_s(buf, _countof(buf), _TRUNCATE, "\",\"pid\":%lu,\"tid\":%lu,\"ts\":%.3f",
+            GetCurrentProcessId(), GetCurrentThreadId(), (double)(time - Origin) * 1000000.0 / (double)Freq);
+    ev += buf;
+    ev += extra;
+
+    if (!args.empty())
+    {
+        ev += ",\"args\":{";
+        ev += args;
+        ev += "}";
+    }
+
+    ev += "}";
+
+    AUTOLOCK(Lock);
+
+    // Tracing might have been stopped meanwhile
+    if (IsOn())
+        Events.push_back(std::move(ev));
+}
+
+
+/**
+ *  \brief
+ */
+void Tracer::appendEscaped(std::string& str, const char* txt)
+{
+    for (; *txt; ++txt)
+    {
+        if (*txt == '"' || *txt == '\\')
+            str += '\\';
+        else if ((unsigned char)*txt < 0x20)
+            continue;
+
+        str += *txt;
+    }
+}
+
+} // namespace GTags
@@ -0,0 +1,80 @@
+/**
+ *  \file
+ *  \brief  Chrome trace event format recorder
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <atomic>
+#include <vector>
+#include <string>
+#include "Common.h"
+#include "AutoLock.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  Tracer
+ *  \brief  Records trace events (thread safe) and writes them as Chrome trace JSON when stopped
+ */
+class Tracer
+{
+public:
+    static bool Start();
+    static bool Stop(CPath* traceFile = NULL);
+
+    static inline bool IsOn() { return On.load(std::memory_order_relaxed); }
+
+    static unsigned NewFlowId();
+
+    // Timestamps are performance counter values - the same as in CmdTiming
+    static void Complete(const char* name, const char* cat, LONGLONG start, LONGLONG end,
+            const std::string& args = std::string());
+    static void Instant(const char* name, const char* cat, const std::string& args = std::string());
+    static void Counter(const char* name, const std::string& args);
+    static void FlowStart(const char* cat, unsigned id);
+    static void FlowEnd(const char* cat, unsigned id, LONGLONG time);
+    static void ThreadName(const char* name);
+
+    static std::string Arg(const char* name, const char* val);
+    static std::string Arg(const char* name, const wchar_t* val);
+    static std::string Arg(const char* name, long long val);
+
+private:
+    static std::atomic<bool>        On;
+    static std::atomic<unsigned>    FlowIds;
+
+    static Mutex                    Lock;
+    static std::vector<std::string> Events;
+    static LONGLONG                 Origin;
+    static LONGLONG                 Freq;
+
+    static void addEvent(const char* ph, const char* name, const char* cat, LONGLONG time,
+            const char* extra, const std::string& args);
+    static void appendEscaped(std::string& str, const char* txt);
+};
+
+} // namespace GTags
@@ -0,0 +1,296 @@
+/**
+ *  \file
+ *  \brief  Per database completions usage model used to rank the completion lists
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "UsageModel.h"
+#include "LineParser.h"
+#include "GTags.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+
+
+namespace GTags
+{
+
+const char      UsageModel::cMagic[]            = "NGUM";
+const uint32_t  UsageModel::cVersion            = 1;
+const unsigned  UsageModel::cMaxEntries         = 1024;
+const float     UsageModel::cCompletionWeight   = 1.0f;
+const float     UsageModel::cVisitWeight        = 0.5f;
+const float     UsageModel::cHalfLifeHours      = 14 * 24;
+const float     UsageModel::cMinScore           = 0.05f;
+
+
+/**
+ *  \brief
+ */
+bool UsageModel::Open(const CPath& dbPath)
+{
+    if (_data)
+        return true;
+
+    // Don't retry on every completion if the database folder is read-only
+    if (_failed)
+        return false;
+
+    CPath file(dbPath);
+    file += cUsageFileName;
+
+    const DWORD size = (DWORD)(sizeof(Header) + cMaxEntries * sizeof(Entry));
+
+    _hFile = CreateFile(file.C_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (_hFile != INVALID_HANDLE_VALUE)
+    {
+        // Grows a new file to the full size, zero filled
+        _hMap = CreateFileMapping(_hFile, NULL, PAGE_READWRITE, 0, size, NULL);
+
+        if (_hMap)
+            _data = static_cast<char*>(MapViewOfFile(_hMap, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    }
+
+    if (!_data)
+    {
+        Close();
+        _failed = true;
+        return false;
+    }
+
+    Header* hdr = header();
+
+    if (memcmp(hdr->magic, cMagic, sizeof(hdr->magic)) || hdr->version != cVersion || hdr->count > cMaxEntries)
+    {
+        memset(_data, 0, size);
+        memcpy(hdr->magic, cMagic, sizeof(hdr->magic));
+        hdr->version = cVersion;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+void UsageModel::Close()
+{
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+        _data = NULL;
+    }
+
+    if (_hMap)
+    {
+        CloseHandle(_hMap);
+        _hMap = NULL;
+    }
+
+    if (_hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_hFile);
+        _hFile = INVALID_HANDLE_VALUE;
+    }
+}
+
+
+/**
+ *  \brief
+ */
+void UsageModel::Rank(const std::vector<TCHAR*>& matches, bool sorted, const TCHAR* prefix, size_t len,
+        bool ignoreCase, std::vector<TCHAR*>& ranked) const
+{
+    ranked.clear();
+
+    if (!_data || matches.empty())
+        return;
+
+    const Header* hdr = header();
+    const Entry* e = entries();
+    const uint32_t hour = currentHour();
+
+    // Index in matches and score of each used match
+    std::vector<std::pair<size_t, float>> used;
+
+    if (sorted)
+    {
+        for (uint32_t i = 0; i < hdr->count; ++i)
+        {
+            if (len && (ignoreCase ? _tcsnicmp(e[i].name, prefix, len) : _tcsncmp(e[i].name, prefix, len)))
+                continue;
+
+            const float score = decayed(e[i], hour);
+            if (score < cMinScore)
+                continue;
+
+            auto iMatch = std::lower_bound(matches.begin(), matches.end(), e[i].name, LineParser::Less);
+
+            if (iMatch != matches.end() && !_tcscmp(*iMatch, e[i].name))
+                used.emplace_back(iMatch - matches.begin(), score);
+        }
+    }
+    else
+    {
+        // Look up each of the unordered matches in the sorted used entries instead
+        std::vector<const Entry*> usedEntries;
+
+        for (uint32_t i = 0; i < hdr->count; ++i)
+            if (decayed(e[i], hour) >= cMinScore)
+                usedEntries.push_back(&e[i]);
+
+        if (usedEntries.empty())
+            return;
+
+        std::sort(usedEntries.begin(), usedEntries.end(),
+            [](const Entry* a, const Entry* b) { return LineParser::Less(a->name, b->name); });
+
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            auto iEntry = std::lower_bound(usedEntries.begin(), usedEntries.end(), matches[i],
+                [](const Entry* entry, const TCHAR* name) { return LineParser::Less(entry->name, name); });
+
+            if (iEntry != usedEntries.end() && !_tcscmp((*iEntry)->name, matches[i]))
+                used.emplace_back(i, decayed(**iEntry, hour));
+        }
+    }
+
+    if (used.empty())
+        return;
+
+    std::sort(used.begin(), used.end(),
+        [](const std::pair<size_t, float>& a, const std::pair<size_t, float>& b)
+        {
+            return (a.second > b.second || (a.second == b.second && a.first < b.first));
+        });
+
+    ranked.reserve(matches.size());
+
+    for (const auto& u : used)
+        ranked.push_back(matches[u.first]);
+
+    std::vector<size_t> skip;
+    skip.reserve(used.size());
+
+    for (const auto& u : used)
+        skip.push_back(u.first);
+
+    std::sort(skip.begin(), skip.end());
+
+    auto iSkip = skip.begin();
+
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+        if (iSkip != skip.end() && *iSkip == i)
+            ++iSkip;
+        else
+            ranked.push_back(matches[i]);
+    }
+}
+
+
+/**
+ *  \brief
+ */
+uint32_t UsageModel::currentHour()
+{
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+
+    ULARGE_INTEGER t;
+    t.LowPart   = ft.dwLowDateTime;
+    t.HighPart  = ft.dwHighDateTime;
+
+    // 100ns intervals since 1601
+    return (uint32_t)(t.QuadPart / 36000000000ULL);
+}
+
+
+/**
+ *  \brief
+ */
+float UsageModel::decayed(const Entry& entry, uint32_t hour)
+{
+    if (hour <= entry.hour)
+        return entry.score;
+
+    return entry.score * std::exp2(-(float)(hour - entry.hour) / cHalfLifeHours);
+}
+
+
+/**
+ *  \brief
+ */
+void UsageModel::record(const TCHAR* entry, float weight)
+{
+    if (!_data)
+        return;
+
+    const size_t len = _tcslen(entry);
+    if (!len || len > cMaxNameLen)
+        return;
+
+    Header* hdr = header();
+    Entry* e = entries();
+    const uint32_t hour = currentHour();
+
+    Entry* slot = NULL;
+    Entry* weakest = NULL;
+    float weakestScore = 0;
+
+    for (uint32_t i = 0; i < hdr->count; ++i)
+    {
+        if (!_tcscmp(e[i].name, entry))
+        {
+            slot = &e[i];
+            break;
+        }
+
+        const float score = decayed(e[i], hour);
+
+        if (!weakest || score < weakestScore)
+        {
+            weakest = &e[i];
+            weakestScore = score;
+        }
+    }
+
+    if (slot)
+    {
+        slot->score = decayed(*slot, hour) + weight;
+    }
+    else
+    {
+        // Forget the least used entry when full
+        slot = (hdr->count < cMaxEntries) ? &e[hdr->count++] : weakest;
+
+        _tcscpy_s(slot->name, _countof(slot->name), entry);
+        slot->score = weight;
+    }
+
+    slot->hour = hour;
+}
+
+} // namespace GTags
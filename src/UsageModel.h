@@ -0,0 +1,115 @@
+/**
+ *  \file
+ *  \brief  Per database completions usage model used to rank the completion lists
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2022 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <tchar.h>
+#include <cstdint>
+#include <vector>
+#include "Common.h"
+
+
+namespace GTags
+{
+
+/**
+ *  \class  UsageModel
+ *  \brief  Counts the accepted completions and the visited definitions with exponential decay over time
+ *
+ *  The counters live in a small fixed size memory-mapped file in the database folder so nothing is loaded
+ *  or saved explicitly. UI thread only.
+ */
+class UsageModel
+{
+public:
+    UsageModel() : _hFile(INVALID_HANDLE_VALUE), _hMap(NULL), _data(NULL), _failed(false) {}
+    ~UsageModel() { Close(); }
+
+    bool Open(const CPath& dbPath);
+    void Close();
+
+    inline bool IsOpen() const { return (_data != NULL); }
+
+    inline void RecordCompletion(const TCHAR* entry) { record(entry, cCompletionWeight); }
+    inline void RecordVisit(const TCHAR* entry) { record(entry, cVisitWeight); }
+
+    // Fills ranked with the used matches by descending score followed by the rest in their order.
+    // Sorted matches must be ordered as LineParser sorts them and all start with prefix.
+    // ranked is left empty if none of the matches has been used.
+    void Rank(const std::vector<TCHAR*>& matches, bool sorted, const TCHAR* prefix, size_t len, bool ignoreCase,
+            std::vector<TCHAR*>& ranked) const;
+
+private:
+    static const char       cMagic[];
+    static const uint32_t   cVersion;
+    static const unsigned   cMaxEntries;
+    static const unsigned   cMaxNameLen = 59;
+    static const float      cCompletionWeight;
+    static const float      cVisitWeight;
+    static const float      cHalfLifeHours;
+    static const float      cMinScore;
+
+    /**
+     *  \struct  Entry
+     *  \brief
+     */
+    struct Entry
+    {
+        float       score;
+        uint32_t    hour;   // Of the last score update
+        TCHAR       name[cMaxNameLen + 1];
+    };
+
+    /**
+     *  \struct  Header
+     *  \brief
+     */
+    struct Header
+    {
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    count;
+        uint32_t    reserved;
+    };
+
+    UsageModel(const UsageModel&) = delete;
+    UsageModel& operator=(const UsageModel&) = delete;
+
+    static uint32_t currentHour();
+    static float decayed(const Entry& entry, uint32_t hour);
+
+    inline Header* header() const { return reinterpret_cast<Header*>(_data); }
+    inline Entry* entries() const { return reinterpret_cast<Entry*>(_data + sizeof(Header)); }
+
+    void record(const TCHAR* entry, float weight);
+
+    HANDLE  _hFile;
+    HANDLE  _hMap;
+    char*   _data;
+    bool    _failed;
+};
+
+} // namespace GTags
@@ -0,0 +1,284 @@
+/**
+ *  \file
+ *  \brief  Benchmarks measuring - time, operator new allocations and peak RSS of each run
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "BenchTools.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace
+{
+
+std::atomic<uint64_t> AllocsCount(0);
+std::atomic<uint64_t> AllocsBytes(0);
+
+
+/**
+ *  \brief
+ */
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ *  \brief  Returns the value in bytes of a /proc/<pid>/status or /proc/meminfo kB field or 0
+ */
+size_t procField(const char* file, const char* field)
+{
+    FILE* fp = fopen(file, "r");
+    if (!fp)
+        return 0;
+
+    const size_t fieldLen = strlen(field);
+    size_t val = 0;
+    char line[256];
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (!strncmp(line, field, fieldLen) && line[fieldLen] == ':')
+        {
+            val = (size_t)strtoull(line + fieldLen + 1, NULL, 10) * 1024;
+            break;
+        }
+    }
+
+    fclose(fp);
+
+    return val;
+}
+
+
+/**
+ *  \brief
+ */
+bool resetPeakRSS()
+{
+    FILE* fp = fopen("/proc/self/clear_refs", "w");
+    if (!fp)
+        return false;
+
+    const bool ok = (fputs("5", fp) >= 0);
+
+    return (fclose(fp) == 0 && ok);
+}
+
+
+/**
+ *  \brief
+ */
+size_t peakRSS()
+{
+    size_t peak = procField("/proc/self/status", "VmHWM");
+
+    if (!peak)
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        peak = (size_t)usage.ru_maxrss * 1024;
+    }
+
+    return peak;
+}
+
+
+/**
+ *  \brief
+ */
+void* countedAlloc(size_t size)
+{
+    ++AllocsCount;
+    AllocsBytes += size;
+
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+} // anonymous namespace
+
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+
+namespace Bench
+{
+
+/**
+ *  \brief
+ */
+Measure::Measure() : _ms(0), _allocs(0), _allocBytes(0), _peakRSS(0)
+{
+    resetPeakRSS();
+
+    _startAllocs = AllocsCount;
+    _startAllocBytes = AllocsBytes;
+    _start = nowNs();
+}
+
+
+/**
+ *  \brief
+ */
+void Measure::Stop()
+{
+    _ms = (nowNs() - _start) / 1e6;
+    _allocs = AllocsCount - _startAllocs;
+    _allocBytes = AllocsBytes - _startAllocBytes;
+    _peakRSS = peakRSS();
+}
+
+
+/**
+ *  \brief
+ */
+void Measure::Report(const char* name, size_t lines, size_t bytes, long long result) const
+{
+    const double s = (_ms > 0) ? _ms / 1000 : 1e-9;
+
+    printf("%-28s %10zu %9.1f %10.2f %9.1f %11llu %10.1f %9.1f %11lld\n", name, lines, _ms, lines / s / 1e6,
+            bytes / s / (1024 * 1024), (unsigned long long)_allocs, _allocBytes / (1024.0 * 1024),
+            _peakRSS / (1024.0 * 1024), result);
+    fflush(stdout);
+}
+
+
+/**
+ *  \brief
+ */
+void PrintHeader()
+{
+    printf("%-28s %10s %9s %10s %9s %11s %10s %9s %11s\n", "run", "lines", "ms", "Mlines/s", "MB/s",
+            "allocs", "alloc MB", "peak MB", "result");
+    fflush(stdout);
+}
+
+
+/**
+ *  \brief
+ */
+std::vector<size_t> ParseSizes(int argc, char* argv[], const char* defaults)
+{
+    const char* list = defaults;
+
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!strcmp(argv[i], "--lines"))
+            list = argv[i + 1];
+
+    std::vector<size_t> sizes;
+
+    for (const char* pSrc = list; *pSrc;)
+    {
+        char* pEnd;
+        const size_t size = (size_t)strtoull(pSrc, &pEnd, 10);
+
+        if (pEnd == pSrc)
+            break;
+
+        if (size)
+            sizes.push_back(size);
+
+        pSrc = (*pEnd == ',') ? pEnd + 1 : pEnd;
+    }
+
+    return sizes;
+}
+
+
+/**
+ *  \brief
+ */
+unsigned ParseRepeat(int argc, char* argv[])
+{
+    unsigned repeat = 1;
+
+    for (int i = 1; i + 1 < argc; ++i)
+        if (!strcmp(argv[i], "--repeat"))
+            repeat = (unsigned)strtoul(argv[i + 1], NULL, 10);
+
+    return repeat ? repeat : 1;
+}
+
+
+/**
+ *  \brief
+ */
+bool RunIsolated(const char* name, const std::function<void()>& run, size_t estimatedBytes)
+{
+    const size_t available = procField("/proc/meminfo", "MemAvailable");
+
+    if (available && estimatedBytes > available)
+    {
+        printf("%-28s skipped - needs about %zu MB, %zu MB available\n", name, estimatedBytes >> 20,
+                available >> 20);
+        fflush(stdout);
+        return true;
+    }
+
+    fflush(stdout);
+
+    const pid_t pid = fork();
+
+    if (pid < 0)
+        return false;
+
+    if (pid == 0)
+    {
+        run();
+        fflush(stdout);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        return true;
+
+    printf("%-28s failed - %s %d\n", name, WIFSIGNALED(status) ? "signal" : "exit code",
+            WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+    fflush(stdout);
+
+    return false;
+}
+
+} // namespace Bench
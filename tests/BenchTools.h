@@ -0,0 +1,82 @@
+/**
+ *  \file
+ *  \brief  Benchmarks measuring - time, operator new allocations and peak RSS of each run
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+
+namespace Bench
+{
+
+/**
+ *  \class  Measure
+ *  \brief  Measures from construction to Stop(). The peak RSS is of the measured part only where the kernel
+ *          allows resetting it - it includes what was resident when the measuring started
+ */
+class Measure
+{
+public:
+    Measure();
+
+    void Stop();
+
+    // Prints a table row - lines and bytes are the processed input
+    void Report(const char* name, size_t lines, size_t bytes, long long result) const;
+
+    inline double Ms() const { return _ms; }
+    inline uint64_t Allocs() const { return _allocs; }
+    inline uint64_t AllocBytes() const { return _allocBytes; }
+    inline size_t PeakRSS() const { return _peakRSS; }
+
+private:
+    int64_t     _start;
+    uint64_t    _startAllocs;
+    uint64_t    _startAllocBytes;
+
+    double      _ms;
+    uint64_t    _allocs;
+    uint64_t    _allocBytes;
+    size_t      _peakRSS;
+};
+
+
+void PrintHeader();
+
+// --lines 1000,20000 or the defaults
+std::vector<size_t> ParseSizes(int argc, char* argv[], const char* defaults);
+
+// --repeat N or 1 - the runs report the fastest repeat as the timing is noisy
+unsigned ParseRepeat(int argc, char* argv[]);
+
+// Runs in a child process so each run peak RSS is its own. Skipped when the estimated memory is not available.
+// Returns false if the run failed
+bool RunIsolated(const char* name, const std::function<void()>& run, size_t estimatedBytes);
+
+} // namespace Bench
@@ -0,0 +1,315 @@
+/**
+ *  \file
+ *  \brief  Fake output test - the synthetic global output format, its pacing and the error injection
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Common.h"
+#include "Cmd.h"
+#include "CmdCapture.h"
+#include "DbManager.h"
+#include "LineParser.h"
+#include "ReadPipe.h"
+#include "ResultWin.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+
+
+using namespace GTags;
+
+
+namespace
+{
+
+const char cTag[] = "compute";
+
+int failures = 0;
+
+
+#define CHECK(cond) \
+    do { if (!(cond)) { printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while (0)
+
+
+/**
+ *  \brief
+ */
+CmdCapture::FakeSpec makeSpec(unsigned lines, unsigned chunk)
+{
+    CmdCapture::FakeSpec spec;
+
+    spec.lines  = lines;
+    spec.rate   = 0;
+    spec.chunk  = chunk;
+    spec.delay  = 0;
+    spec.exit   = 0;
+    spec.error  = false;
+
+    return spec;
+}
+
+
+/**
+ *  \brief  Feeds the fake output to the command as CmdEngine does in place of the process. Returns the run time
+ *          in ms or -1 if the fake could not be started
+ */
+int runFake(const CmdCapture::FakeSpec& spec, const CmdPtr_t& cmd, std::string& errors)
+{
+    ReadPipe dataPipe;
+    ReadPipe errorPipe;
+
+    HANDLE hDataIn, hErrorIn;
+    const HANDLE hSelf = GetCurrentProcess();
+
+    if (!DuplicateHandle(hSelf, dataPipe.GetInputHandle(), hSelf, &hDataIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+        return -1;
+
+    if (!DuplicateHandle(hSelf, errorPipe.GetInputHandle(), hSelf, &hErrorIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+    {
+        CloseHandle(hDataIn);
+        return -1;
+    }
+
+    const DWORD start = GetTickCount();
+
+    PROCESS_INFORMATION pi;
+
+    if (!CmdCapture::StartFake(spec, cmd->Id(), cmd->Tag(), hDataIn, hErrorIn, pi))
+    {
+        CloseHandle(hErrorIn);
+        CloseHandle(hDataIn);
+        return -1;
+    }
+
+    if (!errorPipe.Open() || !dataPipe.Open())
+    {
+        CmdCapture::EndReplay(pi);
+        return -1;
+    }
+
+    std::vector<char> errorOutput;
+    errorPipe.MoveOutput(errorOutput);
+    errors = errorOutput.empty() ? "" : errorOutput.data();
+
+    ReadPipe::Output output;
+    dataPipe.MoveOutput(output);
+    cmd->AppendToResult(std::move(output));
+
+    // The fake process exits after its last output
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    const int time = (int)(GetTickCount() - start);
+
+    CmdCapture::EndReplay(pi);
+
+    return time;
+}
+
+
+/**
+ *  \brief  The output lines of the given fake command - checks it ran without errors
+ */
+std::vector<std::string> fakeLines(CmdId_t id, unsigned lines, unsigned chunk)
+{
+    CmdPtr_t cmd = std::make_shared<Cmd>(id, nullptr, nullptr, CText(cTag).C_str());
+
+    std::string errors;
+    CHECK(runFake(makeSpec(lines, chunk), cmd, errors) >= 0);
+    CHECK(errors.empty());
+
+    std::vector<std::string> out;
+
+    cmd->ForEachResultLine([&out](const char* pLine, size_t len)
+    {
+        out.emplace_back(pLine, len);
+        return true;
+    });
+
+    return out;
+}
+
+
+/**
+ *  \brief  -c output - the completions of the tag
+ */
+void testCompletionFormat()
+{
+    const std::vector<std::string> lines = fakeLines(AUTOCOMPLETE, 250, 100);
+
+    CHECK(lines.size() == 250);
+
+    for (size_t i = 0; i < lines.size(); ++i)
+        CHECK(lines[i] == std::string(cTag) + "_" + std::to_string(i));
+}
+
+
+/**
+ *  \brief  -Po output - the file paths containing the tag
+ */
+void testFilesFormat()
+{
+    const std::vector<std::string> lines = fakeLines(FIND_FILE, 250, 7);
+
+    CHECK(lines.size() == 250);
+
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        const std::string name = std::string(cTag) + "_" + std::to_string(i) + ".c";
+
+        CHECK(lines[i].compare(0, 3, "dir") == 0);
+        CHECK(lines[i].size() > name.size() && lines[i].compare(lines[i].size() - name.size(), name.size(), name) == 0);
+        CHECK(lines[i].find('/') != std::string::npos && lines[i].find('/') < lines[i].size() - name.size());
+    }
+}
+
+
+/**
+ *  \brief  --result=grep output - file:line:text with the tag in the text, parsed in the results tab
+ */
+void testGrepFormat()
+{
+    const std::vector<std::string> lines = fakeLines(FIND_REFERENCE, 250, 100);
+
+    CHECK(lines.size() == 250);
+
+    for (const auto& line : lines)
+    {
+        const size_t fileEnd = line.find(':');
+        const size_t lineEnd = (fileEnd == std::string::npos) ? fileEnd : line.find(':', fileEnd + 1);
+
+        CHECK(lineEnd != std::string::npos);
+        if (lineEnd == std::string::npos)
+            continue;
+
+        CHECK(line.compare(fileEnd - 2, 2, ".c") == 0);
+        CHECK(strtoul(line.c_str() + fileEnd + 1, NULL, 10) > 0);
+        CHECK(line.find(cTag, lineEnd) != std::string::npos);
+    }
+
+    // The parsers take it as the real output
+    DbHandle db = std::make_shared<GTagsDb>(CPath(_T("/home/user/project/")), false);
+    db->SetConfig(DbConfig());
+
+    std::shared_ptr<ResultWin::TabParser> parser = std::make_shared<ResultWin::TabParser>();
+    CmdPtr_t cmd = std::make_shared<Cmd>(FIND_REFERENCE, db, parser, CText(cTag).C_str());
+
+    std::string errors;
+    CHECK(runFake(makeSpec(250, 100), cmd, errors) >= 0);
+
+    CHECK(parser->Parse(cmd) == 250);
+    CHECK(parser->getFilesCount() == 5);
+}
+
+
+/**
+ *  \brief  The error is the only output
+ */
+void testError()
+{
+    CmdCapture::FakeSpec spec = makeSpec(100, 10);
+    spec.error = true;
+
+    const CmdId_t ids[] = { AUTOCOMPLETE, FIND_FILE, FIND_DEFINITION, CREATE_DATABASE, VERSION };
+
+    for (CmdId_t id : ids)
+    {
+        CmdPtr_t cmd = std::make_shared<Cmd>(id, nullptr, nullptr, CText(cTag).C_str());
+
+        std::string errors;
+        CHECK(runFake(spec, cmd, errors) >= 0);
+        CHECK(errors == "global: fake error.\n");
+        CHECK(!cmd->HasResult());
+    }
+}
+
+
+/**
+ *  \brief  The first output and the exit are delayed and the lines are written at the given rate
+ */
+void testPacing()
+{
+    CmdCapture::FakeSpec spec = makeSpec(100, 10);
+    spec.delay  = 40;
+    spec.rate   = 1000;
+    spec.exit   = 30;
+
+    CmdPtr_t cmd = std::make_shared<Cmd>(AUTOCOMPLETE, nullptr, nullptr, CText(cTag).C_str());
+
+    std::string errors;
+    const int time = runFake(spec, cmd, errors);
+
+    // delay + the last chunk at line 90 + exit
+    CHECK(time >= 40 + 90 + 30);
+    CHECK(errors.empty());
+    CHECK(cmd->HasResult());
+}
+
+
+/**
+ *  \brief
+ */
+void testSpec()
+{
+    CmdCapture::FakeSpec spec;
+
+    unsetenv("NPPGTAGS_FAKE");
+    CHECK(!CmdCapture::GetFakeSpec(spec));
+
+    setenv("NPPGTAGS_FAKE", "lines=5,rate=20;chunk=2 delay=7,exit=3,error=1,unknown=9,bad", 1);
+    CHECK(CmdCapture::GetFakeSpec(spec));
+    CHECK(spec.lines == 5 && spec.rate == 20 && spec.chunk == 2 && spec.delay == 7 && spec.exit == 3 && spec.error);
+
+    // The defaults
+    setenv("NPPGTAGS_FAKE", "1", 1);
+    CHECK(CmdCapture::GetFakeSpec(spec));
+    CHECK(spec.lines == 1000 && spec.rate == 0 && spec.chunk == 100 && spec.delay == 0 && spec.exit == 0 &&
+            !spec.error);
+
+    unsetenv("NPPGTAGS_FAKE");
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+int main()
+{
+    testCompletionFormat();
+    testFilesFormat();
+    testGrepFormat();
+    testError();
+    testPacing();
+    testSpec();
+
+    if (failures)
+    {
+        printf("%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("All checks passed\n");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,212 @@
+/**
+ *  \file
+ *  \brief  Fuzzy completion benchmark - the symbols list parsing and FuzzyMatcher over all database symbols
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BenchTools.h"
+#include "Common.h"
+#include "Config.h"
+#include "Cmd.h"
+#include "DbManager.h"
+#include "LineParser.h"
+#include "FuzzyMatcher.h"
+#include "GTags.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+
+using namespace GTags;
+
+
+namespace
+{
+
+const char* const cWords[] = {
+    "get", "set", "value", "buffer", "manager", "update", "init", "config", "parse", "result",
+    "file", "path", "index", "count", "item", "list", "node", "tree", "handle", "event",
+    "window", "text", "line", "cache", "lock", "thread", "query", "match", "score", "token"
+};
+
+const size_t cWordsCount = sizeof(cWords) / sizeof(cWords[0]);
+
+// The typed patterns - a few characters matching many names, word starts, longer ones and no match
+const TCHAR* const cPatterns[] = { _T("gv"), _T("getval"), _T("mgrupd"), _T("hndlevt"), _T("qzx") };
+
+// The autocomplete window and the search box drop-down shown matches
+const size_t cMaxMatches[] = { 1000, 10000 };
+
+// One frame at 60 Hz
+const double cFrameMs = 1000.0 / 60;
+
+
+/**
+ *  \brief  global -c style output - one symbol name per line in camelCase, PascalCase and snake_case, sorted
+ *          as global prints them
+ */
+std::vector<char> makeSymbols(size_t count)
+{
+    std::vector<std::string> names;
+    names.reserve(count);
+
+    uint32_t rnd = 12345;
+    size_t outLen = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const unsigned style = i % 3;
+        const unsigned wordsCount = 2 + i % 3;
+
+        std::string name;
+
+        for (unsigned w = 0; w < wordsCount; ++w)
+        {
+            rnd = rnd * 1103515245 + 12345;
+            std::string word = cWords[(rnd >> 16) % cWordsCount];
+
+            if (style == 2)
+            {
+                if (w)
+                    name += '_';
+            }
+            else if (w || style == 1)
+            {
+                word[0] = (char)(word[0] - 'a' + 'A');
+            }
+
+            name += word;
+        }
+
+        // Keep the names unique
+        name += std::to_string(i / 7);
+
+        outLen += name.size() + 1;
+        names.push_back(std::move(name));
+    }
+
+    std::sort(names.begin(), names.end());
+
+    std::vector<char> out;
+    out.reserve(outLen + 1);
+
+    for (const auto& name : names)
+    {
+        out.insert(out.end(), name.begin(), name.end());
+        out.push_back('\n');
+    }
+
+    out.push_back(0);
+
+    return out;
+}
+
+
+/**
+ *  \brief
+ */
+void run(size_t count, unsigned repeat)
+{
+    DbHandle db = std::make_shared<GTagsDb>(CPath("/home/user/project/"), false);
+
+    std::shared_ptr<LineParser> parser = std::make_shared<LineParser>();
+    CmdPtr_t cmd = std::make_shared<Cmd>(AUTOCOMPLETE, db, parser, _T(""));
+
+    std::vector<char> symbols = makeSymbols(count);
+    const size_t symbolsLen = symbols.size() - 1;
+
+    cmd->SetResult(std::move(symbols));
+
+    // Done once per database - the list is cached
+    {
+        Bench::Measure measure;
+        const intptr_t res = parser->Parse(cmd);
+        measure.Stop();
+
+        measure.Report("parse all symbols", count, symbolsLen, (long long)res);
+    }
+
+    std::vector<TCHAR*> matches;
+    double worstMs = 0;
+
+    for (size_t maxCount : cMaxMatches)
+    {
+        for (const TCHAR* pattern : cPatterns)
+        {
+            std::unique_ptr<Bench::Measure> best;
+
+            for (unsigned r = repeat; r; --r)
+            {
+                std::unique_ptr<Bench::Measure> measure(new Bench::Measure);
+
+                FuzzyMatcher(pattern, true).SelectBest(parser->GetList(), parser->GetCharBags(), maxCount,
+                        matches);
+
+                measure->Stop();
+
+                if (!best || measure->Ms() < best->Ms())
+                    best = std::move(measure);
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "match \"%ls\" best %u", pattern, (unsigned)maxCount);
+
+            best->Report(name, count, symbolsLen, (long long)matches.size());
+
+            if (best->Ms() > worstMs)
+                worstMs = best->Ms();
+        }
+    }
+
+    printf("%u symbols: slowest match %.1f ms - %s one %.1f ms frame\n", (unsigned)count, worstMs,
+            (worstMs <= cFrameMs) ? "within" : "over", cFrameMs);
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes = Bench::ParseSizes(argc, argv, "10000,1000000");
+    const unsigned repeat = Bench::ParseRepeat(argc, argv);
+
+    GTagsSettings._fuzzyCompl = true;
+
+    Bench::PrintHeader();
+
+    bool ok = true;
+
+    for (size_t count : sizes)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "%u symbols", (unsigned)count);
+
+        // Wide names, the pointers list and the char bags
+        ok &= Bench::RunIsolated(name, [count, repeat] { run(count, repeat); }, count * 200);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+/**
+ *  \file
+ *  \brief  MpscQueue test - concurrent producers, a single consumer and the items order per producer
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MpscQueue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+const unsigned cProducers        = 8;
+const unsigned cItemsPerProducer = 200000;
+
+int failures = 0;
+
+
+#define CHECK(cond) \
+    do { if (!(cond)) { printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while (0)
+
+
+/**
+ *  \struct  Item
+ *  \brief  Move only as the command engine queues are
+ */
+struct Item
+{
+    unsigned                producer;
+    std::unique_ptr<size_t> seq;
+};
+
+
+/**
+ *  \brief  Push reports the empty queue so the consumer is woken up only once per batch
+ */
+void testSingleThread()
+{
+    MpscQueue<Item> queue;
+
+    CHECK(queue.IsEmpty());
+    CHECK(queue.Push({0, std::unique_ptr<size_t>(new size_t(0))}));
+    CHECK(!queue.Push({0, std::unique_ptr<size_t>(new size_t(1))}));
+    CHECK(!queue.IsEmpty());
+
+    std::vector<Item> items;
+    queue.PopAll(items);
+
+    CHECK(queue.IsEmpty());
+    CHECK(items.size() == 2);
+    CHECK(items.size() == 2 && *items[0].seq == 0 && *items[1].seq == 1);
+
+    items.clear();
+    queue.PopAll(items);
+    CHECK(items.empty());
+
+    CHECK(queue.Push({0, std::unique_ptr<size_t>(new size_t(2))}));
+
+    // The queued items left are freed with the queue
+}
+
+
+/**
+ *  \brief  The consumer pops while the producers push - every item comes exactly once and each producer's
+ *          items come in the order they were pushed
+ */
+void testProducers()
+{
+    MpscQueue<Item> queue;
+    std::atomic<bool> start(false);
+    std::atomic<unsigned> wakeups(0);
+
+    std::vector<std::thread> producers;
+
+    for (unsigned p = 0; p < cProducers; ++p)
+    {
+        producers.emplace_back([&queue, &start, &wakeups, p]
+        {
+            while (!start.load())
+                std::this_thread::yield();
+
+            for (size_t i = 0; i < cItemsPerProducer; ++i)
+            {
+                if (queue.Push({p, std::unique_ptr<size_t>(new size_t(i))}))
+                    ++wakeups;
+
+                // Interleave with the other threads even on a single core
+                if (i % 256 == 0)
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<size_t> next(cProducers, 0);
+    std::vector<Item> items;
+    size_t received = 0;
+    unsigned batches = 0;
+    bool ordered = true;
+
+    start.store(true);
+
+    while (received < (size_t)cProducers * cItemsPerProducer)
+    {
+        items.clear();
+        queue.PopAll(items);
+
+        if (items.empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        ++batches;
+        received += items.size();
+
+        for (const Item& item : items)
+        {
+            if (item.producer >= cProducers || *item.seq != next[item.producer])
+            {
+                ordered = false;
+                break;
+            }
+
+            ++next[item.producer];
+        }
+
+        if (!ordered)
+            break;
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    CHECK(ordered);
+    CHECK(received == (size_t)cProducers * cItemsPerProducer);
+    CHECK(queue.IsEmpty());
+
+    for (unsigned p = 0; p < cProducers; ++p)
+        CHECK(next[p] == cItemsPerProducer);
+
+    // Each non-empty PopAll takes the items pushed since exactly one push to the empty queue
+    CHECK(wakeups.load() == batches);
+
+    printf("%u producers x %u items in %u batches, %u wakeups\n", cProducers, cItemsPerProducer, batches,
+            wakeups.load());
+}
+
+
+/**
+ *  \brief  All producers done before the single PopAll - it gets everything in each producer's order
+ */
+void testSinglePopAll()
+{
+    MpscQueue<Item> queue;
+    std::vector<std::thread> producers;
+
+    for (unsigned p = 0; p < cProducers; ++p)
+    {
+        producers.emplace_back([&queue, p]
+        {
+            for (size_t i = 0; i < cItemsPerProducer / 10; ++i)
+                queue.Push({p, std::unique_ptr<size_t>(new size_t(i))});
+        });
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    std::vector<Item> items;
+    queue.PopAll(items);
+
+    CHECK(queue.IsEmpty());
+    CHECK(items.size() == (size_t)cProducers * (cItemsPerProducer / 10));
+
+    std::vector<size_t> next(cProducers, 0);
+    bool ordered = true;
+
+    for (const Item& item : items)
+    {
+        if (item.producer >= cProducers || *item.seq != next[item.producer])
+        {
+            ordered = false;
+            break;
+        }
+
+        ++next[item.producer];
+    }
+
+    CHECK(ordered);
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+int main()
+{
+    testSingleThread();
+    testProducers();
+    testSinglePopAll();
+
+    if (failures)
+    {
+        printf("%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("All checks passed\n");
+
+    return EXIT_SUCCESS;
+}
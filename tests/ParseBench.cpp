@@ -0,0 +1,257 @@
+/**
+ *  \file
+ *  \brief  Results parsing benchmark - TabParser, LineParser, StrUniquenessChecker, CTextA/W and CPath::IsParentOf
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BenchTools.h"
+#include "Common.h"
+#include "Cmd.h"
+#include "DbManager.h"
+#include "LineParser.h"
+#include "ResultWin.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+
+
+using namespace GTags;
+
+
+namespace
+{
+
+const char cDbPath[]    = "/home/user/project/";
+const char cLibPath[]   = "/home/user/";
+
+const unsigned cHitsPerFile = 8;
+
+
+/**
+ *  \struct  Workload
+ *  \brief
+ */
+struct Workload
+{
+    const char* kind;       // tab, filter (tab with path filters) or list
+    size_t      lines;
+    bool        longPaths;
+    int         dupPercent; // Repeated lines as the library databases output gives them, -1 for no libraries
+};
+
+
+/**
+ *  \brief
+ */
+std::string filePath(size_t file, bool longPaths)
+{
+    char buf[256];
+
+    if (longPaths)
+        snprintf(buf, sizeof(buf), "modules/component_%02u/subsystem/internal/implementation/details/"
+                "generated/source_file_name_%07u.cpp", (unsigned)(file % 97), (unsigned)file);
+    else
+        snprintf(buf, sizeof(buf), "src/f%07u.c", (unsigned)file);
+
+    return buf;
+}
+
+
+/**
+ *  \brief  global -x style "file:line:text" lines or a files list. The unique lines come first, then the
+ *          duplicates repeating them in order
+ */
+std::vector<char> makeOutput(const Workload& w)
+{
+    const int dupPercent = (w.dupPercent < 0) ? 0 : w.dupPercent;
+    const size_t unique = w.lines - w.lines * dupPercent / 100;
+
+    std::vector<char> out;
+    out.reserve(w.lines * (w.longPaths ? 150 : 50));
+
+    std::string line;
+
+    for (size_t i = 0; i < w.lines; ++i)
+    {
+        const size_t u = i % unique;
+
+        if (!strcmp(w.kind, "list"))
+        {
+            line = "./";
+            line += filePath(u, w.longPaths);
+        }
+        else
+        {
+            line = filePath(u / cHitsPerFile, w.longPaths);
+            line += ':';
+            line += std::to_string(u % cHitsPerFile * 10 + 1);
+            line += ":    int result = compute_value(input, 42); // line ";
+            line += std::to_string(u);
+        }
+
+        line += '\n';
+        out.insert(out.end(), line.begin(), line.end());
+    }
+
+    out.push_back(0);
+
+    return out;
+}
+
+
+/**
+ *  \brief
+ */
+DbHandle makeDb(const Workload& w)
+{
+    DbHandle db = std::make_shared<GTagsDb>(CPath(cDbPath), false);
+
+    DbConfig cfg;
+    cfg._useLibDb = (w.dupPercent >= 0);
+    if (cfg._useLibDb)
+        cfg._libDbPaths.push_back(CPath(cLibPath));
+
+    // None of the filters match so every file is checked against all of them
+    cfg._usePathFilter = !strcmp(w.kind, "filter");
+    if (cfg._usePathFilter)
+    {
+        cfg._pathFilters.push_back(CPath("modules/component_99/"));
+        cfg._pathFilters.push_back(CPath("src/generated/"));
+        cfg._pathFilters.push_back(CPath("third_party/"));
+        cfg._pathFilters.push_back(CPath("build/"));
+    }
+
+    db->SetConfig(cfg);
+
+    return db;
+}
+
+
+/**
+ *  \brief
+ */
+std::string runName(const Workload& w)
+{
+    char name[64];
+
+    if (w.dupPercent < 0)
+        snprintf(name, sizeof(name), "%s %s no libs", w.kind, w.longPaths ? "long" : "short");
+    else
+        snprintf(name, sizeof(name), "%s %s libs dup %d%%", w.kind, w.longPaths ? "long" : "short", w.dupPercent);
+
+    return name;
+}
+
+
+/**
+ *  \brief  Reports the fastest of the repeats - the input is made again for each as the command takes it over
+ */
+void run(const Workload& w, unsigned repeat)
+{
+    DbHandle db = makeDb(w);
+
+    const bool list = !strcmp(w.kind, "list");
+
+    std::unique_ptr<Bench::Measure> best;
+    size_t outputLen = 0;
+    intptr_t res = 0;
+
+    for (; repeat; --repeat)
+    {
+        std::vector<char> output = makeOutput(w);
+        outputLen = output.size() - 1;
+
+        ParserPtr_t parser;
+        if (list)
+            parser = std::make_shared<LineParser>();
+        else
+            parser = std::make_shared<ResultWin::TabParser>();
+
+        CmdPtr_t cmd =
+                std::make_shared<Cmd>(list ? AUTOCOMPLETE_FILE : FIND_DEFINITION, db, parser, _T("compute_value"));
+        cmd->SetResult(std::move(output));
+
+        std::unique_ptr<Bench::Measure> measure(new Bench::Measure);
+
+        res = parser->Parse(cmd);
+
+        measure->Stop();
+
+        if (!best || measure->Ms() < best->Ms())
+            best = std::move(measure);
+    }
+
+    best->Report(runName(w).c_str(), w.lines, outputLen, (long long)res);
+}
+
+
+/**
+ *  \brief
+ */
+bool runIsolated(const Workload& w, unsigned repeat)
+{
+    // Peak memory per line measured at 1M lines with some margin
+    size_t bytesPerLine;
+
+    if (!strcmp(w.kind, "list"))
+        bytesPerLine = w.longPaths ? 640 : 180;
+    else
+        bytesPerLine = w.longPaths ? 420 : 320;
+
+    return Bench::RunIsolated(runName(w).c_str(), [&w, repeat] { run(w, repeat); }, w.lines * bytesPerLine);
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes = Bench::ParseSizes(argc, argv, "10000,1000000,10000000");
+    const unsigned repeat = Bench::ParseRepeat(argc, argv);
+
+    const int dupPercents[] = { -1, 0, 50, 90 };
+
+    Bench::PrintHeader();
+
+    bool ok = true;
+
+    for (size_t lines : sizes)
+    {
+        for (bool longPaths : { false, true })
+        {
+            for (int dup : dupPercents)
+                ok &= runIsolated({"tab", lines, longPaths, dup}, repeat);
+
+            ok &= runIsolated({"filter", lines, longPaths, -1}, repeat);
+
+            for (int dup : dupPercents)
+                ok &= runIsolated({"list", lines, longPaths, dup}, repeat);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
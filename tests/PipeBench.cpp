@@ -0,0 +1,185 @@
+/**
+ *  \file
+ *  \brief  Command output benchmark - ReadPipe reading large outputs, handing them to the command and parsing them
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BenchTools.h"
+#include "Common.h"
+#include "Cmd.h"
+#include "DbManager.h"
+#include "ReadPipe.h"
+#include "ResultWin.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+
+
+using namespace GTags;
+
+
+namespace
+{
+
+// Lines written at once - the pipe passes them on in pieces as a child process output is
+const size_t cBlockLines = 10000;
+
+// global -x output line length on a tree with long paths
+const size_t cBytesPerLine = 100;
+
+
+/**
+ *  \brief  A block of global -x style lines repeated to make the output
+ */
+std::string makeBlock()
+{
+    std::string block;
+    block.reserve(cBlockLines * (cBytesPerLine + 8));
+
+    char line[256];
+
+    for (size_t i = 0; i < cBlockLines; ++i)
+    {
+        snprintf(line, sizeof(line), "modules/component_%02u/implementation/source_file_%05u.cpp:%u:"
+                "    int result = compute_value(input, 42);\n", (unsigned)(i % 97), (unsigned)(i / 8),
+                (unsigned)(i % 8 * 10 + 1));
+        block += line;
+    }
+
+    return block;
+}
+
+
+/**
+ *  \brief  Writes the lines and closes the pipe as the exiting global process does
+ */
+void writeOutput(HANDLE hIn, const std::string& block, size_t lines)
+{
+    while (lines)
+    {
+        size_t len = block.size();
+
+        if (lines < cBlockLines)
+        {
+            // Only the first lines of the last block
+            len = 0;
+            for (size_t i = 0; i < lines; ++i)
+                len = block.find('\n', len) + 1;
+        }
+
+        WriteFile(hIn, block.data(), (DWORD)len, NULL, NULL);
+
+        lines -= (lines < cBlockLines) ? lines : cBlockLines;
+    }
+
+    CloseHandle(hIn);
+}
+
+
+/**
+ *  \brief
+ */
+void run(size_t lines)
+{
+    DbHandle db = std::make_shared<GTagsDb>(CPath("/home/user/project/"), false);
+    ParserPtr_t parser = std::make_shared<ResultWin::TabParser>();
+    CmdPtr_t cmd = std::make_shared<Cmd>(FIND_REFERENCE, db, parser, _T("compute_value"));
+
+    const std::string block = makeBlock();
+
+    ReadPipe dataPipe;
+
+    // Open() closes the writer side handle as the process has inherited it - keep a copy for the writer
+    HANDLE hSelf = GetCurrentProcess();
+    HANDLE hIn = NULL;
+
+    if (!DuplicateHandle(hSelf, dataPipe.GetInputHandle(), hSelf, &hIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+    {
+        printf("Failed to duplicate the pipe handle\n");
+        exit(1);
+    }
+
+    size_t outputLen = 0;
+
+    {
+        Bench::Measure measure;
+
+        dataPipe.Open();
+        std::thread writer(writeOutput, hIn, std::cref(block), lines);
+
+        outputLen = dataPipe.GetOutputLen();
+        writer.join();
+
+        measure.Stop();
+        measure.Report("read pipe", lines, outputLen, (long long)outputLen);
+    }
+
+    // What CmdEngine does when the process has finished - the peak includes the chunks read above
+    {
+        Bench::Measure measure;
+
+        ReadPipe::Output output;
+        dataPipe.MoveOutput(output);
+        cmd->AppendToResult(std::move(output));
+
+        measure.Stop();
+        measure.Report("move to cmd", lines, outputLen, (long long)cmd->ResultLen());
+    }
+
+    // The results tab is parsed straight from the chunks - the output is never gathered into one buffer
+    {
+        Bench::Measure measure;
+
+        const intptr_t res = parser->Parse(cmd);
+
+        measure.Stop();
+        measure.Report("parse chunks", lines, outputLen, (long long)res);
+    }
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+int main(int argc, char* argv[])
+{
+    std::vector<size_t> sizes = Bench::ParseSizes(argc, argv, "10000,1000000,10000000");
+
+    Bench::PrintHeader();
+
+    bool ok = true;
+
+    for (size_t lines : sizes)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "%u lines", (unsigned)lines);
+
+        // The read chunks and the results tab text
+        ok &= Bench::RunIsolated(name, [lines] { run(lines); }, lines * cBytesPerLine * 3);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/**
+ *  \file
+ *  \brief  Captures replay test - checked-in global outputs fed through the pipes to the results parsers
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Common.h"
+#include "Cmd.h"
+#include "CmdCapture.h"
+#include "DbManager.h"
+#include "LineParser.h"
+#include "ReadPipe.h"
+#include "ResultWin.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+
+
+using namespace GTags;
+
+
+namespace
+{
+
+// The binaries folder is not part of the captures key
+const TCHAR cGlobal[] = _T("\"C:\\Program Files\\Notepad++\\plugins\\NppGTags\\bin\\global.exe\" ");
+
+int failures = 0;
+
+CPath capturesDir;
+
+
+#define CHECK(cond) \
+    do { if (!(cond)) { printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); ++failures; } } while (0)
+
+
+/**
+ *  \brief  Feeds the capture of the global run with args to the command as CmdEngine does in place of the process.
+ *          Returns false if there is no such capture
+ */
+bool replay(const CmdPtr_t& cmd, const TCHAR* args, std::string& errors)
+{
+    CText cmdLine(cGlobal);
+    cmdLine += args;
+
+    ReadPipe dataPipe;
+    ReadPipe errorPipe;
+
+    HANDLE hDataIn, hErrorIn;
+    const HANDLE hSelf = GetCurrentProcess();
+
+    if (!DuplicateHandle(hSelf, dataPipe.GetInputHandle(), hSelf, &hDataIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+        return false;
+
+    if (!DuplicateHandle(hSelf, errorPipe.GetInputHandle(), hSelf, &hErrorIn, 0, FALSE, DUPLICATE_SAME_ACCESS))
+    {
+        CloseHandle(hDataIn);
+        return false;
+    }
+
+    PROCESS_INFORMATION pi;
+
+    if (!CmdCapture::StartReplay(capturesDir, cmdLine, hDataIn, hErrorIn, pi))
+    {
+        CloseHandle(hErrorIn);
+        CloseHandle(hDataIn);
+        return false;
+    }
+
+    if (!errorPipe.Open() || !dataPipe.Open())
+    {
+        CmdCapture::EndReplay(pi);
+        return false;
+    }
+
+    std::vector<char> errorOutput;
+    errorPipe.MoveOutput(errorOutput);
+    errors = errorOutput.empty() ? "" : errorOutput.data();
+
+    ReadPipe::Output output;
+    dataPipe.MoveOutput(output);
+    cmd->AppendToResult(std::move(output));
+
+    CmdCapture::EndReplay(pi);
+
+    return true;
+}
+
+
+/**
+ *  \brief
+ */
+DbHandle makeDb()
+{
+    DbHandle db = std::make_shared<GTagsDb>(CPath(_T("/home/user/project/")), false);
+    db->SetConfig(DbConfig());
+
+    return db;
+}
+
+
+/**
+ *  \brief  The lines split between the replayed writes are parsed whole
+ */
+void testFindDefinition()
+{
+    std::shared_ptr<ResultWin::TabParser> parser = std::make_shared<ResultWin::TabParser>();
+    CmdPtr_t cmd = std::make_shared<Cmd>(FIND_DEFINITION, makeDb(), parser, _T("compute_value"));
+
+    std::string errors;
+    CHECK(replay(cmd, _T("-dT --result=grep --path-style=abslib \"compute_value\" -M --literal"), errors));
+    CHECK(errors.empty());
+
+    CHECK(parser->Parse(cmd) == 4);
+    CHECK(parser->getFilesCount() == 3);
+
+    const char* const expected =
+        "Find Definition \"compute_value\" in \"/home/user/project/\" (4 hits in 3 files)"
+        "\n\tinclude/engine.h"
+        "\n\t\tline 12:\tint compute_value(int input, int factor);"
+        "\n\tsrc/engine.c"
+        "\n\t\tline 42:\tint compute_value(int input, int factor)"
+        "\n\t\tline 118:\t#define compute_value(x) (x)"
+        "\n\tC:/libs/mathlib/calc.c"
+        "\n\t\tline 7:\tdouble compute_value(double v)";
+
+    CHECK(!strcmp(parser->GetText().C_str(), expected));
+
+    const auto& fileResults = parser->getFileResults();
+    const auto iFile = fileResults.find("src/engine.c");
+
+    CHECK(fileResults.size() == 3);
+    CHECK(iFile != fileResults.end() && iFile->second == 3);
+}
+
+
+/**
+ *  \brief
+ */
+void testAutoComplete()
+{
+    std::shared_ptr<LineParser> parser = std::make_shared<LineParser>();
+    CmdPtr_t cmd = std::make_shared<Cmd>(AUTOCOMPLETE, makeDb(), parser, _T("comp"));
+
+    std::string errors;
+    CHECK(replay(cmd, _T("-cT \"comp\" -M --literal"), errors));
+    CHECK(errors.empty());
+
+    CHECK(parser->Parse(cmd) == 3);
+
+    const std::vector<TCHAR*>& list = parser->GetList();
+
+    CHECK(list.size() == 3);
+    CHECK(list.size() == 3 && !_tcscmp(list[0], _T("compare_items")) && !_tcscmp(list[1], _T("compile")) &&
+            !_tcscmp(list[2], _T("compute_value")));
+}
+
+
+/**
+ *  \brief  Commands without a capture are run normally
+ */
+void testNoCapture()
+{
+    CmdPtr_t cmd = std::make_shared<Cmd>(FIND_REFERENCE, makeDb(), nullptr, _T("compute_value"));
+
+    std::string errors;
+    CHECK(!replay(cmd, _T("-r --result=grep \"compute_value\" -M --literal"), errors));
+    CHECK(!cmd->HasResult());
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief  The captures folder is the only argument - with a trailing '/'
+ */
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        printf("Usage: %s <captures folder>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    capturesDir = CPath(argv[1]);
+    capturesDir.AsFolder();
+
+    testFindDefinition();
+    testAutoComplete();
+    testNoCapture();
+
+    if (failures)
+    {
+        printf("%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("All checks passed\n");
+
+    return EXIT_SUCCESS;
+}
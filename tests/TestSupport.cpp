@@ -0,0 +1,50 @@
+/**
+ *  \file
+ *  \brief  What the tests and benchmarks need from the plugin parts that are not built for them
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "GTags.h"
+#include "Config.h"
+#include "DbManager.h"
+
+
+namespace GTags
+{
+
+// GTags.cpp
+Settings GTagsSettings;
+
+
+// DbManager.cpp - the same without the locks tracing
+/**
+ *  \brief
+ */
+GTagsDb::GTagsDb(const CPath& dbPath, bool writeEn) : _path(dbPath), _writeLock(writeEn)
+{
+    if (!_cfg.LoadFromFolder(dbPath))
+        _cfg = GTagsSettings._genericDbCfg;
+
+    _readLocks = writeEn ? 0 : 1;
+}
+
+} // namespace GTags
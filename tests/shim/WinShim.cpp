@@ -0,0 +1,546 @@
+/**
+ *  \file
+ *  \brief  Minimal Win32 API shim to build the portable plugin parts on Linux for the tests and benchmarks
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <windows.h>
+#include <process.h>
+#include <shlobj.h>
+#include <objbase.h>
+#include <cerrno>
+#include <ctime>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+
+namespace
+{
+
+/**
+ *  \class  ShimHandle
+ *  \brief  What the HANDLE values point to - only events, threads and pipe ends are real
+ */
+class ShimHandle
+{
+public:
+    virtual ~ShimHandle() {}
+
+    virtual DWORD Wait(DWORD) { return WAIT_FAILED; }
+};
+
+
+/**
+ *  \class  Event
+ *  \brief
+ */
+class Event : public ShimHandle
+{
+public:
+    Event(bool manualReset, bool state) : _manualReset(manualReset), _state(state) {}
+
+    void Set(bool state)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        _state = state;
+        if (_state)
+            _cond.notify_all();
+    }
+
+    virtual DWORD Wait(DWORD time_ms)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+
+        if (time_ms == INFINITE)
+            _cond.wait(lock, [this] { return _state; });
+        else if (!_cond.wait_for(lock, std::chrono::milliseconds(time_ms), [this] { return _state; }))
+            return WAIT_TIMEOUT;
+
+        if (!_manualReset)
+            _state = false;
+
+        return WAIT_OBJECT_0;
+    }
+
+private:
+    std::mutex              _lock;
+    std::condition_variable _cond;
+    const bool              _manualReset;
+    bool                    _state;
+};
+
+
+/**
+ *  \class  Thread
+ *  \brief  Signaled when the thread function returns - the same way a Win32 thread handle is
+ */
+class Thread : public ShimHandle
+{
+public:
+    Thread(_beginthreadex_proc_type proc, void* arg) : _done(true, false)
+    {
+        _thread = std::thread([this, proc, arg] { proc(arg); _done.Set(true); });
+    }
+
+    virtual ~Thread()
+    {
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    virtual DWORD Wait(DWORD time_ms) { return _done.Wait(time_ms); }
+
+private:
+    Event       _done;
+    std::thread _thread;
+};
+
+
+/**
+ *  \class  PipeEnd
+ *  \brief
+ */
+class PipeEnd : public ShimHandle
+{
+public:
+    PipeEnd(int fd) : _fd(fd) {}
+    virtual ~PipeEnd() { close(_fd); }
+
+    inline int Fd() const { return _fd; }
+
+private:
+    const int _fd;
+};
+
+
+/**
+ *  \brief
+ */
+inline ShimHandle* shimHandle(HANDLE handle)
+{
+    return (handle == NULL || handle == INVALID_HANDLE_VALUE) ? NULL : static_cast<ShimHandle*>(handle);
+}
+
+} // anonymous namespace
+
+
+/**
+ *  \brief
+ */
+BOOL InitializeCriticalSectionAndSpinCount(CRITICAL_SECTION* cs, DWORD)
+{
+    // Critical sections are recursive
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cs->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+void DeleteCriticalSection(CRITICAL_SECTION* cs)
+{
+    pthread_mutex_destroy(&cs->mutex);
+}
+
+
+/**
+ *  \brief
+ */
+void EnterCriticalSection(CRITICAL_SECTION* cs)
+{
+    pthread_mutex_lock(&cs->mutex);
+}
+
+
+/**
+ *  \brief
+ */
+BOOL TryEnterCriticalSection(CRITICAL_SECTION* cs)
+{
+    return (pthread_mutex_trylock(&cs->mutex) == 0);
+}
+
+
+/**
+ *  \brief
+ */
+void LeaveCriticalSection(CRITICAL_SECTION* cs)
+{
+    pthread_mutex_unlock(&cs->mutex);
+}
+
+
+/**
+ *  \brief  Nanoseconds
+ */
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    count->QuadPart = (LONGLONG)now.tv_sec * 1000000000LL + now.tv_nsec;
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* freq)
+{
+    freq->QuadPart = 1000000000LL;
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+DWORD GetTickCount()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    return (DWORD)(now.QuadPart / 1000000);
+}
+
+
+/**
+ *  \brief  100 ns intervals since 1601
+ */
+void GetSystemTimeAsFileTime(FILETIME* time)
+{
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    const uint64_t t = ((uint64_t)now.tv_sec + 11644473600ULL) * 10000000ULL + now.tv_nsec / 100;
+
+    time->dwLowDateTime     = (DWORD)t;
+    time->dwHighDateTime    = (DWORD)(t >> 32);
+}
+
+
+/**
+ *  \brief
+ */
+void GetLocalTime(SYSTEMTIME* time)
+{
+    ZeroMemory(time, sizeof(*time));
+}
+
+
+/**
+ *  \brief
+ */
+DWORD GetLastError()
+{
+    return (DWORD)errno;
+}
+
+
+/**
+ *  \brief
+ */
+DWORD GetCurrentThreadId()
+{
+    return (DWORD)std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+
+/**
+ *  \brief
+ */
+DWORD GetEnvironmentVariableW(LPCWSTR name, LPWSTR buf, DWORD size)
+{
+    char nameA[256];
+
+    size_t cnt;
+    wcstombs_s(&cnt, nameA, sizeof(nameA), name, _TRUNCATE);
+
+    const char* value = getenv(nameA);
+    if (value == NULL)
+        return 0;
+
+    // Too small a buffer gets the needed size including the terminating zero
+    const size_t len = mbstowcs(NULL, value, 0);
+    if (len == (size_t)-1)
+        return 0;
+    if (len >= size)
+        return (DWORD)len + 1;
+
+    mbstowcs(buf, value, size);
+
+    return (DWORD)len;
+}
+
+
+/**
+ *  \brief
+ */
+HANDLE CreateEventW(SECURITY_ATTRIBUTES*, BOOL manualReset, BOOL initialState, LPCWSTR)
+{
+    return new Event(manualReset != FALSE, initialState != FALSE);
+}
+
+
+/**
+ *  \brief
+ */
+BOOL SetEvent(HANDLE hEvent)
+{
+    Event* event = dynamic_cast<Event*>(shimHandle(hEvent));
+    if (!event)
+        return FALSE;
+
+    event->Set(true);
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+BOOL ResetEvent(HANDLE hEvent)
+{
+    Event* event = dynamic_cast<Event*>(shimHandle(hEvent));
+    if (!event)
+        return FALSE;
+
+    event->Set(false);
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+DWORD WaitForSingleObject(HANDLE handle, DWORD time_ms)
+{
+    ShimHandle* h = shimHandle(handle);
+
+    return h ? h->Wait(time_ms) : WAIT_FAILED;
+}
+
+
+/**
+ *  \brief
+ */
+BOOL CloseHandle(HANDLE handle)
+{
+    ShimHandle* h = shimHandle(handle);
+    if (!h)
+        return FALSE;
+
+    delete h;
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+uintptr_t _beginthreadex(void*, unsigned, _beginthreadex_proc_type proc, void* arg, unsigned, unsigned*)
+{
+    return (uintptr_t)static_cast<ShimHandle*>(new Thread(proc, arg));
+}
+
+
+/**
+ *  \brief
+ */
+BOOL CreatePipe(HANDLE* hRead, HANDLE* hWrite, SECURITY_ATTRIBUTES*, DWORD)
+{
+    int fds[2];
+
+    if (pipe(fds))
+        return FALSE;
+
+    *hRead  = static_cast<ShimHandle*>(new PipeEnd(fds[0]));
+    *hWrite = static_cast<ShimHandle*>(new PipeEnd(fds[1]));
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+BOOL SetHandleInformation(HANDLE handle, DWORD, DWORD)
+{
+    return (shimHandle(handle) != NULL);
+}
+
+
+/**
+ *  \brief  The pseudo handle of the own process - the only one there is
+ */
+HANDLE GetCurrentProcess()
+{
+    return NULL;
+}
+
+
+/**
+ *  \brief  Pipe ends only - the data pipe writer side is kept open this way after ReadPipe::Open()
+ */
+BOOL DuplicateHandle(HANDLE, HANDLE hSrc, HANDLE, HANDLE* hDst, DWORD, BOOL, DWORD)
+{
+    PipeEnd* pipeEnd = dynamic_cast<PipeEnd*>(shimHandle(hSrc));
+    if (!pipeEnd)
+        return FALSE;
+
+    const int fd = dup(pipeEnd->Fd());
+    if (fd < 0)
+        return FALSE;
+
+    *hDst = static_cast<ShimHandle*>(new PipeEnd(fd));
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief  Fails at the end of the data as reading a closed pipe does
+ */
+BOOL ReadFile(HANDLE hFile, LPVOID buf, DWORD len, LPDWORD read, void*)
+{
+    *read = 0;
+
+    PipeEnd* pipeEnd = dynamic_cast<PipeEnd*>(shimHandle(hFile));
+    if (!pipeEnd)
+        return FALSE;
+
+    ssize_t res;
+    do
+    {
+        res = ::read(pipeEnd->Fd(), buf, len);
+    } while (res < 0 && errno == EINTR);
+
+    if (res <= 0)
+        return FALSE;
+
+    *read = (DWORD)res;
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief
+ */
+BOOL WriteFile(HANDLE hFile, LPCVOID buf, DWORD len, LPDWORD written, void*)
+{
+    if (written)
+        *written = 0;
+
+    PipeEnd* pipeEnd = dynamic_cast<PipeEnd*>(shimHandle(hFile));
+    if (!pipeEnd)
+        return FALSE;
+
+    const char* pData = static_cast<const char*>(buf);
+
+    while (len)
+    {
+        const ssize_t res = ::write(pipeEnd->Fd(), pData, len);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return FALSE;
+        }
+
+        pData += res;
+        len -= (DWORD)res;
+
+        if (written)
+            *written += (DWORD)res;
+    }
+
+    return TRUE;
+}
+
+
+/**
+ *  \brief  There is no blocking I/O in another thread that could be cancelled - the pipes readers never stop
+ */
+BOOL CancelSynchronousIo(HANDLE)
+{
+    return FALSE;
+}
+
+
+// Files, the UI and the shell are not there - all fail
+
+HANDLE CreateFileW(LPCWSTR, DWORD, DWORD, SECURITY_ATTRIBUTES*, DWORD, DWORD, HANDLE) { return INVALID_HANDLE_VALUE; }
+DWORD GetFileSize(HANDLE, LPDWORD) { return INVALID_FILE_SIZE; }
+BOOL GetFileSizeEx(HANDLE, LARGE_INTEGER*) { return FALSE; }
+BOOL GetFileTime(HANDLE, FILETIME*, FILETIME*, FILETIME*) { return FALSE; }
+DWORD SetFilePointer(HANDLE, LONG, LONG*, DWORD) { return INVALID_FILE_SIZE; }
+BOOL SetFilePointerEx(HANDLE, LARGE_INTEGER, LARGE_INTEGER*, DWORD) { return FALSE; }
+BOOL SetEndOfFile(HANDLE) { return FALSE; }
+BOOL FlushFileBuffers(HANDLE) { return FALSE; }
+HANDLE CreateFileMappingW(HANDLE, SECURITY_ATTRIBUTES*, DWORD, DWORD, DWORD, LPCWSTR) { return NULL; }
+LPVOID MapViewOfFile(HANDLE, DWORD, DWORD, DWORD, size_t) { return NULL; }
+BOOL UnmapViewOfFile(LPCVOID) { return FALSE; }
+DWORD GetFileAttributesW(LPCWSTR) { return INVALID_FILE_ATTRIBUTES; }
+BOOL DeleteFileW(LPCWSTR) { return FALSE; }
+BOOL CreateDirectoryW(LPCWSTR, SECURITY_ATTRIBUTES*) { return FALSE; }
+DWORD GetTempPathW(DWORD, LPWSTR) { return 0; }
+
+LRESULT SendMessageW(HWND, UINT, WPARAM, LPARAM) { return 0; }
+BOOL PostMessageW(HWND, UINT, WPARAM, LPARAM) { return FALSE; }
+int MessageBoxW(HWND, LPCWSTR, LPCWSTR, UINT) { return 0; }
+int MessageBoxA(HWND, LPCSTR, LPCSTR, UINT) { return 0; }
+HWND GetFocus() { return NULL; }
+HWND SetFocus(HWND) { return NULL; }
+BOOL IsChild(HWND, HWND) { return FALSE; }
+BOOL IsWindowVisible(HWND) { return FALSE; }
+BOOL GetWindowRect(HWND, RECT*) { return FALSE; }
+BOOL AdjustWindowRectEx(RECT*, DWORD, BOOL, DWORD) { return FALSE; }
+int GetSystemMetrics(int) { return 0; }
+HHOOK SetWindowsHookExW(int, HOOKPROC, HINSTANCE, DWORD) { return NULL; }
+BOOL UpdateWindow(HWND) { return FALSE; }
+UINT SendInput(UINT, INPUT*, int) { return 0; }
+BOOL SystemParametersInfoW(UINT, UINT, LPVOID, UINT) { return FALSE; }
+int GetDeviceCaps(HDC, int) { return 0; }
+HFONT CreateFontIndirectW(const LOGFONTW*) { return NULL; }
+HGDIOBJ SelectObject(HDC, HGDIOBJ) { return NULL; }
+BOOL GetTextExtentPoint32W(HDC, LPCWSTR, int, SIZE*) { return FALSE; }
+
+HRESULT SHParseDisplayName(LPCWSTR, void*, LPITEMIDLIST*, ULONG, ULONG*) { return -1; }
+LPITEMIDLIST SHBrowseForFolderW(BROWSEINFOW*) { return NULL; }
+BOOL SHGetPathFromIDListW(LPCITEMIDLIST, LPWSTR) { return FALSE; }
+void CoTaskMemFree(LPVOID) {}
@@ -0,0 +1,35 @@
+/**
+ *  \file
+ *  \brief  Thread creation of the Win32 API shim
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+
+#include <windows.h>
+
+
+typedef unsigned (__stdcall *_beginthreadex_proc_type)(void*);
+
+uintptr_t _beginthreadex(void* security, unsigned stackSize, _beginthreadex_proc_type proc, void* arg,
+        unsigned initFlag, unsigned* threadId);
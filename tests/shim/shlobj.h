@@ -0,0 +1,64 @@
+/**
+ *  \file
+ *  \brief  Shell API declarations of the Win32 API shim
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+
+#include <windows.h>
+
+
+typedef struct _ITEMIDLIST* LPITEMIDLIST;
+typedef const struct _ITEMIDLIST* LPCITEMIDLIST;
+typedef int (CALLBACK *BFFCALLBACK)(HWND, UINT, LPARAM, LPARAM);
+
+struct BROWSEINFOW
+{
+    HWND            hwndOwner;
+    LPCITEMIDLIST   pidlRoot;
+    LPWSTR          pszDisplayName;
+    LPCWSTR         lpszTitle;
+    UINT            ulFlags;
+    BFFCALLBACK     lpfn;
+    LPARAM          lParam;
+    int             iImage;
+};
+
+#define BFFM_INITIALIZED        1
+#define BFFM_SETSELECTION       (WM_USER + 103)
+
+#define BIF_RETURNONLYFSDIRS    0x00000001
+#define BIF_NEWDIALOGSTYLE      0x00000040
+#define BIF_USENEWUI            (BIF_NEWDIALOGSTYLE | 0x00000010)
+#define BIF_NONEWFOLDERBUTTON   0x00000200
+
+HRESULT SHParseDisplayName(LPCWSTR name, void* bindCtx, LPITEMIDLIST* pidl, ULONG sfgaoIn, ULONG* sfgaoOut);
+LPITEMIDLIST SHBrowseForFolderW(BROWSEINFOW* bi);
+BOOL SHGetPathFromIDListW(LPCITEMIDLIST pidl, LPWSTR path);
+
+#ifdef UNICODE
+typedef BROWSEINFOW BROWSEINFO;
+#define SHBrowseForFolder       SHBrowseForFolderW
+#define SHGetPathFromIDList     SHGetPathFromIDListW
+#endif
@@ -0,0 +1,164 @@
+/**
+ *  \file
+ *  \brief  TCHAR mappings of the Win32 API shim
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#pragma once
+
+
+#include <windows.h>
+#include <cstdio>
+#include <cstdarg>
+#include <cwchar>
+#include <cwctype>
+#include <string>
+
+
+#ifdef UNICODE
+
+#define _T(x)       L##x
+#define TEXT(x)     L##x
+
+#define _tcslen     wcslen
+#define _tcscmp     wcscmp
+#define _tcsncmp    wcsncmp
+#define _tcsicmp    _wcsicmp
+#define _tcsnicmp   _wcsnicmp
+#define _tcschr     wcschr
+#define _tcsrchr    wcsrchr
+#define _tcsstr     wcsstr
+#define _tcstol     wcstol
+#define _tcstoul    wcstoul
+#define _tcstok_s   wcstok
+#define _tcscpy_s   wcscpy_s
+#define _fgetts     fgetws
+
+#define _istdigit   iswdigit
+#define _istalnum   iswalnum
+#define _istalpha   iswalpha
+#define _istupper   iswupper
+#define _istlower   iswlower
+#define _istspace   iswspace
+#define _totlower   towlower
+#define _totupper   towupper
+
+#define _tfopen_s   _wfopen_s
+#define _ftprintf_s _fwprintf_s
+#define _sntprintf_s _snwprintf_s
+
+
+inline int _wfopen_s(FILE** fp, const wchar_t* name, const wchar_t* mode)
+{
+    char nameA[4 * MAX_PATH];
+    char modeA[16];
+
+    size_t cnt;
+    wcstombs_s(&cnt, nameA, sizeof(nameA), name, _TRUNCATE);
+    wcstombs_s(&cnt, modeA, sizeof(modeA), mode, _TRUNCATE);
+
+    // No text mode translation and no encoding flags here
+    std::string m;
+    for (const char* pMode = modeA; *pMode && *pMode != ','; ++pMode)
+        if (*pMode != 't')
+            m += *pMode;
+
+    *fp = fopen(nameA, m.c_str());
+
+    return *fp ? 0 : -1;
+}
+
+
+// The Windows wide printf takes %s as a wide string
+inline std::wstring _wprintfFormat(const wchar_t* format)
+{
+    std::wstring fmt;
+
+    for (const wchar_t* pFmt = format; *pFmt; ++pFmt)
+    {
+        fmt += *pFmt;
+
+        if (*pFmt == L'%' && pFmt[1] == L's')
+            fmt += L'l';
+        else if (*pFmt == L'%' && pFmt[1] == L'%')
+            fmt += *(++pFmt);
+    }
+
+    return fmt;
+}
+
+
+inline int _fwprintf_s(FILE* fp, const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int res = vfwprintf(fp, _wprintfFormat(format).c_str(), args);
+    va_end(args);
+
+    return res;
+}
+
+
+inline int _snwprintf_s(wchar_t* dst, size_t dstSize, size_t, const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int res = vswprintf(dst, dstSize, _wprintfFormat(format).c_str(), args);
+    va_end(args);
+
+    if (res < 0)
+        dst[dstSize - 1] = 0;
+
+    return res;
+}
+
+#else
+
+#define _T(x)       x
+#define TEXT(x)     x
+
+#define _tcslen     strlen
+#define _tcscmp     strcmp
+#define _tcsncmp    strncmp
+#define _tcsicmp    _stricmp
+#define _tcsnicmp   _strnicmp
+#define _tcschr     strchr
+#define _tcsrchr    strrchr
+#define _tcsstr     strstr
+#define _tcstol     strtol
+#define _tcstoul    strtoul
+#define _tcstok_s   strtok_r
+#define _tcscpy_s   strcpy_s
+#define _fgetts     fgets
+
+#define _istdigit   isdigit
+#define _istalnum   isalnum
+#define _istalpha   isalpha
+#define _istupper   isupper
+#define _istlower   islower
+#define _istspace   isspace
+#define _totlower   tolower
+#define _totupper   toupper
+
+#define _sntprintf_s _snprintf_s
+
+#endif
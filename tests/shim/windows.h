@@ -0,0 +1,525 @@
+/**
+ *  \file
+ *  \brief  Minimal Win32 API shim to build the portable plugin parts on Linux for the tests and benchmarks
+ *
+ *  \author  Pavel Nedev <pg.nedev@gmail.com>
+ *
+ *  \section COPYRIGHT
+ *  Copyright(C) 2014-2024 Pavel Nedev
+ *
+ *  \section LICENSE
+ *  This program is free software; you can redistribute it and/or modify it
+ *  under the terms of the GNU General Public License version 2 as published
+ *  by the Free Software Foundation.
+ *
+ *  This program is distributed in the hope that it will be useful, but
+ *  WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ *  or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ *  for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cwchar>
+#include <strings.h>
+#include <pthread.h>
+
+
+// Only what the portable sources use - the threads, events, pipes, the performance counter and the critical
+// sections work, everything else is declared so the headers compile and fails if called (see WinShim.cpp)
+
+#define WINAPI
+#define CALLBACK
+#define APIENTRY
+#define __stdcall
+#define __cdecl
+#define __declspec(x)
+
+#define TRUE    1
+#define FALSE   0
+
+#define MAX_PATH    260
+
+#define _TRUNCATE   ((size_t)-1)
+
+#define _countof(arr)   (sizeof(arr) / sizeof((arr)[0]))
+
+typedef int                 BOOL;
+typedef unsigned char       BYTE;
+typedef unsigned char       UCHAR;
+typedef unsigned short      WORD;
+typedef uint32_t            DWORD;
+typedef int32_t             LONG;
+typedef uint32_t            ULONG;
+typedef int64_t             LONGLONG;
+typedef uint64_t            ULONGLONG;
+typedef unsigned int        UINT;
+typedef int                 INT;
+typedef char                CHAR;
+typedef wchar_t             WCHAR;
+typedef DWORD               COLORREF;
+typedef long                HRESULT;
+typedef intptr_t            INT_PTR;
+typedef uintptr_t           UINT_PTR;
+typedef intptr_t            LONG_PTR;
+typedef uintptr_t           ULONG_PTR;
+typedef uintptr_t           DWORD_PTR;
+typedef intptr_t            LRESULT;
+typedef uintptr_t           WPARAM;
+typedef intptr_t            LPARAM;
+typedef void*               LPVOID;
+typedef const void*         LPCVOID;
+typedef DWORD*              LPDWORD;
+typedef char*               LPSTR;
+typedef const char*         LPCSTR;
+typedef wchar_t*            LPWSTR;
+typedef const wchar_t*      LPCWSTR;
+typedef unsigned short      ATOM;
+
+typedef void*               HANDLE;
+typedef struct HWND__*      HWND;
+typedef void*               HINSTANCE;
+typedef void*               HMODULE;
+typedef void*               HFONT;
+typedef void*               HDC;
+typedef void*               HMENU;
+typedef void*               HHOOK;
+typedef void*               HICON;
+typedef void*               HBRUSH;
+typedef void*               HGDIOBJ;
+typedef void*               HBITMAP;
+
+#ifdef UNICODE
+typedef wchar_t             TCHAR;
+typedef LPWSTR              LPTSTR;
+typedef LPCWSTR             LPCTSTR;
+#else
+typedef char                TCHAR;
+typedef LPSTR               LPTSTR;
+typedef LPCSTR              LPCTSTR;
+#endif
+
+typedef LRESULT (CALLBACK *WNDPROC)(HWND, UINT, WPARAM, LPARAM);
+typedef LRESULT (CALLBACK *HOOKPROC)(int, WPARAM, LPARAM);
+
+#define INVALID_HANDLE_VALUE        ((HANDLE)(intptr_t)-1)
+#define INVALID_FILE_ATTRIBUTES     ((DWORD)-1)
+#define INVALID_FILE_SIZE           ((DWORD)0xFFFFFFFF)
+#define FILE_ATTRIBUTE_DIRECTORY    0x00000010
+#define FILE_ATTRIBUTE_NORMAL       0x00000080
+
+#define INFINITE            0xFFFFFFFF
+#define WAIT_OBJECT_0       0x00000000
+#define WAIT_TIMEOUT        0x00000102
+#define WAIT_FAILED         0xFFFFFFFF
+
+#define HANDLE_FLAG_INHERIT     0x00000001
+#define DUPLICATE_SAME_ACCESS   0x00000002
+
+#define GENERIC_READ        0x80000000
+#define GENERIC_WRITE       0x40000000
+#define FILE_SHARE_READ     0x00000001
+#define FILE_SHARE_WRITE    0x00000002
+#define FILE_SHARE_DELETE   0x00000004
+#define CREATE_NEW          1
+#define CREATE_ALWAYS       2
+#define OPEN_EXISTING       3
+#define OPEN_ALWAYS         4
+#define FILE_BEGIN          0
+#define FILE_CURRENT        1
+#define FILE_END            2
+#define FILE_FLAG_DELETE_ON_CLOSE   0x04000000
+#define FILE_ATTRIBUTE_TEMPORARY    0x00000100
+#define PAGE_READONLY       0x02
+#define PAGE_READWRITE      0x04
+#define FILE_MAP_READ       0x0004
+#define FILE_MAP_WRITE      0x0002
+#define FILE_MAP_ALL_ACCESS 0x000F001F
+
+#define S_OK                ((HRESULT)0)
+
+#define WM_USER             0x0400
+#define MB_OK               0x00000000
+
+#define SM_SWAPBUTTON       23
+#define SM_XVIRTUALSCREEN   76
+#define SM_YVIRTUALSCREEN   77
+#define SM_CXVIRTUALSCREEN  78
+#define SM_CYVIRTUALSCREEN  79
+
+#define SPI_GETNONCLIENTMETRICS 0x0029
+#define LOGPIXELSY          90
+
+#define INPUT_MOUSE         0
+#define INPUT_KEYBOARD      1
+#define KEYEVENTF_KEYUP     0x0002
+#define MOUSEEVENTF_LEFTUP  0x0004
+#define MOUSEEVENTF_RIGHTUP 0x0010
+#define VK_SHIFT            0x10
+#define VK_CONTROL          0x11
+#define VK_MENU             0x12
+
+#define ARRAYSIZE(arr)      (sizeof(arr) / sizeof((arr)[0]))
+
+#define RGB(r, g, b)    ((COLORREF)(((BYTE)(r) | ((WORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+
+#define ZeroMemory(dst, len)    memset((dst), 0, (len))
+
+#define WH_KEYBOARD         2
+
+
+struct RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+struct POINT
+{
+    LONG x;
+    LONG y;
+};
+
+struct SIZE
+{
+    LONG cx;
+    LONG cy;
+};
+
+struct FILETIME
+{
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+struct SYSTEMTIME
+{
+    WORD wYear;
+    WORD wMonth;
+    WORD wDayOfWeek;
+    WORD wDay;
+    WORD wHour;
+    WORD wMinute;
+    WORD wSecond;
+    WORD wMilliseconds;
+};
+
+union ULARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        DWORD HighPart;
+    };
+    ULONGLONG QuadPart;
+};
+
+union LARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        LONG HighPart;
+    };
+    LONGLONG QuadPart;
+};
+
+struct SECURITY_ATTRIBUTES
+{
+    DWORD   nLength;
+    LPVOID  lpSecurityDescriptor;
+    BOOL    bInheritHandle;
+};
+
+struct PROCESS_INFORMATION
+{
+    HANDLE  hProcess;
+    HANDLE  hThread;
+    DWORD   dwProcessId;
+    DWORD   dwThreadId;
+};
+
+struct NMHDR
+{
+    HWND        hwndFrom;
+    UINT_PTR    idFrom;
+    UINT        code;
+};
+
+struct KEYBDINPUT
+{
+    WORD        wVk;
+    WORD        wScan;
+    DWORD       dwFlags;
+    DWORD       time;
+    ULONG_PTR   dwExtraInfo;
+};
+
+struct MOUSEINPUT
+{
+    LONG        dx;
+    LONG        dy;
+    DWORD       mouseData;
+    DWORD       dwFlags;
+    DWORD       time;
+    ULONG_PTR   dwExtraInfo;
+};
+
+struct INPUT
+{
+    DWORD type;
+    union
+    {
+        MOUSEINPUT  mi;
+        KEYBDINPUT  ki;
+    };
+};
+
+struct LOGFONTW
+{
+    LONG    lfHeight;
+    LONG    lfWidth;
+    LONG    lfEscapement;
+    LONG    lfOrientation;
+    LONG    lfWeight;
+    BYTE    lfItalic;
+    BYTE    lfUnderline;
+    BYTE    lfStrikeOut;
+    BYTE    lfCharSet;
+    BYTE    lfOutPrecision;
+    BYTE    lfClipPrecision;
+    BYTE    lfQuality;
+    BYTE    lfPitchAndFamily;
+    WCHAR   lfFaceName[32];
+};
+
+struct NONCLIENTMETRICSW
+{
+    UINT        cbSize;
+    int         iBorderWidth;
+    int         iScrollWidth;
+    int         iScrollHeight;
+    int         iCaptionWidth;
+    int         iCaptionHeight;
+    LOGFONTW    lfCaptionFont;
+    int         iSmCaptionWidth;
+    int         iSmCaptionHeight;
+    LOGFONTW    lfSmCaptionFont;
+    int         iMenuWidth;
+    int         iMenuHeight;
+    LOGFONTW    lfMenuFont;
+    LOGFONTW    lfStatusFont;
+    LOGFONTW    lfMessageFont;
+    int         iPaddedBorderWidth;
+};
+
+struct CRITICAL_SECTION
+{
+    pthread_mutex_t mutex;
+};
+
+
+BOOL InitializeCriticalSectionAndSpinCount(CRITICAL_SECTION* cs, DWORD spinCount);
+void DeleteCriticalSection(CRITICAL_SECTION* cs);
+void EnterCriticalSection(CRITICAL_SECTION* cs);
+BOOL TryEnterCriticalSection(CRITICAL_SECTION* cs);
+void LeaveCriticalSection(CRITICAL_SECTION* cs);
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* freq);
+DWORD GetTickCount();
+void GetSystemTimeAsFileTime(FILETIME* time);
+void GetLocalTime(SYSTEMTIME* time);
+DWORD GetLastError();
+DWORD GetCurrentThreadId();
+DWORD GetEnvironmentVariableW(LPCWSTR name, LPWSTR buf, DWORD size);
+
+HANDLE CreateEventW(SECURITY_ATTRIBUTES* attr, BOOL manualReset, BOOL initialState, LPCWSTR name);
+BOOL SetEvent(HANDLE hEvent);
+BOOL ResetEvent(HANDLE hEvent);
+DWORD WaitForSingleObject(HANDLE handle, DWORD time_ms);
+BOOL CloseHandle(HANDLE handle);
+
+BOOL CreatePipe(HANDLE* hRead, HANDLE* hWrite, SECURITY_ATTRIBUTES* attr, DWORD size);
+BOOL SetHandleInformation(HANDLE handle, DWORD mask, DWORD flags);
+HANDLE GetCurrentProcess();
+BOOL DuplicateHandle(HANDLE hSrcProcess, HANDLE hSrc, HANDLE hDstProcess, HANDLE* hDst, DWORD access,
+        BOOL inherit, DWORD options);
+BOOL ReadFile(HANDLE hFile, LPVOID buf, DWORD len, LPDWORD read, void* overlapped);
+BOOL WriteFile(HANDLE hFile, LPCVOID buf, DWORD len, LPDWORD written, void* overlapped);
+BOOL CancelSynchronousIo(HANDLE hThread);
+
+HANDLE CreateFileW(LPCWSTR name, DWORD access, DWORD share, SECURITY_ATTRIBUTES* attr, DWORD creation,
+        DWORD flags, HANDLE hTemplate);
+DWORD GetFileSize(HANDLE hFile, LPDWORD sizeHigh);
+BOOL GetFileSizeEx(HANDLE hFile, LARGE_INTEGER* size);
+BOOL GetFileTime(HANDLE hFile, FILETIME* creation, FILETIME* access, FILETIME* write);
+DWORD SetFilePointer(HANDLE hFile, LONG dist, LONG* distHigh, DWORD method);
+BOOL SetFilePointerEx(HANDLE hFile, LARGE_INTEGER dist, LARGE_INTEGER* newPos, DWORD method);
+BOOL SetEndOfFile(HANDLE hFile);
+BOOL FlushFileBuffers(HANDLE hFile);
+HANDLE CreateFileMappingW(HANDLE hFile, SECURITY_ATTRIBUTES* attr, DWORD protect, DWORD sizeHigh, DWORD sizeLow,
+        LPCWSTR name);
+LPVOID MapViewOfFile(HANDLE hMap, DWORD access, DWORD offsetHigh, DWORD offsetLow, size_t len);
+BOOL UnmapViewOfFile(LPCVOID view);
+DWORD GetFileAttributesW(LPCWSTR name);
+BOOL DeleteFileW(LPCWSTR name);
+BOOL CreateDirectoryW(LPCWSTR name, SECURITY_ATTRIBUTES* attr);
+DWORD GetTempPathW(DWORD len, LPWSTR buf);
+
+LRESULT SendMessageW(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+BOOL PostMessageW(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+int MessageBoxW(HWND hWnd, LPCWSTR text, LPCWSTR caption, UINT type);
+int MessageBoxA(HWND hWnd, LPCSTR text, LPCSTR caption, UINT type);
+HWND GetFocus();
+HWND SetFocus(HWND hWnd);
+BOOL IsChild(HWND hParent, HWND hWnd);
+BOOL IsWindowVisible(HWND hWnd);
+BOOL GetWindowRect(HWND hWnd, RECT* rect);
+BOOL AdjustWindowRectEx(RECT* rect, DWORD style, BOOL menu, DWORD styleEx);
+int GetSystemMetrics(int index);
+HHOOK SetWindowsHookExW(int id, HOOKPROC proc, HINSTANCE hMod, DWORD threadId);
+BOOL UpdateWindow(HWND hWnd);
+UINT SendInput(UINT count, INPUT* inputs, int size);
+BOOL SystemParametersInfoW(UINT action, UINT param, LPVOID data, UINT winIni);
+int GetDeviceCaps(HDC hdc, int index);
+HFONT CreateFontIndirectW(const LOGFONTW* font);
+HGDIOBJ SelectObject(HDC hdc, HGDIOBJ obj);
+BOOL GetTextExtentPoint32W(HDC hdc, LPCWSTR str, int len, SIZE* size);
+
+#ifdef UNICODE
+#define CreateEvent             CreateEventW
+#define GetEnvironmentVariable  GetEnvironmentVariableW
+#define CreateFile              CreateFileW
+#define CreateFileMapping       CreateFileMappingW
+#define GetFileAttributes       GetFileAttributesW
+#define DeleteFile              DeleteFileW
+#define CreateDirectory         CreateDirectoryW
+#define GetTempPath             GetTempPathW
+#define SendMessage             SendMessageW
+#define PostMessage             PostMessageW
+#define MessageBox              MessageBoxW
+#define SetWindowsHookEx        SetWindowsHookExW
+#define SystemParametersInfo    SystemParametersInfoW
+#define CreateFontIndirect      CreateFontIndirectW
+#define GetTextExtentPoint32    GetTextExtentPoint32W
+
+typedef LOGFONTW            LOGFONT;
+typedef NONCLIENTMETRICSW   NONCLIENTMETRICS;
+#endif
+
+
+inline int MulDiv(int number, int numerator, int denominator)
+{
+    return denominator ? (int)(((int64_t)number * numerator) / denominator) : -1;
+}
+
+
+// CRT extensions
+
+inline int _stricmp(const char* str1, const char* str2)
+{
+    return strcasecmp(str1, str2);
+}
+
+
+inline int _strnicmp(const char* str1, const char* str2, size_t len)
+{
+    return strncasecmp(str1, str2, len);
+}
+
+
+inline int _wcsicmp(const wchar_t* str1, const wchar_t* str2)
+{
+    return wcscasecmp(str1, str2);
+}
+
+
+inline int _wcsnicmp(const wchar_t* str1, const wchar_t* str2, size_t len)
+{
+    return wcsncasecmp(str1, str2, len);
+}
+
+
+inline int mbstowcs_s(size_t* cnt, wchar_t* dst, size_t dstSize, const char* src, size_t count)
+{
+    size_t max = (count == _TRUNCATE || count >= dstSize) ? dstSize - 1 : count;
+    size_t len = mbstowcs(dst, src, max);
+
+    if (len == (size_t)-1)
+        len = 0;
+
+    dst[len] = 0;
+
+    if (cnt)
+        *cnt = len + 1;
+
+    return 0;
+}
+
+
+inline int wcstombs_s(size_t* cnt, char* dst, size_t dstSize, const wchar_t* src, size_t count)
+{
+    size_t max = (count == _TRUNCATE || count >= dstSize) ? dstSize - 1 : count;
+    size_t len = wcstombs(dst, src, max);
+
+    if (len == (size_t)-1)
+        len = 0;
+
+    dst[len] = 0;
+
+    if (cnt)
+        *cnt = len + 1;
+
+    return 0;
+}
+
+
+inline int wcscpy_s(wchar_t* dst, size_t dstSize, const wchar_t* src)
+{
+    wcsncpy(dst, src, dstSize - 1);
+    dst[dstSize - 1] = 0;
+
+    return 0;
+}
+
+
+inline int strcpy_s(char* dst, size_t dstSize, const char* src)
+{
+    strncpy(dst, src, dstSize - 1);
+    dst[dstSize - 1] = 0;
+
+    return 0;
+}
+
+
+inline int _snprintf_s(char* dst, size_t dstSize, size_t, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int res = vsnprintf(dst, dstSize, format, args);
+    va_end(args);
+
+    return (res < 0 || (size_t)res >= dstSize) ? -1 : res;
+}
+
+
+inline int _i64toa_s(int64_t num, char* dst, size_t dstSize, int)
+{
+    snprintf(dst, dstSize, "%lld", (long long)num);
+
+    return 0;
+}